@@ -1,88 +1,214 @@
 #include "clock.hpp"
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <ctime>
 
 #include <qdatetime.h>
+#include <qlist.h>
+#include <qlogging.h>
+#include <qloggingcategory.h>
 #include <qobject.h>
-#include <qtimer.h>
+#include <qsocketnotifier.h>
+#include <qtclasshelpermacros.h>
 #include <qtmetamacros.h>
 #include <qtypes.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
 
-SystemClock::SystemClock(QObject* parent): QObject(parent) {
-	QObject::connect(&this->timer, &QTimer::timeout, this, &SystemClock::onTimeout);
-	this->update();
+namespace {
+Q_LOGGING_CATEGORY(logClock, "quickshell.clock", QtWarningMsg);
 }
 
-bool SystemClock::enabled() const { return this->mEnabled; }
+// Process wide clock source for a given precision. Each scheduler arms a single absolute
+// CLOCK_REALTIME timerfd for the next hour, minute or second boundary, computes the
+// time once when it fires and hands it to every SystemClock using that precision.
+//
+// TFD_TIMER_CANCEL_ON_SET wakes the scheduler when the system clock is changed, and absolute
+// timers fire immediately after resuming from suspend if their deadline passed.
+class SystemClockScheduler {
+public:
+	explicit SystemClockScheduler(SystemClock::Enum precision);
+	~SystemClockScheduler();
+	Q_DISABLE_COPY_MOVE(SystemClockScheduler);
+
+	static SystemClockScheduler* forPrecision(SystemClock::Enum precision);
+
+	void addClock(SystemClock* clock);
+	void removeClock(SystemClock* clock);
+
+private:
+	void onTimerReady();
+	void tick();
+	void arm();
+	void disarm();
+
+	SystemClock::Enum precision;
+	int fd = -1;
+	QSocketNotifier* notifier = nullptr;
+	QList<SystemClock*> clocks;
+	QDateTime currentTime;
+};
+
+SystemClockScheduler::SystemClockScheduler(SystemClock::Enum precision): precision(precision) {
+	this->fd = timerfd_create(CLOCK_REALTIME, TFD_CLOEXEC | TFD_NONBLOCK);
+
+	if (this->fd == -1) {
+		qCCritical(logClock) << "Failed to create clock timerfd:" << strerror(errno); // NOLINT
+		return;
+	}
 
-void SystemClock::setEnabled(bool enabled) {
-	if (enabled == this->mEnabled) return;
-	this->mEnabled = enabled;
-	emit this->enabledChanged();
-	this->update();
-}
+	this->notifier = new QSocketNotifier(this->fd, QSocketNotifier::Read);
+	this->notifier->setEnabled(false);
 
-SystemClock::Enum SystemClock::precision() const { return this->mPrecision; }
+	QObject::connect(this->notifier, &QSocketNotifier::activated, this->notifier, [this]() {
+		this->onTimerReady();
+	});
+}
 
-void SystemClock::setPrecision(SystemClock::Enum precision) {
-	if (precision == this->mPrecision) return;
-	this->mPrecision = precision;
-	emit this->precisionChanged();
-	this->update();
+SystemClockScheduler::~SystemClockScheduler() {
+	delete this->notifier;
+	if (this->fd != -1) close(this->fd);
 }
 
-void SystemClock::onTimeout() {
-	this->setTime(this->targetTime);
-	this->schedule(this->targetTime);
+SystemClockScheduler* SystemClockScheduler::forPrecision(SystemClock::Enum precision) {
+	// NOLINTNEXTLINE
+	static auto schedulers = std::array<SystemClockScheduler*, 3> {
+	    new SystemClockScheduler(SystemClock::Hours),
+	    new SystemClockScheduler(SystemClock::Minutes),
+	    new SystemClockScheduler(SystemClock::Seconds),
+	};
+
+	auto index = std::clamp(static_cast<int>(precision), 1, 3) - 1;
+	return schedulers.at(index);
 }
 
-void SystemClock::update() {
-	if (this->mEnabled) {
-		this->setTime(QDateTime::fromMSecsSinceEpoch(0));
-		this->schedule(QDateTime::fromMSecsSinceEpoch(0));
+void SystemClockScheduler::addClock(SystemClock* clock) {
+	this->clocks.push_back(clock);
+
+	if (this->clocks.length() == 1) {
+		qCDebug(logClock) << "Starting clock scheduler for precision" << this->precision;
+		this->tick();
+		this->arm();
 	} else {
-		this->timer.stop();
+		clock->setTime(this->currentTime);
+	}
+}
+
+void SystemClockScheduler::removeClock(SystemClock* clock) {
+	this->clocks.removeOne(clock);
+
+	if (this->clocks.isEmpty()) {
+		qCDebug(logClock) << "Stopping clock scheduler for precision" << this->precision;
+		this->disarm();
+	}
+}
+
+void SystemClockScheduler::onTimerReady() {
+	quint64 expirations = 0;
+
+	if (read(this->fd, &expirations, sizeof(expirations)) == -1) {
+		if (errno == EAGAIN) return;
+
+		if (errno == ECANCELED) {
+			qCDebug(logClock) << "System clock changed discontinuously, resynchronizing.";
+		} else {
+			qCWarning(logClock) << "Failed to read clock timerfd:" << strerror(errno); // NOLINT
+		}
 	}
+
+	this->tick();
+	this->arm();
 }
 
-void SystemClock::setTime(const QDateTime& targetTime) {
-	auto currentTime = QDateTime::currentDateTime();
-	auto offset = currentTime.msecsTo(targetTime);
-	this->currentTime = offset > -500 && offset < 500 ? targetTime : currentTime;
+void SystemClockScheduler::tick() {
+	auto time = QDateTime::currentDateTime();
+	auto brokenDown = time.time();
 
-	auto time = this->currentTime.time();
-	this->currentTime.setTime(QTime(
-	    this->mPrecision >= SystemClock::Hours ? time.hour() : 0,
-	    this->mPrecision >= SystemClock::Minutes ? time.minute() : 0,
-	    this->mPrecision >= SystemClock::Seconds ? time.second() : 0
+	time.setTime(QTime(
+	    brokenDown.hour(),
+	    this->precision >= SystemClock::Minutes ? brokenDown.minute() : 0,
+	    this->precision >= SystemClock::Seconds ? brokenDown.second() : 0
 	));
 
-	emit this->dateChanged();
+	this->currentTime = time;
+
+	// clocks may be removed by handlers of dateChanged
+	const auto clocks = this->clocks;
+	for (auto* clock: clocks) {
+		clock->setTime(time);
+	}
 }
 
-void SystemClock::schedule(const QDateTime& targetTime) {
-	auto secondPrecision = this->mPrecision >= SystemClock::Seconds;
-	auto minutePrecision = this->mPrecision >= SystemClock::Minutes;
-	auto hourPrecision = this->mPrecision >= SystemClock::Hours;
+void SystemClockScheduler::arm() {
+	if (this->fd == -1 || this->clocks.isEmpty()) return;
 
-	auto currentTime = QDateTime::currentDateTime();
+	auto nextTime = this->currentTime;
+	if (this->precision == SystemClock::Seconds) nextTime = nextTime.addSecs(1);
+	else if (this->precision == SystemClock::Minutes) nextTime = nextTime.addSecs(60);
+	else nextTime = nextTime.addSecs(3600);
 
-	auto offset = currentTime.msecsTo(targetTime);
+	auto nextMs = nextTime.toMSecsSinceEpoch();
 
-	// timer skew
-	auto nextTime = offset > 0 && offset < 500 ? targetTime : currentTime;
+	auto spec = itimerspec();
+	spec.it_value.tv_sec = static_cast<time_t>(nextMs / 1000);
+	spec.it_value.tv_nsec = static_cast<long>((nextMs % 1000) * 1000000); // NOLINT
 
-	auto baseTimeT = nextTime.time();
-	nextTime.setTime(QTime(
-	    hourPrecision ? baseTimeT.hour() : 0,
-	    minutePrecision ? baseTimeT.minute() : 0,
-	    secondPrecision ? baseTimeT.second() : 0
-	));
+	auto flags = TFD_TIMER_ABSTIME | TFD_TIMER_CANCEL_ON_SET;
+	if (timerfd_settime(this->fd, flags, &spec, nullptr) == -1) {
+		qCWarning(logClock) << "Failed to arm clock timerfd:" << strerror(errno); // NOLINT
+		return;
+	}
+
+	this->notifier->setEnabled(true);
+}
+
+void SystemClockScheduler::disarm() {
+	if (this->fd == -1) return;
+
+	auto spec = itimerspec();
+	timerfd_settime(this->fd, 0, &spec, nullptr);
+	this->notifier->setEnabled(false);
+}
+
+SystemClock::SystemClock(QObject* parent): QObject(parent) { this->update(); }
+
+SystemClock::~SystemClock() {
+	if (this->scheduler) this->scheduler->removeClock(this);
+}
+
+bool SystemClock::enabled() const { return this->mEnabled; }
+
+void SystemClock::setEnabled(bool enabled) {
+	if (enabled == this->mEnabled) return;
+	this->mEnabled = enabled;
+	emit this->enabledChanged();
+	this->update();
+}
+
+SystemClock::Enum SystemClock::precision() const { return this->mPrecision; }
+
+void SystemClock::setPrecision(SystemClock::Enum precision) {
+	if (precision == this->mPrecision) return;
+	this->mPrecision = precision;
+	emit this->precisionChanged();
+	this->update();
+}
 
-	if (secondPrecision) nextTime = nextTime.addSecs(1);
-	else if (minutePrecision) nextTime = nextTime.addSecs(60);
-	else if (hourPrecision) nextTime = nextTime.addSecs(3600);
+void SystemClock::update() {
+	auto* scheduler =
+	    this->mEnabled ? SystemClockScheduler::forPrecision(this->mPrecision) : nullptr;
+
+	if (scheduler == this->scheduler) return;
 
-	auto delay = currentTime.msecsTo(nextTime);
+	if (this->scheduler) this->scheduler->removeClock(this);
+	this->scheduler = scheduler;
+	if (this->scheduler) this->scheduler->addClock(this);
+}
 
-	this->timer.start(static_cast<qint32>(delay));
-	this->targetTime = nextTime;
+void SystemClock::setTime(const QDateTime& time) {
+	if (time == this->currentTime) return;
+	this->currentTime = time;
+	emit this->dateChanged();
 }
@@ -3,10 +3,12 @@
 #include <qdatetime.h>
 #include <qobject.h>
 #include <qqmlintegration.h>
-#include <qtimer.h>
+#include <qtclasshelpermacros.h>
 #include <qtmetamacros.h>
 #include <qtypes.h>
 
+class SystemClockScheduler;
+
 ///! System clock accessor.
 /// SystemClock is a view into the system's clock.
 /// It updates at hour, minute, or second intervals depending on @@precision.
@@ -23,10 +25,12 @@
 /// }
 /// ```
 ///
-/// > [!WARNING] Clock updates will trigger within 50ms of the system clock changing,
-/// > however this can be either before or after the clock changes (+-50ms). If you
-/// > need a date object, use @@date instead of constructing a new one, or the time
-/// > of the constructed object could be off by up to a second.
+/// Clock updates trigger as soon as the system clock passes the next hour, minute or
+/// second, including after a suspend or when the system time is changed.
+/// All clocks with the same precision update together.
+///
+/// > [!WARNING] If you need a date object, use @@date instead of constructing a new one,
+/// > or the time of the constructed object could be off by up to a second.
 class SystemClock: public QObject {
 	Q_OBJECT;
 	/// If the clock should update. Defaults to true.
@@ -58,6 +62,8 @@ public:
 	Q_ENUM(Enum);
 
 	explicit SystemClock(QObject* parent = nullptr);
+	~SystemClock() override;
+	Q_DISABLE_COPY_MOVE(SystemClock);
 
 	[[nodiscard]] bool enabled() const;
 	void setEnabled(bool enabled);
@@ -75,17 +81,14 @@ signals:
 	void precisionChanged();
 	void dateChanged();
 
-private slots:
-	void onTimeout();
-
 private:
 	bool mEnabled = true;
 	SystemClock::Enum mPrecision = SystemClock::Seconds;
-	QTimer timer;
+	SystemClockScheduler* scheduler = nullptr;
 	QDateTime currentTime;
-	QDateTime targetTime;
 
 	void update();
-	void setTime(const QDateTime& targetTime);
-	void schedule(const QDateTime& targetTime);
+	void setTime(const QDateTime& time);
+
+	friend class SystemClockScheduler;
 };
@@ -0,0 +1,78 @@
+#include "delegatepool.hpp"
+
+#include <qcontainerfwd.h>
+#include <qlogging.h>
+#include <qloggingcategory.h>
+#include <qmetaobject.h>
+#include <qobject.h>
+#include <qpointer.h>
+#include <qqmlcomponent.h>
+#include <qtypes.h>
+
+namespace {
+Q_LOGGING_CATEGORY(logDelegatePool, "quickshell.delegatepool", QtWarningMsg);
+
+void invokeHook(QObject* instance, const char* signature, const char* name) {
+	if (instance->metaObject()->indexOfMethod(signature) == -1) return;
+	QMetaObject::invokeMethod(instance, name);
+}
+
+} // namespace
+
+void DelegatePool::setComponent(QQmlComponent* component) {
+	if (component == this->component) return;
+	this->component = component;
+	this->clear();
+}
+
+void DelegatePool::setCapacity(qsizetype capacity) {
+	this->mCapacity = capacity;
+
+	while (this->parked.size() > capacity) {
+		if (auto* instance = this->parked.takeLast().data()) instance->deleteLater();
+	}
+}
+
+QObject* DelegatePool::take(const QVariantMap& properties) {
+	if (this->mCapacity == 0) return nullptr;
+
+	while (!this->parked.isEmpty()) {
+		auto* instance = this->parked.takeLast().data();
+		if (instance == nullptr) continue;
+
+		for (auto [name, value]: properties.asKeyValueRange()) {
+			instance->setProperty(name.toUtf8().constData(), value);
+		}
+
+		invokeHook(instance, "reused()", "reused");
+
+		this->mHits++;
+		qCDebug(logDelegatePool) << "Reused" << instance << "(hits:" << this->mHits
+		                         << "misses:" << this->mMisses << "parked:" << this->parked.size()
+		                         << ")";
+
+		return instance;
+	}
+
+	this->mMisses++;
+	qCDebug(logDelegatePool) << "No parked instance to reuse (hits:" << this->mHits
+	                         << "misses:" << this->mMisses << ")";
+
+	return nullptr;
+}
+
+bool DelegatePool::park(QObject* instance) {
+	if (this->parked.size() >= this->mCapacity) return false;
+
+	invokeHook(instance, "pooled()", "pooled");
+	this->parked.push_back(instance);
+	return true;
+}
+
+void DelegatePool::clear() {
+	for (auto& instance: this->parked) {
+		if (instance) instance->deleteLater();
+	}
+
+	this->parked.clear();
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <qcontainerfwd.h>
+#include <qlist.h>
+#include <qobject.h>
+#include <qpointer.h>
+#include <qqmlcomponent.h>
+#include <qtypes.h>
+
+// Parks delegate instances that are no longer needed so they can be handed out again
+// instead of creating a new instance of the component.
+//
+// Parked instances have their `pooled()` function called if they define one, and
+// reused instances have their properties rewritten before `reused()` is called.
+class DelegatePool {
+public:
+	// Discards parked instances if the component changes.
+	void setComponent(QQmlComponent* component);
+
+	[[nodiscard]] qsizetype capacity() const { return this->mCapacity; }
+	// Discards parked instances over the new capacity. A capacity of 0 disables the pool.
+	void setCapacity(qsizetype capacity);
+
+	// Returns a parked instance with the given properties applied, or nullptr if there are none.
+	QObject* take(const QVariantMap& properties);
+	// Parks the instance. Returns false if the pool is full, in which case the caller
+	// still owns the instance.
+	bool park(QObject* instance);
+	// Destroys all parked instances.
+	void clear();
+
+	[[nodiscard]] qsizetype size() const { return this->parked.size(); }
+	[[nodiscard]] qsizetype hits() const { return this->mHits; }
+	[[nodiscard]] qsizetype misses() const { return this->mMisses; }
+
+private:
+	QPointer<QQmlComponent> component;
+	QList<QPointer<QObject>> parked;
+	qsizetype mCapacity = 0;
+	qsizetype mHits = 0;
+	qsizetype mMisses = 0;
+};
@@ -1,8 +1,17 @@
 #include "desktopentry.hpp"
 
+#include <algorithm>
+#include <cerrno>
+#include <ranges>
+#include <utility>
+
 #include <qcontainerfwd.h>
+#include <qdatastream.h>
+#include <qdatetime.h>
 #include <qdebug.h>
 #include <qdir.h>
+#include <qelapsedtimer.h>
+#include <qfile.h>
 #include <qfileinfo.h>
 #include <qhash.h>
 #include <qlist.h>
@@ -11,12 +20,20 @@
 #include <qnamespace.h>
 #include <qobject.h>
 #include <qpair.h>
-#include <qprocess.h>
+#include <qsavefile.h>
+#include <qset.h>
+#include <qsocketnotifier.h>
 #include <qstringview.h>
 #include <qtenvironmentvariables.h>
-#include <ranges>
+#include <qthreadpool.h>
+#include <qtimer.h>
+#include <qtypes.h>
+#include <sys/inotify.h>
+#include <unistd.h>
 
 #include "model.hpp"
+#include "paths.hpp"
+#include "spawn.hpp"
 
 namespace {
 Q_LOGGING_CATEGORY(logDesktopEntry, "quickshell.desktopentry", QtWarningMsg);
@@ -63,16 +80,16 @@ struct Locale {
 		return score;
 	}
 
-	static const Locale& system() {
-		static Locale* locale = nullptr; // NOLINT
-
-		if (locale == nullptr) {
-			auto lstr = qEnvironmentVariable("LC_MESSAGES");
-			if (lstr.isEmpty()) lstr = qEnvironmentVariable("LANG");
-			locale = new Locale(lstr);
-		}
+	static QString systemName() {
+		auto lstr = qEnvironmentVariable("LC_MESSAGES");
+		if (lstr.isEmpty()) lstr = qEnvironmentVariable("LANG");
+		return lstr;
+	}
 
-		return *locale;
+	// Parsing happens on worker threads, so initialization has to be thread safe.
+	static const Locale& system() {
+		static const auto locale = Locale(Locale::systemName());
+		return locale;
 	}
 
 	QString language;
@@ -89,46 +106,49 @@ QDebug operator<<(QDebug debug, const Locale& locale) {
 	return debug;
 }
 
-void DesktopEntry::parseEntry(const QString& text) {
+DesktopEntryData DesktopEntryData::parse(const QString& id, const QString& text) {
 	const auto& system = Locale::system();
 
+	auto data = DesktopEntryData();
+	data.id = id;
+
 	auto groupName = QString();
 	auto entries = QHash<QString, QPair<Locale, QString>>();
 
-	auto finishCategory = [this, &groupName, &entries]() {
+	auto finishCategory = [&data, &groupName, &entries]() {
 		if (groupName == "Desktop Entry") {
 			if (entries["Type"].second != "Application") return;
 			if (entries.contains("Hidden") && entries["Hidden"].second == "true") return;
 
 			for (const auto& [key, pair]: entries.asKeyValueRange()) {
 				auto& [_, value] = pair;
-				this->mEntries.insert(key, value);
-
-				if (key == "Name") this->mName = value;
-				else if (key == "GenericName") this->mGenericName = value;
-				else if (key == "NoDisplay") this->mNoDisplay = value == "true";
-				else if (key == "Comment") this->mComment = value;
-				else if (key == "Icon") this->mIcon = value;
-				else if (key == "Exec") this->mExecString = value;
-				else if (key == "Path") this->mWorkingDirectory = value;
-				else if (key == "Terminal") this->mTerminal = value == "true";
-				else if (key == "Categories") this->mCategories = value.split(u';', Qt::SkipEmptyParts);
-				else if (key == "Keywords") this->mKeywords = value.split(u';', Qt::SkipEmptyParts);
+				data.entries.insert(key, value);
+
+				if (key == "Name") data.name = value;
+				else if (key == "GenericName") data.genericName = value;
+				else if (key == "NoDisplay") data.noDisplay = value == "true";
+				else if (key == "Comment") data.comment = value;
+				else if (key == "Icon") data.icon = value;
+				else if (key == "Exec") data.execString = value;
+				else if (key == "Path") data.workingDirectory = value;
+				else if (key == "Terminal") data.terminal = value == "true";
+				else if (key == "Categories") data.categories = value.split(u';', Qt::SkipEmptyParts);
+				else if (key == "Keywords") data.keywords = value.split(u';', Qt::SkipEmptyParts);
 			}
 		} else if (groupName.startsWith("Desktop Action ")) {
-			auto actionName = groupName.sliced(16);
-			auto* action = new DesktopAction(actionName, this);
+			auto action = DesktopActionData();
+			action.id = groupName.sliced(16);
 
 			for (const auto& [key, pair]: entries.asKeyValueRange()) {
 				const auto& [_, value] = pair;
-				action->mEntries.insert(key, value);
+				action.entries.insert(key, value);
 
-				if (key == "Name") action->mName = value;
-				else if (key == "Icon") action->mIcon = value;
-				else if (key == "Exec") action->mExecString = value;
+				if (key == "Name") action.name = value;
+				else if (key == "Icon") action.icon = value;
+				else if (key == "Exec") action.execString = value;
 			}
 
-			this->mActions.insert(actionName, action);
+			data.actions.push_back(std::move(action));
 		}
 
 		entries.clear();
@@ -174,6 +194,31 @@ void DesktopEntry::parseEntry(const QString& text) {
 	}
 
 	finishCategory();
+	return data;
+}
+
+DesktopEntry::DesktopEntry(const DesktopEntryData& data, QObject* parent)
+    : QObject(parent)
+    , mId(data.id)
+    , mName(data.name)
+    , mGenericName(data.genericName)
+    , mNoDisplay(data.noDisplay)
+    , mComment(data.comment)
+    , mIcon(data.icon)
+    , mExecString(data.execString)
+    , mWorkingDirectory(data.workingDirectory)
+    , mTerminal(data.terminal)
+    , mCategories(data.categories)
+    , mKeywords(data.keywords)
+    , mEntries(data.entries) {
+	for (const auto& actionData: data.actions) {
+		auto* action = new DesktopAction(actionData.id, this);
+		action->mName = actionData.name;
+		action->mIcon = actionData.icon;
+		action->mExecString = actionData.execString;
+		action->mEntries = actionData.entries;
+		this->mActions.insert(actionData.id, action);
+	}
 }
 
 void DesktopEntry::execute() const {
@@ -256,23 +301,56 @@ void DesktopEntry::doExec(const QString& execString, const QString& workingDirec
 		return;
 	}
 
-	auto process = QProcess();
-	process.setProgram(args.at(0));
-	process.setArguments(args.sliced(1));
-	if (!workingDirectory.isEmpty()) process.setWorkingDirectory(workingDirectory);
-	process.startDetached();
+	// QProcess::startDetached forks all of quickshell, which is slow for a large process.
+	SpawnedProcess::startDetached(args.at(0), args.sliced(1), workingDirectory);
 }
 
 void DesktopAction::execute() const {
 	DesktopEntry::doExec(this->mExecString, this->entry->mWorkingDirectory);
 }
 
-DesktopEntryManager::DesktopEntryManager() {
-	this->scanDesktopEntries();
-	this->populateApplications();
+// NOLINTBEGIN(misc-use-internal-linkage)
+// These must be visible to argument dependent lookup from Qt's container stream operators.
+QDataStream& operator<<(QDataStream& stream, const DesktopActionData& data) {
+	stream << data.id << data.name << data.icon << data.execString << data.entries;
+	return stream;
 }
 
-void DesktopEntryManager::scanDesktopEntries() {
+QDataStream& operator>>(QDataStream& stream, DesktopActionData& data) {
+	stream >> data.id >> data.name >> data.icon >> data.execString >> data.entries;
+	return stream;
+}
+
+QDataStream& operator<<(QDataStream& stream, const DesktopEntryFile& file) {
+	const auto& data = file.data;
+	stream << file.path << file.modified << file.size;
+	stream << data.id << data.name << data.genericName << data.noDisplay << data.comment << data.icon
+	       << data.execString << data.workingDirectory << data.terminal << data.categories
+	       << data.keywords << data.entries << data.actions;
+
+	return stream;
+}
+
+QDataStream& operator>>(QDataStream& stream, DesktopEntryFile& file) {
+	auto& data = file.data;
+	stream >> file.path >> file.modified >> file.size;
+	stream >> data.id >> data.name >> data.genericName >> data.noDisplay >> data.comment >> data.icon
+	    >> data.execString >> data.workingDirectory >> data.terminal >> data.categories
+	    >> data.keywords >> data.entries >> data.actions;
+
+	return stream;
+}
+// NOLINTEND(misc-use-internal-linkage)
+
+namespace {
+
+constexpr quint32 CACHE_MAGIC = 0x51534445; // QSDE
+constexpr quint32 CACHE_VERSION = 1;
+
+// Package managers touch many files at once, so change notifications are coalesced.
+constexpr int RESCAN_DELAY_MS = 250;
+
+QVector<QString> applicationDirs() {
 	QList<QString> dataPaths;
 
 	if (qEnvironmentVariableIsSet("XDG_DATA_DIRS")) {
@@ -283,7 +361,7 @@ void DesktopEntryManager::scanDesktopEntries() {
 		dataPaths.push_back("/usr/share");
 	}
 
-	qCDebug(logDesktopEntry) << "Creating desktop entry scanners";
+	auto dirs = QVector<QString>();
 
 	for (auto& path: std::ranges::reverse_view(dataPaths)) {
 		auto p = QDir(path).filePath("applications");
@@ -294,22 +372,24 @@ void DesktopEntryManager::scanDesktopEntries() {
 			continue;
 		}
 
-		qCDebug(logDesktopEntry) << "Scanning path" << p;
-		this->scanPath(p);
+		dirs.push_back(p);
 	}
+
+	return dirs;
 }
 
-void DesktopEntryManager::populateApplications() {
-	for (auto& entry: this->desktopEntries.values()) {
-		if (!entry->noDisplay()) this->mApplications.insertObject(entry);
-	}
+qint64 dirModified(const QString& path) {
+	return QFileInfo(path).lastModified().toMSecsSinceEpoch();
 }
 
-void DesktopEntryManager::scanPath(const QDir& dir, const QString& prefix) {
+// Collects directories and desktop files without reading them.
+void enumeratePath(const QDir& dir, const QString& prefix, DesktopEntryScan& scan) {
+	scan.dirs.push_back(qMakePair(dir.absolutePath(), dirModified(dir.absolutePath())));
+
 	auto entries = dir.entryInfoList(QDir::Dirs | QDir::Files | QDir::NoDotAndDotDot);
 
 	for (auto& entry: entries) {
-		if (entry.isDir()) this->scanPath(entry.absoluteFilePath(), prefix + dir.dirName() + "-");
+		if (entry.isDir()) enumeratePath(entry.absoluteFilePath(), prefix + dir.dirName() + "-", scan);
 		else if (entry.isFile()) {
 			auto path = entry.filePath();
 			if (!path.endsWith(".desktop")) {
@@ -317,54 +397,405 @@ void DesktopEntryManager::scanPath(const QDir& dir, const QString& prefix) {
 				continue;
 			}
 
-			auto file = QFile(path);
-			if (!file.open(QFile::ReadOnly)) {
-				qCDebug(logDesktopEntry) << "Could not open file" << path;
-				continue;
-			}
+			auto file = DesktopEntryFile();
+			file.path = path;
+			file.modified = entry.lastModified().toMSecsSinceEpoch();
+			file.size = entry.size();
+			file.data.id = prefix + entry.fileName().sliced(0, entry.fileName().length() - 8);
+			scan.files.push_back(std::move(file));
+		}
+	}
+}
 
-			auto id = prefix + entry.fileName().sliced(0, entry.fileName().length() - 8);
-			auto lowerId = id.toLower();
+void parseFile(DesktopEntryFile& file) {
+	auto qfile = QFile(file.path);
+	if (!qfile.open(QFile::ReadOnly)) {
+		qCDebug(logDesktopEntry) << "Could not open file" << file.path;
+		file.data = DesktopEntryData {.id = file.data.id};
+		return;
+	}
 
-			auto text = QString::fromUtf8(file.readAll());
-			auto* dentry = new DesktopEntry(id, this);
-			dentry->parseEntry(text);
+	auto text = QString::fromUtf8(qfile.readAll());
+	file.data = DesktopEntryData::parse(file.data.id, text);
+}
 
-			if (!dentry->isValid()) {
-				qCDebug(logDesktopEntry) << "Skipping desktop entry" << path;
-				delete dentry;
-				continue;
-			}
+void parseFiles(
+    QVector<DesktopEntryFile>& files,
+    const QVector<qsizetype>& indices,
+    bool parallel
+) {
+	// detach once up front so workers only touch distinct elements
+	auto* data = files.data();
 
-			qCDebug(logDesktopEntry) << "Found desktop entry" << id << "at" << path;
+	if (!parallel || indices.size() < 2) {
+		for (auto i: indices) parseFile(data[i]);
+		return;
+	}
 
-			auto conflictingId = this->desktopEntries.contains(id);
+	QThreadPool pool;
+	auto chunkCount = std::min(static_cast<qsizetype>(pool.maxThreadCount()), indices.size());
+	auto chunkSize = (indices.size() + chunkCount - 1) / chunkCount;
 
-			if (conflictingId) {
-				qCDebug(logDesktopEntry) << "Replacing old entry for" << id;
-				delete this->desktopEntries.value(id);
-				this->desktopEntries.remove(id);
-				this->lowercaseDesktopEntries.remove(lowerId);
-			}
+	for (qsizetype start = 0; start < indices.size(); start += chunkSize) {
+		auto end = std::min(start + chunkSize, indices.size());
 
-			this->desktopEntries.insert(id, dentry);
+		pool.start([data, &indices, start, end]() {
+			for (auto i = start; i != end; i++) parseFile(data[indices.at(i)]);
+		});
+	}
 
-			if (this->lowercaseDesktopEntries.contains(lowerId)) {
-				qCInfo(logDesktopEntry).nospace()
-				    << "Multiple desktop entries have the same lowercased id " << lowerId
-				    << ". This can cause ambiguity when byId requests are not made with the correct case "
-				       "already.";
+	pool.waitForDone();
+}
 
-				this->lowercaseDesktopEntries.remove(lowerId);
-			}
+QString cachePath() {
+	auto* dir = QsPaths::instance()->cacheDir();
+	if (!dir) return QString();
+	return dir->filePath("desktopentries.cache");
+}
+
+} // namespace
+
+DesktopEntryScan DesktopEntryManager::scanDirs(
+    const QVector<QString>& roots,
+    const DesktopEntryScan& previous,
+    bool parallel
+) {
+	auto scan = DesktopEntryScan();
+	scan.roots = roots;
+
+	for (const auto& root: roots) {
+		qCDebug(logDesktopEntry) << "Scanning path" << root;
+		enumeratePath(root, QString(), scan);
+	}
+
+	auto previousFiles = QHash<QString, const DesktopEntryFile*>();
+	for (const auto& file: previous.files) {
+		previousFiles.insert(file.path, &file);
+	}
+
+	auto changed = QVector<qsizetype>();
 
-			this->lowercaseDesktopEntries.insert(lowerId, dentry);
+	for (qsizetype i = 0; i != scan.files.size(); i++) {
+		const auto& file = scan.files.at(i);
+		const auto* old = previousFiles.value(file.path);
+
+		if (old && old->modified == file.modified && old->size == file.size
+		    && old->data.id == file.data.id)
+		{
+			scan.files[i].data = old->data;
+		} else {
+			changed.push_back(i);
 		}
 	}
+
+	parseFiles(scan.files, changed, parallel);
+
+	qCDebug(logDesktopEntry) << "Scanned" << scan.files.size() << "desktop files," << changed.size()
+	                         << "of which were parsed";
+
+	return scan;
+}
+
+DesktopEntryScan DesktopEntryManager::loadCache(const QString& path) {
+	if (path.isEmpty()) return DesktopEntryScan();
+
+	auto file = QFile(path);
+	if (!file.open(QFile::ReadOnly)) return DesktopEntryScan();
+
+	auto stream = QDataStream(&file);
+	stream.setVersion(QDataStream::Qt_6_0);
+
+	quint32 magic = 0;
+	quint32 version = 0;
+	stream >> magic >> version;
+	if (magic != CACHE_MAGIC || version != CACHE_VERSION) return DesktopEntryScan();
+
+	QString locale;
+	stream >> locale;
+	if (locale != Locale::systemName()) {
+		qCDebug(logDesktopEntry) << "Ignoring desktop entry cache created for another locale";
+		return DesktopEntryScan();
+	}
+
+	auto scan = DesktopEntryScan();
+	stream >> scan.roots >> scan.dirs >> scan.files;
+
+	if (stream.status() != QDataStream::Ok) {
+		qCWarning(logDesktopEntry) << "Desktop entry cache at" << path << "is corrupt.";
+		return DesktopEntryScan();
+	}
+
+	return scan;
+}
+
+void DesktopEntryManager::saveCache(const QString& path, const DesktopEntryScan& scan) {
+	if (path.isEmpty()) return;
+
+	auto file = QSaveFile(path);
+	if (!file.open(QFile::WriteOnly)) {
+		qCWarning(logDesktopEntry) << "Could not write desktop entry cache to" << path;
+		return;
+	}
+
+	auto stream = QDataStream(&file);
+	stream.setVersion(QDataStream::Qt_6_0);
+	stream << CACHE_MAGIC << CACHE_VERSION << Locale::systemName();
+	stream << scan.roots << scan.dirs << scan.files;
+
+	if (!file.commit()) {
+		qCWarning(logDesktopEntry) << "Could not write desktop entry cache to" << path;
+	}
+}
+
+bool DesktopEntryManager::cacheValid(const DesktopEntryScan& cache, const QVector<QString>& roots) {
+	if (cache.roots.isEmpty() || cache.roots != roots) return false;
+
+	for (const auto& [path, modified]: cache.dirs) {
+		if (dirModified(path) != modified) return false;
+	}
+
+	// Files edited in place don't change the mtime of their directory.
+	for (const auto& file: cache.files) {
+		auto info = QFileInfo(file.path);
+
+		if (info.lastModified().toMSecsSinceEpoch() != file.modified || info.size() != file.size) {
+			qCDebug(logDesktopEntry) << "Desktop entry cache is stale as" << file.path << "changed";
+			return false;
+		}
+	}
+
+	return true;
+}
+
+DesktopEntryManager::DesktopEntryManager() {
+	this->rescanTimer.setSingleShot(true);
+	this->rescanTimer.setInterval(RESCAN_DELAY_MS);
+	QObject::connect(&this->rescanTimer, &QTimer::timeout, this, &DesktopEntryManager::rescan);
+}
+
+void DesktopEntryManager::scanDesktopEntries() {
+	auto timer = QElapsedTimer();
+	timer.start();
+
+	auto path = cachePath();
+	auto roots = applicationDirs();
+	auto cache = DesktopEntryManager::loadCache(path);
+
+	if (DesktopEntryManager::cacheValid(cache, roots)) {
+		qCDebug(logDesktopEntry) << "Using desktop entry cache at" << path;
+		this->applyScan(cache);
+	} else {
+		auto scan = DesktopEntryManager::scanDirs(roots, cache, true);
+		this->applyScan(scan);
+
+		QThreadPool::globalInstance()->start([path, scan = std::move(scan)]() {
+			DesktopEntryManager::saveCache(path, scan);
+		});
+	}
+
+	qCDebug(logDesktopEntry) << "Loaded" << this->desktopEntries.size() << "desktop entries in"
+	                         << timer.elapsed() << "ms";
+}
+
+void DesktopEntryManager::rescan() {
+	if (this->rescanRunning) {
+		this->rescanPending = true;
+		return;
+	}
+
+	this->rescanRunning = true;
+	this->rescanPending = false;
+
+	auto roots = applicationDirs();
+	auto path = cachePath();
+
+	QThreadPool::globalInstance()->start([this, roots, path, previous = this->mScan]() {
+		auto scan = DesktopEntryManager::scanDirs(roots, previous, false);
+		DesktopEntryManager::saveCache(path, scan);
+
+		QMetaObject::invokeMethod(
+		    this,
+		    [this, scan]() {
+			    this->rescanRunning = false;
+			    this->applyScan(scan);
+			    this->updateWatches();
+			    if (this->rescanPending) this->rescan();
+		    },
+		    Qt::QueuedConnection
+		);
+	});
+}
+
+void DesktopEntryManager::applyScan(const DesktopEntryScan& scan) {
+	this->mScan = scan;
+
+	// later files take priority over earlier ones with the same id
+	auto resolved = QHash<QString, const DesktopEntryFile*>();
+	auto lowercaseIds = QHash<QString, QString>();
+
+	for (const auto& file: std::as_const(this->mScan.files)) {
+		const auto& id = file.data.id;
+
+		if (!file.data.isValid()) {
+			qCDebug(logDesktopEntry) << "Skipping desktop entry" << file.path;
+			continue;
+		}
+
+		if (resolved.contains(id)) {
+			qCDebug(logDesktopEntry) << "Replacing old entry for" << id;
+		}
+
+		resolved.insert(id, &file);
+
+		auto lowerId = id.toLower();
+		auto conflicting = lowercaseIds.find(lowerId);
+		if (conflicting != lowercaseIds.end() && *conflicting != id) {
+			qCInfo(logDesktopEntry).nospace()
+			    << "Multiple desktop entries have the same lowercased id " << lowerId
+			    << ". This can cause ambiguity when byId requests are not made with the correct case "
+			       "already.";
+		}
+
+		lowercaseIds.insert(lowerId, id);
+	}
+
+	auto removed = QVector<DesktopEntry*>();
+
+	for (auto it = this->desktopEntries.begin(); it != this->desktopEntries.end();) {
+		auto* entry = *it;
+		const auto* file = resolved.value(it.key());
+
+		if (!file || file->path != entry->sourcePath || file->modified != entry->sourceModified
+		    || file->size != entry->sourceSize)
+		{
+			removed.push_back(entry);
+			it = this->desktopEntries.erase(it);
+		} else {
+			++it;
+		}
+	}
+
+	auto added = 0;
+
+	for (const auto* file: std::as_const(resolved)) {
+		if (this->desktopEntries.contains(file->data.id)) continue;
+
+		qCDebug(logDesktopEntry) << "Found desktop entry" << file->data.id << "at" << file->path;
+		auto* entry = new DesktopEntry(file->data, this);
+		entry->sourcePath = file->path;
+		entry->sourceModified = file->modified;
+		entry->sourceSize = file->size;
+		this->desktopEntries.insert(file->data.id, entry);
+		added++;
+	}
+
+	this->lowercaseDesktopEntries.clear();
+	for (const auto& [lowerId, id]: lowercaseIds.asKeyValueRange()) {
+		this->lowercaseDesktopEntries.insert(lowerId, this->desktopEntries.value(id));
+	}
+
+	// keep the existing order of applications and append new ones
+	auto applications = QVector<DesktopEntry*>();
+	auto kept = QSet<DesktopEntry*>();
+
+	for (auto* entry: this->mApplications.valueList()) {
+		if (this->desktopEntries.value(entry->mId) == entry) {
+			applications.push_back(entry);
+			kept.insert(entry);
+		}
+	}
+
+	for (auto* entry: std::as_const(this->desktopEntries)) {
+		if (!entry->noDisplay() && !kept.contains(entry)) applications.push_back(entry);
+	}
+
+	this->mApplications.diffUpdate(applications);
+
+	for (auto* entry: removed) {
+		entry->deleteLater();
+	}
+
+	if (added != 0 || !removed.isEmpty()) {
+		qCDebug(logDesktopEntry) << "Desktop entries updated:" << added << "added or changed,"
+		                         << removed.size() << "removed or changed";
+		emit this->entriesChanged();
+	}
+}
+
+void DesktopEntryManager::initWatcher() {
+	this->inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+
+	if (this->inotifyFd == -1) {
+		qCWarning(logDesktopEntry) << "Failed to create inotify instance, desktop entries will not "
+		                              "update while running:"
+		                           << qt_error_string(errno);
+		return;
+	}
+
+	this->inotifyNotifier = new QSocketNotifier(this->inotifyFd, QSocketNotifier::Read, this);
+	QObject::connect(
+	    this->inotifyNotifier,
+	    &QSocketNotifier::activated,
+	    this,
+	    &DesktopEntryManager::onInotifyReadable
+	);
+
+	this->updateWatches();
+}
+
+void DesktopEntryManager::updateWatches() {
+	if (this->inotifyFd == -1) return;
+
+	auto dirs = QSet<QString>();
+	for (const auto& [path, _]: this->mScan.dirs) {
+		dirs.insert(path);
+	}
+
+	for (auto it = this->watches.begin(); it != this->watches.end();) {
+		if (dirs.contains(it.key())) {
+			++it;
+		} else {
+			// fails harmlessly if the directory was deleted and the watch is already gone
+			inotify_rm_watch(this->inotifyFd, it.value());
+			it = this->watches.erase(it);
+		}
+	}
+
+	constexpr auto mask = IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_CLOSE_WRITE
+	                    | IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR;
+
+	for (const auto& path: dirs) {
+		if (this->watches.contains(path)) continue;
+
+		auto wd = inotify_add_watch(this->inotifyFd, path.toLocal8Bit().constData(), mask);
+		if (wd == -1) {
+			qCWarning(logDesktopEntry) << "Failed to watch" << path << "for desktop entry changes:"
+			                           << qt_error_string(errno);
+			continue;
+		}
+
+		this->watches.insert(path, wd);
+	}
+}
+
+void DesktopEntryManager::onInotifyReadable() {
+	// The events themselves are not needed as a rescan compares every file's mtime, only
+	// drain the queue.
+	alignas(inotify_event) char buffer[4096]; // NOLINT
+
+	while (read(this->inotifyFd, buffer, sizeof(buffer)) > 0) {}
+
+	this->rescanTimer.start();
 }
 
 DesktopEntryManager* DesktopEntryManager::instance() {
-	static auto* instance = new DesktopEntryManager(); // NOLINT
+	static auto* instance = []() {
+		auto* manager = new DesktopEntryManager(); // NOLINT
+		manager->scanDesktopEntries();
+		manager->initWatcher();
+		return manager;
+	}();
+
 	return instance;
 }
 
@@ -6,14 +6,49 @@
 #include <qdir.h>
 #include <qhash.h>
 #include <qobject.h>
+#include <qpair.h>
 #include <qqmlintegration.h>
+#include <qsocketnotifier.h>
+#include <qtimer.h>
 #include <qtmetamacros.h>
+#include <qtypes.h>
 
 #include "doc.hpp"
 #include "model.hpp"
 
 class DesktopAction;
 
+struct DesktopActionData {
+	QString id;
+	QString name;
+	QString icon;
+	QString execString;
+	QHash<QString, QString> entries;
+};
+
+// Parsed content of a desktop entry file, independent of the QObject graph so it can
+// be produced on worker threads and cached.
+struct DesktopEntryData {
+	QString id;
+	QString name;
+	QString genericName;
+	bool noDisplay = false;
+	QString comment;
+	QString icon;
+	QString execString;
+	QString workingDirectory;
+	bool terminal = false;
+	QVector<QString> categories;
+	QVector<QString> keywords;
+	QHash<QString, QString> entries;
+	QVector<DesktopActionData> actions;
+
+	[[nodiscard]] bool isValid() const { return !this->name.isEmpty(); }
+
+	// Thread safe.
+	static DesktopEntryData parse(const QString& id, const QString& text);
+};
+
 /// A desktop entry. See @@DesktopEntries for details.
 class DesktopEntry: public QObject {
 	Q_OBJECT;
@@ -41,9 +76,7 @@ class DesktopEntry: public QObject {
 	QML_UNCREATABLE("DesktopEntry instances must be retrieved from DesktopEntries");
 
 public:
-	explicit DesktopEntry(QString id, QObject* parent): QObject(parent), mId(std::move(id)) {}
-
-	void parseEntry(const QString& text);
+	explicit DesktopEntry(const DesktopEntryData& data, QObject* parent);
 
 	/// Run the application. Currently ignores @@runInTerminal and field codes.
 	Q_INVOKABLE void execute() const;
@@ -73,7 +106,13 @@ private:
 	QHash<QString, QString> mEntries;
 	QHash<QString, DesktopAction*> mActions;
 
+	// identifies the file version this entry was created from
+	QString sourcePath;
+	qint64 sourceModified = 0;
+	qint64 sourceSize = 0;
+
 	friend class DesktopAction;
+	friend class DesktopEntryManager;
 };
 
 /// An action of a @@DesktopEntry$.
@@ -107,10 +146,26 @@ private:
 	friend class DesktopEntry;
 };
 
+struct DesktopEntryFile {
+	QString path;
+	qint64 modified = 0;
+	qint64 size = 0;
+	DesktopEntryData data;
+};
+
+// The result of scanning every application directory, in priority order.
+struct DesktopEntryScan {
+	QVector<QString> roots;
+	QVector<QPair<QString, qint64>> dirs;
+	QVector<DesktopEntryFile> files;
+};
+
 class DesktopEntryManager: public QObject {
 	Q_OBJECT;
 
 public:
+	// Loads desktop entries from the cache if it is still valid, otherwise scans all
+	// application directories, reusing cached entries for unchanged files.
 	void scanDesktopEntries();
 
 	[[nodiscard]] DesktopEntry* byId(const QString& id);
@@ -119,15 +174,46 @@ public:
 
 	static DesktopEntryManager* instance();
 
+signals:
+	// Sent after the set of desktop entries changed.
+	void entriesChanged();
+
+private slots:
+	void onInotifyReadable();
+	void rescan();
+
 private:
 	explicit DesktopEntryManager();
 
-	void populateApplications();
-	void scanPath(const QDir& dir, const QString& prefix = QString());
+	void applyScan(const DesktopEntryScan& scan);
+	void initWatcher();
+	void updateWatches();
+
+	// Scans all application directories, only reparsing files not present in `previous`
+	// with the same modification time and size.
+	static DesktopEntryScan
+	scanDirs(const QVector<QString>& roots, const DesktopEntryScan& previous, bool parallel);
+
+	static DesktopEntryScan loadCache(const QString& path);
+	static void saveCache(const QString& path, const DesktopEntryScan& scan);
 
+	// A cache is usable without rescanning if the same roots are scanned and no directory
+	// or file changed since it was written.
+	static bool cacheValid(const DesktopEntryScan& cache, const QVector<QString>& roots);
+
+	DesktopEntryScan mScan;
 	QHash<QString, DesktopEntry*> desktopEntries;
 	QHash<QString, DesktopEntry*> lowercaseDesktopEntries;
 	ObjectModel<DesktopEntry> mApplications {this};
+
+	int inotifyFd = -1;
+	QSocketNotifier* inotifyNotifier = nullptr;
+	QHash<QString, int> watches;
+	QTimer rescanTimer;
+	bool rescanRunning = false;
+	bool rescanPending = false;
+
+	friend class TestDesktopEntryManager;
 };
 
 ///! Desktop entry index.
@@ -136,6 +222,9 @@ private:
 /// Primarily useful for looking up icons and metadata from an id, as there is
 /// currently no mechanism for usage based sorting of entries and other launcher niceties.
 ///
+/// Entries are updated while running when desktop files are added, removed or changed.
+/// Entries of changed files are replaced with new objects.
+///
 /// [desktop entry specification]: https://specifications.freedesktop.org/desktop-entry-spec/latest/
 class DesktopEntries: public QObject {
 	Q_OBJECT;
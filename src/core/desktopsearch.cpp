@@ -0,0 +1,389 @@
+#include "desktopsearch.hpp"
+
+#include <algorithm>
+#include <array>
+#include <utility>
+
+#include <qatomic.h>
+#include <qcontainerfwd.h>
+#include <qhash.h>
+#include <qlogging.h>
+#include <qloggingcategory.h>
+#include <qnamespace.h>
+#include <qobject.h>
+#include <qpair.h>
+#include <qset.h>
+#include <qsharedpointer.h>
+#include <qthreadpool.h>
+#include <qtmetamacros.h>
+#include <qtypes.h>
+
+#include "desktopentry.hpp"
+#include "model.hpp"
+
+namespace {
+Q_LOGGING_CATEGORY(logDesktopSearch, "quickshell.desktopsearch", QtWarningMsg);
+
+// percentage of a field match counted for each field, in DesktopSearchRecord::Field order
+constexpr std::array<qint32, DesktopSearchRecord::FieldCount> FIELD_WEIGHTS = {100, 70, 60, 40};
+
+constexpr qint32 SCORE_EXACT = 1000;
+constexpr qint32 SCORE_PREFIX = 800;
+constexpr qint32 SCORE_WORD = 600;
+constexpr qint32 SCORE_SUBSTRING = 400;
+constexpr qint32 SCORE_SUBSEQUENCE = 100;
+constexpr qint32 SCORE_TRIGRAM = 20;
+
+quint64 charBit(QChar c) { return quint64(1) << (c.unicode() % 64); }
+
+quint64 charMask(const QString& text) {
+	quint64 mask = 0;
+	for (auto c: text) mask |= charBit(c);
+	return mask;
+}
+
+quint64 trigramKey(const QChar* c) {
+	return (quint64(c[0].unicode()) << 32) | (quint64(c[1].unicode()) << 16) | c[2].unicode();
+}
+
+void collectTrigrams(const QString& text, QSet<quint64>& trigrams) {
+	for (qsizetype i = 0; i + 3 <= text.length(); i++) {
+		trigrams.insert(trigramKey(text.constData() + i));
+	}
+}
+
+bool isWordStart(const QString& text, qsizetype i) {
+	if (i == 0) return true;
+	auto c = text.at(i - 1);
+	return c.isSpace() || c == u'-' || c == u'_' || c == u'.' || c == u'/';
+}
+
+// Scores a lowercased field against a lowercased term. Returns 0 if the term does not match.
+qint32 fieldScore(const QString& field, const QString& term) {
+	if (term.length() > field.length()) return 0;
+	if (field == term) return SCORE_EXACT;
+
+	// shorter fields are a better match for the same prefix
+	if (field.startsWith(term)) {
+		return SCORE_PREFIX + static_cast<qint32>(100 * term.length() / field.length());
+	}
+
+	auto idx = field.indexOf(term);
+	if (idx != -1) {
+		for (; idx != -1; idx = field.indexOf(term, idx + 1)) {
+			if (isWordStart(field, idx)) return SCORE_WORD;
+		}
+
+		return SCORE_SUBSTRING;
+	}
+
+	// Subsequence match, preferring consecutive characters and characters at word starts.
+	qint32 bonus = 0;
+	qsizetype fi = 0;
+	qsizetype lastMatch = -2;
+
+	for (auto c: term) {
+		while (fi != field.length() && field.at(fi) != c) fi++;
+		if (fi == field.length()) return 0;
+
+		if (fi == lastMatch + 1) bonus += 15;
+		else if (isWordStart(field, fi)) bonus += 10;
+		else bonus += 1;
+
+		lastMatch = fi;
+		fi++;
+	}
+
+	return SCORE_SUBSEQUENCE + static_cast<qint32>(bonus * 10 / term.length());
+}
+
+struct SearchTerm {
+	QString text;
+	quint64 mask = 0;
+	qint32 trigramCount = 0;
+	// number of the term's trigrams found in each record, only filled if trigramCount != 0
+	QVector<qint32> overlap;
+};
+
+} // namespace
+
+void DesktopSearchIndexData::insert(DesktopSearchRecord record) {
+	auto trigrams = QSet<quint64>();
+	record.charMask = 0;
+
+	for (const auto& field: record.fields) {
+		record.charMask |= charMask(field);
+		collectTrigrams(field, trigrams);
+	}
+
+	auto recordIndex = static_cast<qint32>(this->records.size());
+	for (auto trigram: trigrams) {
+		this->trigrams[trigram].push_back(recordIndex);
+	}
+
+	this->records.push_back(std::move(record));
+}
+
+DesktopSearchIndex::DesktopSearchIndex() {
+	QObject::connect(
+	    DesktopEntryManager::instance(),
+	    &DesktopEntryManager::entriesChanged,
+	    this,
+	    &DesktopSearchIndex::rebuild
+	);
+
+	this->rebuild();
+}
+
+DesktopSearchIndex* DesktopSearchIndex::instance() {
+	static auto* instance = new DesktopSearchIndex(); // NOLINT
+	return instance;
+}
+
+void DesktopSearchIndex::rebuild() {
+	auto index = QSharedPointer<DesktopSearchIndexData>::create();
+	const auto& applications = DesktopEntryManager::instance()->applications()->valueList();
+	index->records.reserve(applications.size());
+
+	for (auto* entry: applications) {
+		auto record = DesktopSearchRecord();
+		record.entry = entry;
+		record.fields[DesktopSearchRecord::Name] = entry->mName.toLower();
+		record.fields[DesktopSearchRecord::GenericName] = entry->mGenericName.toLower();
+		record.fields[DesktopSearchRecord::Keywords] = entry->mKeywords.join(u' ').toLower();
+		record.fields[DesktopSearchRecord::Categories] = entry->mCategories.join(u' ').toLower();
+		index->insert(std::move(record));
+	}
+
+	qCDebug(logDesktopSearch) << "Rebuilt desktop entry search index with" << index->records.size()
+	                          << "entries and" << index->trigrams.size() << "trigrams";
+
+	this->mIndex = index;
+	emit this->indexChanged();
+}
+
+DesktopSearchOperation::DesktopSearchOperation(
+    QSharedPointer<const DesktopSearchIndexData> index,
+    QString query,
+    qsizetype limit
+)
+    : index(std::move(index))
+    , query(std::move(query))
+    , limit(limit) {
+	this->setAutoDelete(false);
+}
+
+void DesktopSearchOperation::run() {
+	if (!this->shouldCancel.loadAcquire()) {
+		this->results =
+		    DesktopSearchOperation::search(*this->index, this->query, this->limit, this->shouldCancel);
+	}
+
+	QMetaObject::invokeMethod(this, &DesktopSearchOperation::finished, Qt::QueuedConnection);
+}
+
+void DesktopSearchOperation::tryCancel() { this->shouldCancel.storeRelease(true); }
+
+void DesktopSearchOperation::finished() {
+	if (!this->shouldCancel.loadAcquire()) emit this->done(this->index, this->results);
+	this->deleteLater();
+}
+
+QVector<qint32> DesktopSearchOperation::search(
+    const DesktopSearchIndexData& index,
+    const QString& query,
+    qsizetype limit,
+    const QAtomicInteger<bool>& shouldCancel
+) {
+	const auto& records = index.records;
+	auto terms = QVector<SearchTerm>();
+
+	for (auto& text: query.toLower().split(u' ', Qt::SkipEmptyParts)) {
+		auto term = SearchTerm();
+		term.mask = charMask(text);
+
+		// Typo tolerance: records sharing at least half of a term's trigrams match weakly
+		// even if the term is not a subsequence of any field.
+		if (text.length() >= 3) {
+			auto trigrams = QSet<quint64>();
+			collectTrigrams(text, trigrams);
+			term.trigramCount = static_cast<qint32>(trigrams.size());
+			term.overlap.resize(records.size());
+
+			for (auto trigram: trigrams) {
+				for (auto recordIndex: index.trigrams.value(trigram)) {
+					term.overlap[recordIndex]++;
+				}
+			}
+		}
+
+		term.text = std::move(text);
+		terms.push_back(std::move(term));
+	}
+
+	// (score, record index)
+	auto matches = QVector<QPair<qint32, qint32>>();
+
+	for (qint32 i = 0; i != records.size(); i++) {
+		if ((i & 127) == 0 && shouldCancel.loadRelaxed()) return {};
+
+		const auto& record = records.at(i);
+		qint32 total = 0;
+
+		for (const auto& term: terms) {
+			qint32 best = 0;
+
+			// a term can only be a subsequence of a field if the record contains all its characters
+			if ((record.charMask & term.mask) == term.mask) {
+				for (auto f = 0; f != DesktopSearchRecord::FieldCount; f++) {
+					auto score = fieldScore(record.fields.at(f), term.text);
+					best = std::max(best, score * FIELD_WEIGHTS.at(f) / 100);
+				}
+			}
+
+			if (best == 0 && term.trigramCount != 0) {
+				auto overlap = term.overlap.at(i);
+
+				if (overlap * 2 >= term.trigramCount) {
+					best = SCORE_TRIGRAM + 30 * overlap / term.trigramCount;
+				}
+			}
+
+			if (best == 0) {
+				total = 0;
+				break;
+			}
+
+			total += best;
+		}
+
+		if (terms.isEmpty() || total != 0) matches.push_back(qMakePair(total, i));
+	}
+
+	auto compare = [&records](const QPair<qint32, qint32>& a, const QPair<qint32, qint32>& b) {
+		if (a.first != b.first) return a.first > b.first;
+
+		const auto& aName = records.at(a.second).fields.at(DesktopSearchRecord::Name);
+		const auto& bName = records.at(b.second).fields.at(DesktopSearchRecord::Name);
+		if (aName != bName) return aName < bName;
+
+		return a.second < b.second;
+	};
+
+	if (limit > 0 && matches.size() > limit) {
+		std::partial_sort(matches.begin(), matches.begin() + limit, matches.end(), compare);
+		matches.resize(limit);
+	} else {
+		std::ranges::sort(matches, compare);
+	}
+
+	auto results = QVector<qint32>();
+	results.reserve(matches.size());
+	for (const auto& [_, recordIndex]: matches) {
+		results.push_back(recordIndex);
+	}
+
+	return results;
+}
+
+DesktopEntrySearch::DesktopEntrySearch(QObject* parent): QObject(parent) {
+	QObject::connect(
+	    DesktopSearchIndex::instance(),
+	    &DesktopSearchIndex::indexChanged,
+	    this,
+	    &DesktopEntrySearch::onIndexChanged
+	);
+}
+
+DesktopEntrySearch::~DesktopEntrySearch() { this->cancelAsync(); }
+
+void DesktopEntrySearch::componentComplete() {
+	this->componentCompleted = true;
+	this->searchAsync();
+}
+
+void DesktopEntrySearch::setQuery(const QString& query) {
+	if (query == this->mQuery) return;
+	this->mQuery = query;
+	emit this->queryChanged();
+
+	this->searchAsync();
+}
+
+void DesktopEntrySearch::setLimit(qsizetype limit) {
+	if (limit == this->mLimit) return;
+	this->mLimit = limit;
+	emit this->limitChanged();
+
+	this->searchAsync();
+}
+
+void DesktopEntrySearch::onIndexChanged() {
+	// Entries missing from the new index are about to be destroyed and must not be
+	// exposed until the search completes.
+	auto index = DesktopSearchIndex::instance()->index();
+
+	auto live = QSet<DesktopEntry*>();
+	for (const auto& record: index->records) {
+		live.insert(record.entry.data());
+	}
+
+	auto kept = QVector<DesktopEntry*>();
+	for (auto* entry: this->mResults.valueList()) {
+		if (live.contains(entry)) kept.push_back(entry);
+	}
+
+	if (kept.size() != this->mResults.valueList().size()) this->mResults.diffUpdate(kept);
+
+	this->searchAsync();
+}
+
+void DesktopEntrySearch::operationFinished(
+    const QSharedPointer<const DesktopSearchIndexData>& index,
+    const QVector<qint32>& results
+) {
+	this->liveOperation = nullptr;
+
+	auto entries = QVector<DesktopEntry*>();
+	entries.reserve(results.size());
+
+	for (auto recordIndex: results) {
+		if (auto* entry = index->records.at(recordIndex).entry.data()) entries.push_back(entry);
+	}
+
+	this->mResults.diffUpdate(entries);
+	emit this->searchingChanged();
+}
+
+void DesktopEntrySearch::searchAsync() {
+	if (!this->componentCompleted) return;
+
+	auto wasSearching = this->liveOperation != nullptr;
+	this->cancelAsync();
+
+	this->liveOperation = new DesktopSearchOperation(
+	    DesktopSearchIndex::instance()->index(),
+	    this->mQuery,
+	    this->mLimit
+	);
+
+	QObject::connect(
+	    this->liveOperation,
+	    &DesktopSearchOperation::done,
+	    this,
+	    &DesktopEntrySearch::operationFinished
+	);
+
+	QThreadPool::globalInstance()->start(this->liveOperation);
+
+	if (!wasSearching) emit this->searchingChanged();
+}
+
+void DesktopEntrySearch::cancelAsync() {
+	if (!this->liveOperation) return;
+
+	// the operation deletes itself once the worker finishes
+	this->liveOperation->tryCancel();
+	QObject::disconnect(this->liveOperation, nullptr, this, nullptr);
+	this->liveOperation = nullptr;
+}
@@ -0,0 +1,177 @@
+#pragma once
+
+#include <array>
+
+#include <qatomic.h>
+#include <qcontainerfwd.h>
+#include <qhash.h>
+#include <qobject.h>
+#include <qpointer.h>
+#include <qqmlintegration.h>
+#include <qqmlparserstatus.h>
+#include <qrunnable.h>
+#include <qsharedpointer.h>
+#include <qtmetamacros.h>
+#include <qtypes.h>
+
+#include "desktopentry.hpp"
+#include "doc.hpp"
+#include "model.hpp"
+
+struct DesktopSearchRecord {
+	enum Field : quint8 { Name = 0, GenericName, Keywords, Categories, FieldCount };
+
+	QPointer<DesktopEntry> entry;
+	// lowercased fields, keywords and categories are joined with spaces
+	std::array<QString, FieldCount> fields;
+	// bit n is set if a character with a code point equal to n mod 64 occurs in any field
+	quint64 charMask = 0;
+};
+
+// Immutable once built, shared with search operations running on worker threads.
+struct DesktopSearchIndexData {
+	QVector<DesktopSearchRecord> records;
+	// trigram of lowercased field text -> sorted indices of records containing it
+	QHash<quint64, QVector<qint32>> trigrams;
+
+	// Appends a record with lowercased fields, filling its char mask and the trigram table.
+	void insert(DesktopSearchRecord record);
+};
+
+// Search index over all displayed applications, rebuilt whenever desktop entries change.
+class DesktopSearchIndex: public QObject {
+	Q_OBJECT;
+
+public:
+	[[nodiscard]] QSharedPointer<const DesktopSearchIndexData> index() const { return this->mIndex; }
+
+	static DesktopSearchIndex* instance();
+
+signals:
+	void indexChanged();
+
+private slots:
+	void rebuild();
+
+private:
+	explicit DesktopSearchIndex();
+
+	QSharedPointer<const DesktopSearchIndexData> mIndex;
+};
+
+class DesktopSearchOperation
+    : public QObject
+    , public QRunnable {
+	Q_OBJECT;
+
+public:
+	explicit DesktopSearchOperation(
+	    QSharedPointer<const DesktopSearchIndexData> index,
+	    QString query,
+	    qsizetype limit
+	);
+
+	void run() override;
+	void tryCancel();
+
+	// Scores every record of the index against the query and returns matching record
+	// indices, best first. Returns early with an incomplete result if shouldCancel is set.
+	static QVector<qint32> search(
+	    const DesktopSearchIndexData& index,
+	    const QString& query,
+	    qsizetype limit,
+	    const QAtomicInteger<bool>& shouldCancel = false
+	);
+
+signals:
+	void done(QSharedPointer<const DesktopSearchIndexData> index, QVector<qint32> results);
+
+private slots:
+	void finished();
+
+private:
+	QAtomicInteger<bool> shouldCancel = false;
+	QSharedPointer<const DesktopSearchIndexData> index;
+	QString query;
+	qsizetype limit;
+	QVector<qint32> results;
+};
+
+///! Ranked search over desktop entries.
+/// Fuzzy search over the @@DesktopEntries.applications list, matching against the name,
+/// generic name, keywords and categories of each entry.
+///
+/// Queries are run against a precomputed index on a background thread, and results are
+/// updated in place as the query changes, so views using @@results only change the
+/// delegates of entries that entered or left the result set.
+///
+/// #### Example
+/// ```qml
+/// DesktopEntrySearch {
+///   id: search
+///   query: searchField.text
+///   limit: 50
+/// }
+///
+/// ListView {
+///   model: search.results
+///   delegate: Text { required property DesktopEntry modelData; text: modelData.name }
+/// }
+/// ```
+class DesktopEntrySearch
+    : public QObject
+    , public QQmlParserStatus {
+	Q_OBJECT;
+	Q_INTERFACES(QQmlParserStatus);
+	/// The search query. Whitespace separated terms must all match an entry.
+	/// If empty, all applications are returned, sorted by name.
+	Q_PROPERTY(QString query READ query WRITE setQuery NOTIFY queryChanged);
+	/// The maximum number of results. Defaults to 0, which does not limit results.
+	Q_PROPERTY(qsizetype limit READ limit WRITE setLimit NOTIFY limitChanged);
+	/// Matching entries, best match first.
+	QSDOC_TYPE_OVERRIDE(ObjectModel<DesktopEntry>*);
+	Q_PROPERTY(UntypedObjectModel* results READ results CONSTANT);
+	/// If a search is currently running. @@results holds the results of the previous query
+	/// while searching.
+	Q_PROPERTY(bool searching READ searching NOTIFY searchingChanged);
+	QML_ELEMENT;
+
+public:
+	explicit DesktopEntrySearch(QObject* parent = nullptr);
+	~DesktopEntrySearch() override;
+	Q_DISABLE_COPY_MOVE(DesktopEntrySearch);
+
+	void classBegin() override {}
+	void componentComplete() override;
+
+	[[nodiscard]] QString query() const { return this->mQuery; }
+	void setQuery(const QString& query);
+
+	[[nodiscard]] qsizetype limit() const { return this->mLimit; }
+	void setLimit(qsizetype limit);
+
+	[[nodiscard]] ObjectModel<DesktopEntry>* results() { return &this->mResults; }
+	[[nodiscard]] bool searching() const { return this->liveOperation != nullptr; }
+
+signals:
+	void queryChanged();
+	void limitChanged();
+	void searchingChanged();
+
+private slots:
+	void onIndexChanged();
+	void operationFinished(
+	    const QSharedPointer<const DesktopSearchIndexData>& index,
+	    const QVector<qint32>& results
+	);
+
+private:
+	void searchAsync();
+	void cancelAsync();
+
+	bool componentCompleted = false;
+	QString mQuery;
+	qsizetype mLimit = 0;
+	ObjectModel<DesktopEntry> mResults {this};
+	DesktopSearchOperation* liveOperation = nullptr;
+};
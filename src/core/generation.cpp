@@ -14,6 +14,7 @@
 #include <qqmlcontext.h>
 #include <qqmlengine.h>
 #include <qqmlincubator.h>
+#include <qquickwindow.h>
 #include <qtmetamacros.h>
 
 #include "iconimageprovider.hpp"
@@ -36,10 +37,11 @@ EngineGeneration::EngineGeneration(const QDir& rootPath, QmlScanner scanner)
 
 	this->engine->addUrlInterceptor(&this->urlInterceptor);
 	this->engine->setNetworkAccessManagerFactory(&this->interceptNetFactory);
-	this->engine->setIncubationController(&this->delayedIncubationController);
+	this->engine->setIncubationController(&this->incubationController);
 
 	this->engine->addImageProvider("icon", new IconImageProvider());
 	this->engine->addImageProvider("qsimage", new QsImageProvider());
+	this->engine->addImageProvider("qsimageasync", new QsAsyncImageProvider());
 	this->engine->addImageProvider("qspixmap", new QsPixmapProvider());
 
 	QsEnginePlugin::runConstructGeneration(*this);
@@ -115,11 +117,10 @@ void EngineGeneration::shutdown() {
 
 void EngineGeneration::onReload(EngineGeneration* old) {
 	if (old != nullptr) {
-		// if the old generation holds the window incubation controller as the
-		// new generation acquires it then incubators will hang intermittently
-		qCDebug(logIncubator) << "Locking incubation controllers of old generation" << old;
-		old->incubationControllersLocked = true;
-		old->assignIncubationController();
+		// Windows are handed over to the new generation, and the old generation's remaining
+		// incubators would compete with the new one's for the same frames.
+		qCDebug(logIncubator) << "Pausing incubation of old generation" << old;
+		old->incubationController.setPaused(true);
 	}
 
 	QObject::connect(this->engine, &QQmlEngine::quit, this, &EngineGeneration::quit);
@@ -200,93 +201,12 @@ void EngineGeneration::onDirectoryChanged() {
 	}
 }
 
-void EngineGeneration::registerIncubationController(QQmlIncubationController* controller) {
-	// We only want controllers that we can swap out if destroyed.
-	// This happens if the window owning the active controller dies.
-	if (auto* obj = dynamic_cast<QObject*>(controller)) {
-		QObject::connect(
-		    obj,
-		    &QObject::destroyed,
-		    this,
-		    &EngineGeneration::incubationControllerDestroyed
-		);
-	} else {
-		qCWarning(logIncubator) << "Could not register incubation controller as it is not a QObject"
-		                        << controller;
-
-		return;
-	}
-
-	this->incubationControllers.push_back(controller);
-	qCDebug(logIncubator) << "Registered incubation controller" << controller << "to generation"
-	                      << this;
-
-	// This function can run during destruction.
-	if (this->engine == nullptr) return;
-
-	if (this->engine->incubationController() == &this->delayedIncubationController) {
-		this->assignIncubationController();
-	}
-}
-
-void EngineGeneration::deregisterIncubationController(QQmlIncubationController* controller) {
-	if (auto* obj = dynamic_cast<QObject*>(controller)) {
-		QObject::disconnect(obj, nullptr, this, nullptr);
-	} else {
-		qCCritical(logIncubator) << "Deregistering incubation controller which is not a QObject, "
-		                            "however only QObject controllers should be registered.";
-	}
-
-	if (!this->incubationControllers.removeOne(controller)) {
-		qCCritical(logIncubator) << "Failed to deregister incubation controller" << controller << "from"
-		                         << this << "as it was not registered to begin with";
-		qCCritical(logIncubator) << "Current registered incuabation controllers"
-		                         << this->incubationControllers;
-	} else {
-		qCDebug(logIncubator) << "Deregistered incubation controller" << controller << "from" << this;
-	}
-
-	// This function can run during destruction.
-	if (this->engine == nullptr) return;
-
-	if (this->engine->incubationController() == controller) {
-		qCDebug(logIncubator
-		) << "Destroyed incubation controller was currently active, reassigning from pool";
-		this->assignIncubationController();
-	}
+void EngineGeneration::registerIncubationWindow(QQuickWindow* window) {
+	this->incubationController.addWindow(window);
 }
 
-void EngineGeneration::incubationControllerDestroyed() {
-	auto* sender = this->sender();
-	auto* controller = dynamic_cast<QQmlIncubationController*>(sender);
-
-	if (controller == nullptr) {
-		qCCritical(logIncubator) << "Destroyed incubation controller" << sender << "is not known to"
-		                         << this << ", this may cause memory corruption";
-		qCCritical(logIncubator) << "Current registered incuabation controllers"
-		                         << this->incubationControllers;
-
-		return;
-	}
-
-	if (this->incubationControllers.removeOne(controller)) {
-		qCDebug(logIncubator) << "Destroyed incubation controller" << controller << "deregistered from"
-		                      << this;
-	} else {
-		qCCritical(logIncubator) << "Destroyed incubation controller" << controller
-		                         << "was not registered, but its destruction was observed by" << this;
-
-		return;
-	}
-
-	// This function can run during destruction.
-	if (this->engine == nullptr) return;
-
-	if (this->engine->incubationController() == controller) {
-		qCDebug(logIncubator
-		) << "Destroyed incubation controller was currently active, reassigning from pool";
-		this->assignIncubationController();
-	}
+void EngineGeneration::deregisterIncubationWindow(QQuickWindow* window) {
+	this->incubationController.removeWindow(window);
 }
 
 void EngineGeneration::registerExtension(const void* key, EngineGenerationExt* extension) {
@@ -312,22 +232,6 @@ void EngineGeneration::exit(int code) {
 	this->destroy();
 }
 
-void EngineGeneration::assignIncubationController() {
-	QQmlIncubationController* controller = nullptr;
-
-	if (this->incubationControllersLocked || this->incubationControllers.isEmpty()) {
-		controller = &this->delayedIncubationController;
-	} else {
-		controller = this->incubationControllers.first();
-	}
-
-	qCDebug(logIncubator) << "Assigning incubation controller" << controller << "to generation"
-	                      << this
-	                      << "fallback:" << (controller == &this->delayedIncubationController);
-
-	this->engine->setIncubationController(controller);
-}
-
 EngineGeneration* EngineGeneration::currentGeneration() {
 	if (g_generations.size() == 1) {
 		return *g_generations.begin();
@@ -7,6 +7,7 @@
 #include <qobject.h>
 #include <qqmlengine.h>
 #include <qqmlincubator.h>
+#include <qquickwindow.h>
 #include <qtclasshelpermacros.h>
 
 #include "incubator.hpp"
@@ -36,8 +37,9 @@ public:
 	void onReload(EngineGeneration* old);
 	void setWatchingFiles(bool watching);
 
-	void registerIncubationController(QQmlIncubationController* controller);
-	void deregisterIncubationController(QQmlIncubationController* controller);
+	// Windows whose frames drive asynchronous incubation.
+	void registerIncubationWindow(QQuickWindow* window);
+	void deregisterIncubationWindow(QQuickWindow* window);
 
 	// takes ownership
 	void registerExtension(const void* key, EngineGenerationExt* extension);
@@ -60,7 +62,7 @@ public:
 	SingletonRegistry singletonRegistry;
 	QFileSystemWatcher* watcher = nullptr;
 	QVector<QString> deletedWatchedFiles;
-	DelayedQmlIncubationController delayedIncubationController;
+	QsIncubationController incubationController;
 	bool reloadComplete = false;
 	QuickshellGlobal* qsgInstance = nullptr;
 
@@ -78,13 +80,9 @@ public slots:
 private slots:
 	void onFileChanged(const QString& name);
 	void onDirectoryChanged();
-	void incubationControllerDestroyed();
 
 private:
 	void postReload();
-	void assignIncubationController();
-	QVector<QQmlIncubationController*> incubationControllers;
-	bool incubationControllersLocked = false;
 	QHash<const void*, EngineGenerationExt*> extensions;
 
 	bool destroying = false;
@@ -5,6 +5,7 @@
 #include <qimage.h>
 #include <qlogging.h>
 #include <qmap.h>
+#include <qmutex.h>
 #include <qobject.h>
 #include <qpixmap.h>
 #include <qqmlengine.h>
@@ -13,6 +14,9 @@
 namespace {
 
 namespace {
+// Async handles are looked up from the pixmap reader thread. The lock only covers
+// the lookup and copying the request, never the request itself.
+QMutex liveImagesMutex;                   // NOLINT
 QMap<QString, QsImageHandle*> liveImages; // NOLINT
 quint32 handleIndex = 0;                  // NOLINT
 } // namespace
@@ -27,20 +31,34 @@ void parseReq(const QString& req, QString& target, QString& param) {
 	}
 }
 
+QsImageHandle* findHandle(const QString& target) {
+	auto locker = QMutexLocker(&liveImagesMutex);
+	return liveImages.value(target);
+}
+
 } // namespace
 
-QsImageHandle::QsImageHandle(QQmlImageProviderBase::ImageType type)
+QsImageHandle::QsImageHandle(QQmlImageProviderBase::ImageType type, bool async)
     : type(type)
-    , id(QString::number(++handleIndex)) {
+    , async(async) {
+	auto locker = QMutexLocker(&liveImagesMutex);
+	this->id = QString::number(++handleIndex);
 	liveImages.insert(this->id, this);
 }
 
-QsImageHandle::~QsImageHandle() { liveImages.remove(this->id); }
+QsImageHandle::~QsImageHandle() {
+	auto locker = QMutexLocker(&liveImagesMutex);
+	liveImages.remove(this->id);
+}
 
 QString QsImageHandle::url() const {
 	QString url = "image://";
-	if (this->type == QQmlImageProviderBase::Image) url += "qsimage";
-	else if (this->type == QQmlImageProviderBase::Pixmap) url += "qspixmap";
+	if (this->type == QQmlImageProviderBase::Image) {
+		url += this->async ? "qsimageasync" : "qsimage";
+	} else if (this->type == QQmlImageProviderBase::Pixmap) {
+		url += "qspixmap";
+	}
+
 	url += "/" + this->id;
 	return url;
 }
@@ -57,12 +75,17 @@ QPixmap QsImageHandle::
 	return QPixmap();
 }
 
+QsImageHandle::AsyncImageRequest QsImageHandle::asyncImageRequest() const {
+	qWarning() << "Image handle" << this << "does not provide async QImages";
+	return nullptr;
+}
+
 QImage QsImageProvider::requestImage(const QString& id, QSize* size, const QSize& requestedSize) {
 	QString target;
 	QString param;
 	parseReq(id, target, param);
 
-	auto* handle = liveImages.value(target);
+	auto* handle = findHandle(target);
 	if (handle != nullptr) {
 		return handle->requestImage(param, size, requestedSize);
 	} else {
@@ -71,13 +94,37 @@ QImage QsImageProvider::requestImage(const QString& id, QSize* size, const QSize
 	}
 }
 
+QImage
+QsAsyncImageProvider::requestImage(const QString& id, QSize* size, const QSize& requestedSize) {
+	QString target;
+	QString param;
+	parseReq(id, target, param);
+
+	auto request = QsImageHandle::AsyncImageRequest();
+
+	{
+		auto locker = QMutexLocker(&liveImagesMutex);
+		auto* handle = liveImages.value(target);
+
+		if (handle == nullptr) {
+			qWarning() << "Requested image from unknown handle" << id;
+			return QImage();
+		}
+
+		request = handle->asyncImageRequest();
+	}
+
+	if (!request) return QImage();
+	return request(param, size, requestedSize);
+}
+
 QPixmap
 QsPixmapProvider::requestPixmap(const QString& id, QSize* size, const QSize& requestedSize) {
 	QString target;
 	QString param;
 	parseReq(id, target, param);
 
-	auto* handle = liveImages.value(target);
+	auto* handle = findHandle(target);
 	if (handle != nullptr) {
 		return handle->requestPixmap(param, size, requestedSize);
 	} else {
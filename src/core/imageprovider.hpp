@@ -1,5 +1,7 @@
 #pragma once
 
+#include <functional>
+
 #include <qimage.h>
 #include <qmap.h>
 #include <qobject.h>
@@ -14,6 +16,18 @@ public:
 	QImage requestImage(const QString& id, QSize* size, const QSize& requestedSize) override;
 };
 
+// Serves handles created with async set on the pixmap reader thread,
+// through QsImageHandle::asyncImageRequest.
+class QsAsyncImageProvider: public QQuickImageProvider {
+public:
+	explicit QsAsyncImageProvider()
+	    : QQuickImageProvider(
+	          QQuickImageProvider::Image,
+	          QQuickImageProvider::ForceAsynchronousImageLoading
+	      ) {}
+	QImage requestImage(const QString& id, QSize* size, const QSize& requestedSize) override;
+};
+
 class QsPixmapProvider: public QQuickImageProvider {
 public:
 	explicit QsPixmapProvider(): QQuickImageProvider(QQuickImageProvider::Pixmap) {}
@@ -22,7 +36,11 @@ public:
 
 class QsImageHandle {
 public:
-	explicit QsImageHandle(QQmlImageProviderBase::ImageType type);
+	using AsyncImageRequest =
+	    std::function<QImage(const QString& id, QSize* size, const QSize& requestedSize)>;
+
+	// Async image handles are requested on the pixmap reader thread.
+	explicit QsImageHandle(QQmlImageProviderBase::ImageType type, bool async = false);
 	virtual ~QsImageHandle();
 	Q_DISABLE_COPY_MOVE(QsImageHandle);
 
@@ -31,14 +49,21 @@ public:
 	virtual QImage requestImage(const QString& id, QSize* size, const QSize& requestedSize);
 	virtual QPixmap requestPixmap(const QString& id, QSize* size, const QSize& requestedSize);
 
+	// Returns a request to run on the pixmap reader thread for async handles.
+	// Called with the handle registry locked, so it should only copy the state it needs.
+	// The handle may be destroyed before the request runs and must not be captured.
+	[[nodiscard]] virtual AsyncImageRequest asyncImageRequest() const;
+
 private:
 	QQmlImageProviderBase::ImageType type;
+	bool async;
 	QString id;
 };
 
 class QsIndexedImageHandle: public QsImageHandle {
 public:
-	explicit QsIndexedImageHandle(QQmlImageProviderBase::ImageType type): QsImageHandle(type) {}
+	explicit QsIndexedImageHandle(QQmlImageProviderBase::ImageType type, bool async = false)
+	    : QsImageHandle(type, async) {}
 
 	[[nodiscard]] QString url() const override;
 	void imageChanged();
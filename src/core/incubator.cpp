@@ -1,16 +1,194 @@
 #include "incubator.hpp"
+#include <algorithm>
 
+#include <qelapsedtimer.h>
+#include <qguiapplication.h>
 #include <qlogging.h>
 #include <qloggingcategory.h>
+#include <qnamespace.h>
+#include <qobject.h>
+#include <qpointer.h>
 #include <qqmlincubator.h>
+#include <qquickwindow.h>
+#include <qscreen.h>
 #include <qtmetamacros.h>
+#include <qtypes.h>
+
+#include "qmlglobal.hpp"
 
 Q_LOGGING_CATEGORY(logIncubator, "quickshell.incubator", QtWarningMsg);
 
+namespace {
+
+qint64 frameIntervalNs() {
+	auto* screen = QGuiApplication::primaryScreen();
+	auto rate = screen == nullptr ? 0 : screen->refreshRate();
+	if (rate <= 0) rate = 60;
+	return static_cast<qint64>(1'000'000'000 / rate);
+}
+
+} // namespace
+
 void QsQmlIncubator::statusChanged(QQmlIncubator::Status status) {
 	switch (status) {
 	case QQmlIncubator::Ready: emit this->completed(); break;
 	case QQmlIncubator::Error: emit this->failed(); break;
+	case QQmlIncubator::Null: emit this->cancelled(); break;
 	default: break;
 	}
 }
+
+qint64 IncubationBudget::remaining(qint64 nowNs, qint64 intervalNs, qint64 budgetNs) {
+	if (this->periodStartNs == -1) {
+		this->periodStartNs = nowNs;
+	} else if (auto elapsed = nowNs - this->periodStartNs; elapsed >= intervalNs) {
+		auto periods = elapsed / intervalNs;
+		this->periodSpentNs = std::max(this->periodSpentNs - periods * budgetNs, qint64(0));
+		this->periodStartNs += periods * intervalNs;
+	}
+
+	return budgetNs - this->periodSpentNs;
+}
+
+void IncubationBudget::spend(qint64 spentNs) {
+	this->periodSpentNs += spentNs;
+	this->totalSpentNs += spentNs;
+}
+
+QsIncubationController::QsIncubationController(QObject* parent): QObject(parent) {
+	this->fallbackTimer.setSingleShot(true);
+	this->clock.start();
+
+	QObject::connect(&this->fallbackTimer, &QTimer::timeout, this, &QsIncubationController::onFrame);
+}
+
+void QsIncubationController::addWindow(QQuickWindow* window) {
+	if (this->windows.contains(window)) return;
+	this->windows.push_back(window);
+
+	// frameSwapped is emitted from the render thread when using the threaded render loop
+	// clang-format off
+	QObject::connect(window, &QQuickWindow::frameSwapped, this, &QsIncubationController::onFrame, Qt::QueuedConnection);
+	QObject::connect(window, &QObject::destroyed, this, &QsIncubationController::onWindowDestroyed);
+	// clang-format on
+
+	qCDebug(logIncubator) << "Added window" << window << "to incubation controller" << this;
+
+	if (this->windows.length() == 1 && this->incubatingObjectCount() != 0) this->requestFrame();
+}
+
+void QsIncubationController::removeWindow(QQuickWindow* window) {
+	if (!this->windows.removeOne(window)) return;
+	QObject::disconnect(window, nullptr, this, nullptr);
+	qCDebug(logIncubator) << "Removed window" << window << "from incubation controller" << this;
+}
+
+void QsIncubationController::onWindowDestroyed() {
+	this->windows.removeOne(static_cast<QQuickWindow*>(this->sender())); // NOLINT
+}
+
+void QsIncubationController::setPaused(bool paused) {
+	if (paused == this->paused) return;
+	this->paused = paused;
+
+	if (paused) this->fallbackTimer.stop();
+	else if (this->incubatingObjectCount() != 0) this->requestFrame();
+}
+
+void QsIncubationController::addIdleIncubator(QsQmlIncubator* incubator) {
+	this->idleIncubators.push_back(incubator);
+}
+
+void QsIncubationController::pruneIdleIncubators() {
+	this->idleIncubators.removeIf([](const QPointer<QsQmlIncubator>& incubator) {
+		return incubator == nullptr || incubator->status() != QQmlIncubator::Loading;
+	});
+
+	// nested incubators finish before the incubators that created them
+	if (this->idleIncubators.isEmpty()) this->idleNestedCount = 0;
+}
+
+bool QsIncubationController::hasForegroundWork() {
+	this->pruneIdleIncubators();
+	auto idleCount = this->idleIncubators.length() + this->idleNestedCount;
+	return this->incubatingObjectCount() > idleCount;
+}
+
+void QsIncubationController::cancelIdleWork() {
+	// clearing calls back into the incubator's owner
+	const auto incubators = this->idleIncubators;
+	this->idleIncubators.clear();
+	this->idleNestedCount = 0;
+
+	for (const auto& incubator: incubators) {
+		if (incubator != nullptr && incubator->status() == QQmlIncubator::Loading) {
+			qCDebug(logIncubator) << "Cancelling idle incubator" << incubator << "for other work";
+			incubator->clear();
+		}
+	}
+}
+
+qreal QsIncubationController::incubationTime() const {
+	return static_cast<qreal>(this->budget.totalSpent()) / 1'000'000;
+}
+
+void QsIncubationController::incubatingObjectCountChanged(int count) {
+	if (count != 0) this->requestFrame();
+	emit this->incubationChanged();
+}
+
+void QsIncubationController::requestFrame() {
+	if (this->paused || this->windows.isEmpty()) return;
+
+	for (auto* window: this->windows) {
+		if (window->isVisible()) {
+			window->update();
+			break;
+		}
+	}
+
+	// restarted by every frame, so it only fires if no window renders
+	this->fallbackTimer.start(static_cast<qint32>(2 * frameIntervalNs() / 1'000'000));
+}
+
+void QsIncubationController::onFrame() {
+	if (this->paused || this->windows.isEmpty() || this->incubatingObjectCount() == 0) return;
+
+	auto idleOnly = !this->hasForegroundWork();
+
+	// Qt incubates in creation order, so idle work would hold back anything created after it.
+	if (!idleOnly && !this->idleIncubators.isEmpty()) this->cancelIdleWork();
+
+	auto budgetNs =
+	    static_cast<qint64>(QuickshellSettings::instance()->incubationBudget() * 1'000'000);
+
+	if (idleOnly) budgetNs /= 2;
+
+	// Frames of every window within one frame interval draw from the same budget.
+	auto remainingNs =
+	    this->budget.remaining(this->clock.nsecsElapsed(), frameIntervalNs(), budgetNs);
+
+	if (remainingNs > 0 && this->incubatingObjectCount() != 0) {
+		auto timer = QElapsedTimer();
+		timer.start();
+
+		// incubateFor only takes whole milliseconds, anything spent past the budget is taken
+		// from the next interval.
+		this->incubateFor(std::max(1, static_cast<int>(remainingNs / 1'000'000)));
+		this->budget.spend(timer.nsecsElapsed());
+
+		// anything still incubating after an idle only pass was started by idle work
+		if (idleOnly) {
+			this->pruneIdleIncubators();
+
+			if (!this->idleIncubators.isEmpty()) {
+				auto outerCount = static_cast<qint32>(this->idleIncubators.length());
+				this->idleNestedCount = std::max(this->incubatingObjectCount() - outerCount, 0);
+			}
+		}
+
+		emit this->incubationChanged();
+	}
+
+	if (this->incubatingObjectCount() != 0) this->requestFrame();
+}
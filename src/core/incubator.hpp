@@ -1,9 +1,15 @@
 #pragma once
 
+#include <qelapsedtimer.h>
+#include <qlist.h>
 #include <qloggingcategory.h>
 #include <qobject.h>
+#include <qpointer.h>
 #include <qqmlincubator.h>
+#include <qquickwindow.h>
+#include <qtimer.h>
 #include <qtmetamacros.h>
+#include <qtypes.h>
 
 Q_DECLARE_LOGGING_CATEGORY(logIncubator);
 
@@ -22,9 +28,88 @@ public:
 signals:
 	void completed();
 	void failed();
+	// Emitted when incubation is cleared before it completed.
+	void cancelled();
 };
 
-class DelayedQmlIncubationController: public QQmlIncubationController {
-	// Do nothing.
-	// This ensures lazy loaders don't start blocking before onReload creates windows.
+// Accounting for time spent incubating against a budget per frame interval.
+//
+// incubateFor only takes whole milliseconds and can't stop in the middle of an object, so
+// incubation may run past the budget. Time spent past the budget is taken from the next
+// interval, and forgiven for intervals where nothing was incubated.
+class IncubationBudget {
+public:
+	// Returns the time left in the interval containing nowNs, which may be zero or negative.
+	// Starts a new interval if the last one has ended.
+	[[nodiscard]] qint64 remaining(qint64 nowNs, qint64 intervalNs, qint64 budgetNs);
+	void spend(qint64 spentNs);
+
+	[[nodiscard]] qint64 totalSpent() const { return this->totalSpentNs; }
+
+private:
+	qint64 periodStartNs = -1;
+	qint64 periodSpentNs = 0;
+	qint64 totalSpentNs = 0;
+};
+
+// Incubation controller owned by an EngineGeneration.
+//
+// Incubation runs after frames of any registered window, queued to the gui thread so it never
+// delays the frame itself. All windows share one time budget per frame interval, so adding
+// windows does not increase the time spent. While objects are incubating one visible window
+// is asked for another frame, and a fallback timer keeps incubation going if no window renders.
+//
+// Nothing is incubated before the first window is registered, which ensures lazy loaders
+// don't start blocking before onReload creates windows.
+//
+// Incubators marked as idle work only run while nothing else is incubating. Qt incubates
+// in creation order, so idle incubators are cancelled when other work shows up instead of
+// holding it back, and their owners are expected to retry later. Incubators created while
+// only idle work was running are counted as part of it.
+class QsIncubationController
+    : public QObject
+    , public QQmlIncubationController {
+	Q_OBJECT;
+
+public:
+	explicit QsIncubationController(QObject* parent = nullptr);
+
+	void addWindow(QQuickWindow* window);
+	void removeWindow(QQuickWindow* window);
+
+	// Stops all incubation, used for generations that are being replaced.
+	void setPaused(bool paused);
+
+	// Marks an incubator as background work, which is given half of the frame budget
+	// while nothing else is incubating and cancelled otherwise.
+	void addIdleIncubator(QsQmlIncubator* incubator);
+	// If any incubators not part of background work are incubating.
+	[[nodiscard]] bool hasForegroundWork();
+
+	// Total time spent incubating in milliseconds.
+	[[nodiscard]] qreal incubationTime() const;
+
+signals:
+	void incubationChanged();
+
+protected:
+	void incubatingObjectCountChanged(int count) override;
+
+private slots:
+	void onFrame();
+	void onWindowDestroyed();
+
+private:
+	void requestFrame();
+	void pruneIdleIncubators();
+	void cancelIdleWork();
+
+	QList<QQuickWindow*> windows;
+	QList<QPointer<QsQmlIncubator>> idleIncubators;
+	// incubators created by idle incubators, which Qt counts separately
+	qint32 idleNestedCount = 0;
+	QTimer fallbackTimer;
+	QElapsedTimer clock;
+	IncubationBudget budget;
+	bool paused = false;
 };
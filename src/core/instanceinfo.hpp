@@ -32,6 +32,8 @@ namespace qs::crash {
 
 struct CrashInfo {
 	int logFd = -1;
+	// latest complete RelaunchState snapshot
+	int stateFd = -1;
 
 	static CrashInfo INSTANCE; // NOLINT
 };
@@ -1,17 +1,221 @@
 #include "lazyloader.hpp"
+#include <cerrno>
+#include <cstring>
 #include <utility>
 
+#include <fcntl.h>
+#include <private/qqmlproperty_p.h>
+#include <qcoreapplication.h>
+#include <qlist.h>
 #include <qlogging.h>
+#include <qloggingcategory.h>
+#include <qmetaobject.h>
 #include <qobject.h>
 #include <qqmlcomponent.h>
 #include <qqmlcontext.h>
 #include <qqmlengine.h>
 #include <qqmlincubator.h>
+#include <qqmlproperty.h>
+#include <qsocketnotifier.h>
+#include <qtclasshelpermacros.h>
+#include <qtimer.h>
 #include <qtmetamacros.h>
+#include <qtypes.h>
+#include <unistd.h>
 
+#include "generation.hpp"
 #include "incubator.hpp"
+#include "lazyloader_p.hpp"
 #include "reload.hpp"
 
+namespace {
+Q_LOGGING_CATEGORY(logLazyLoader, "quickshell.lazyloader", QtWarningMsg);
+
+// quiet time after the last idle priority loader is queued before preloading starts
+constexpr qint32 PRELOAD_IDLE_DELAY_MS = 1000;
+// gap between finishing one preload and starting the next
+constexpr qint32 PRELOAD_GAP_MS = 50;
+// 200ms of stalls within 2s, the smallest window unprivileged processes may use
+constexpr char PRESSURE_TRIGGER[] = "some 200000 2000000"; // NOLINT
+
+} // namespace
+
+LazyLoaderScheduler::LazyLoaderScheduler(): preloadTimer(new QTimer()) {
+	this->preloadTimer->setSingleShot(true);
+
+	QObject::connect(this->preloadTimer, &QTimer::timeout, this->preloadTimer, [this]() {
+		this->preloadNext();
+	});
+}
+
+LazyLoaderScheduler::~LazyLoaderScheduler() {
+	delete this->preloadTimer;
+	delete this->pressureNotifier;
+	if (this->pressureFd != -1) close(this->pressureFd);
+}
+
+LazyLoaderScheduler* LazyLoaderScheduler::instance() {
+	static auto* instance = new LazyLoaderScheduler(); // NOLINT
+	return instance;
+}
+
+void LazyLoaderScheduler::queuePreload(LazyLoader* loader) {
+	if (this->preloadQueue.contains(loader) || loader == this->preloading) return;
+	this->preloadQueue.push_back(loader);
+
+	// restarting keeps preloading from competing with the rest of the config loading
+	if (this->preloading == nullptr) this->preloadTimer->start(PRELOAD_IDLE_DELAY_MS);
+}
+
+void LazyLoaderScheduler::deferPreload(LazyLoader* loader) {
+	if (this->preloadQueue.contains(loader)) return;
+	this->preloadQueue.push_front(loader);
+	qCDebug(logLazyLoader) << "Deferred preloading" << loader << "for other work";
+}
+
+void LazyLoaderScheduler::preloadNext() {
+	while (!this->preloadQueue.isEmpty()) {
+		auto* loader = this->preloadQueue.first();
+
+		// let requested loads finish first
+		auto* generation = EngineGeneration::findObjectGeneration(loader);
+		if (generation != nullptr && generation->incubationController.hasForegroundWork()) {
+			this->preloadTimer->start(PRELOAD_GAP_MS);
+			return;
+		}
+
+		this->preloadQueue.removeFirst();
+		if (loader->isActive() || loader->isLoading() || loader->mComponent == nullptr) continue;
+
+		this->preloading = loader;
+
+		QObject::connect(loader, &LazyLoader::loadingChanged, this->preloadTimer, [this]() {
+			this->onPreloadLoadingChanged();
+		});
+
+		loader->setLoading(true);
+
+		if (loader->isLoading()) {
+			this->counts.preloads++;
+			qCDebug(logLazyLoader) << "Preloading" << loader;
+			return;
+		}
+
+		QObject::disconnect(loader, &LazyLoader::loadingChanged, this->preloadTimer, nullptr);
+		this->preloading = nullptr;
+	}
+}
+
+void LazyLoaderScheduler::onPreloadLoadingChanged() {
+	if (this->preloading == nullptr || this->preloading->isLoading()) return;
+
+	QObject::disconnect(this->preloading, &LazyLoader::loadingChanged, this->preloadTimer, nullptr);
+	this->preloading = nullptr;
+
+	if (!this->preloadQueue.isEmpty()) this->preloadTimer->start(PRELOAD_GAP_MS);
+}
+
+void LazyLoaderScheduler::setUnloadable(LazyLoader* loader, bool unloadable) {
+	if (!unloadable) {
+		this->unloadable.removeOne(loader);
+		return;
+	}
+
+	if (this->unloadable.contains(loader)) return;
+	this->unloadable.push_back(loader);
+	this->startPressureMonitor();
+}
+
+void LazyLoaderScheduler::removeLoader(LazyLoader* loader) {
+	this->preloadQueue.removeOne(loader);
+	this->unloadable.removeOne(loader);
+
+	if (loader == this->preloading) {
+		this->preloading = nullptr;
+
+		// loaders are also destroyed during shutdown, after the application object is gone
+		if (!this->preloadQueue.isEmpty() && QCoreApplication::instance() != nullptr) {
+			this->preloadTimer->start(PRELOAD_GAP_MS);
+		}
+	}
+}
+
+void LazyLoaderScheduler::startPressureMonitor() {
+	if (this->pressureMonitorStarted) return;
+	this->pressureMonitorStarted = true;
+
+	this->pressureFd = open("/proc/pressure/memory", O_RDWR | O_NONBLOCK | O_CLOEXEC);
+
+	if (this->pressureFd == -1) {
+		qCDebug(logLazyLoader) << "Memory pressure information is unavailable:"
+		                       << strerror(errno); // NOLINT
+		return;
+	}
+
+	if (write(this->pressureFd, PRESSURE_TRIGGER, sizeof(PRESSURE_TRIGGER)) == -1) {
+		qCWarning(logLazyLoader) << "Failed to create memory pressure trigger:"
+		                         << strerror(errno); // NOLINT
+		close(this->pressureFd);
+		this->pressureFd = -1;
+		return;
+	}
+
+	// PSI triggers report events as POLLPRI
+	this->pressureNotifier = new QSocketNotifier(this->pressureFd, QSocketNotifier::Exception);
+
+	QObject::connect(
+	    this->pressureNotifier,
+	    &QSocketNotifier::activated,
+	    this->pressureNotifier,
+	    [this]() { this->onMemoryPressure(); }
+	);
+}
+
+void LazyLoaderScheduler::onMemoryPressure() {
+	this->counts.pressureEvents++;
+
+	auto unloaded = 0;
+	// unloading may cause loaders to be destroyed
+	const auto loaders = this->unloadable;
+	for (auto* loader: loaders) {
+		if (!this->unloadable.contains(loader)) continue;
+
+		if (loader->unloadIfHidden()) {
+			this->recordUnload(loader, UnloadReason::Pressure);
+			unloaded++;
+		}
+	}
+
+	// loading more under memory pressure would only make it worse
+	auto droppedPreloads = this->preloadQueue.length();
+	this->preloadQueue.clear();
+
+	qCInfo(logLazyLoader) << "Memory pressure reported, unloaded" << unloaded
+	                      << "hidden items and skipped" << droppedPreloads << "pending preloads.";
+}
+
+void LazyLoaderScheduler::recordLoad(LazyLoader* loader) {
+	this->counts.loads++;
+
+	qCDebug(logLazyLoader).nospace() << "Loaded " << loader << " (" << this->counts.loads
+	                                 << " loads, " << this->counts.preloads << " preloads)";
+}
+
+void LazyLoaderScheduler::recordUnload(LazyLoader* loader, UnloadReason reason) {
+	auto& count = reason == UnloadReason::Timeout ? this->counts.timeoutUnloads
+	                                              : this->counts.pressureUnloads;
+	count++;
+
+	const auto* cause = reason == UnloadReason::Timeout ? "after timeout" : "under memory pressure";
+
+	qCDebug(logLazyLoader).nospace()
+	    << "Unloaded " << loader << ' ' << cause << " (" << this->counts.timeoutUnloads
+	    << " timeout unloads, " << this->counts.pressureUnloads << " pressure unloads over "
+	    << this->counts.pressureEvents << " pressure events)";
+}
+
+LazyLoader::~LazyLoader() { LazyLoaderScheduler::instance()->removeLoader(this); }
+
 void LazyLoader::onReload(QObject* oldInstance) {
 	auto* old = qobject_cast<LazyLoader*>(oldInstance);
 
@@ -28,6 +232,10 @@ void LazyLoader::onReload(QObject* oldInstance) {
 			Reloadable::reloadRecursive(this->mItem, old);
 		}
 	}
+
+	if (this->mPriority == LazyLoaderPriority::Idle) {
+		LazyLoaderScheduler::instance()->queuePreload(this);
+	}
 }
 
 QObject* LazyLoader::item() {
@@ -39,15 +247,33 @@ void LazyLoader::setItem(QObject* item) {
 	if (item == this->mItem) return;
 
 	if (this->mItem != nullptr) {
+		QObject::disconnect(this->mItem, nullptr, this, nullptr);
 		this->mItem->deleteLater();
 	}
 
 	this->mItem = item;
+	this->itemShown = false;
 
 	if (item != nullptr) {
 		item->setParent(this);
+
+		static const auto visibleSlot = LazyLoader::staticMetaObject.method(
+		    LazyLoader::staticMetaObject.indexOfSlot("onItemVisibleChanged()")
+		);
+
+		const auto* metaObject = item->metaObject();
+		auto visibleIndex = metaObject->indexOfProperty("visible");
+
+		if (visibleIndex != -1) {
+			auto visibleProp = metaObject->property(visibleIndex);
+			if (visibleProp.hasNotifySignal()) {
+				QObject::connect(item, visibleProp.notifySignal(), this, visibleSlot);
+			}
+		}
 	}
 
+	this->updateUnloadTimer();
+
 	this->targetActive = this->isActive();
 
 	emit this->itemChanged();
@@ -170,14 +396,23 @@ void LazyLoader::incubateIfReady(bool overrideReloadCheck) {
 	// clang-format off
 	QObject::connect(this->incubator, &QsQmlIncubator::completed, this, &LazyLoader::onIncubationCompleted);
 	QObject::connect(this->incubator, &QsQmlIncubator::failed, this, &LazyLoader::onIncubationFailed);
+	QObject::connect(this->incubator, &QsQmlIncubator::cancelled, this, &LazyLoader::onIncubationCancelled);
 	// clang-format on
 
+	// loads requested through loading or activeAsync are not background work
+	if (LazyLoaderScheduler::instance()->isPreloading(this)) {
+		if (auto* generation = EngineGeneration::findObjectGeneration(this)) {
+			generation->incubationController.addIdleIncubator(this->incubator);
+		}
+	}
+
 	emit this->loadingChanged();
 
 	this->mComponent->create(*this->incubator, QQmlEngine::contextForObject(this->mComponent));
 }
 
 void LazyLoader::onIncubationCompleted() {
+	LazyLoaderScheduler::instance()->recordLoad(this);
 	this->setItem(this->incubator->object());
 	// The incubator is not necessarily inert at the time of this callback,
 	// so deleteLater is required.
@@ -195,6 +430,103 @@ void LazyLoader::onIncubationFailed() {
 	}
 
 	delete this->incubator;
+	this->incubator = nullptr;
+	this->targetLoading = false;
+	emit this->loadingChanged();
+}
+
+void LazyLoader::onIncubationCancelled() {
+	if (this->incubator == nullptr) return;
+
+	// called from within the incubator
+	this->incubator->deleteLater();
+	this->incubator = nullptr;
 	this->targetLoading = false;
+
+	// preloads are cancelled by the incubation controller when other work starts
+	LazyLoaderScheduler::instance()->deferPreload(this);
 	emit this->loadingChanged();
 }
+
+LazyLoaderPriority::Enum LazyLoader::priority() const { return this->mPriority; }
+
+void LazyLoader::setPriority(LazyLoaderPriority::Enum priority) {
+	if (priority == this->mPriority) return;
+	this->mPriority = priority;
+
+	if (this->reloadComplete && priority == LazyLoaderPriority::Idle) {
+		LazyLoaderScheduler::instance()->queuePreload(this);
+	}
+
+	emit this->priorityChanged();
+}
+
+qint32 LazyLoader::unloadTimeout() const { return this->mUnloadTimeout; }
+
+void LazyLoader::setUnloadTimeout(qint32 unloadTimeout) {
+	if (unloadTimeout == this->mUnloadTimeout) return;
+	this->mUnloadTimeout = unloadTimeout;
+
+	LazyLoaderScheduler::instance()->setUnloadable(this, unloadTimeout >= 0);
+	this->updateUnloadTimer();
+
+	emit this->unloadTimeoutChanged();
+}
+
+bool LazyLoader::isItemHidden() const {
+	if (this->mItem == nullptr) return false;
+	auto visible = this->mItem->property("visible");
+	return visible.isValid() && !visible.toBool();
+}
+
+bool LazyLoader::hasLoadBinding() {
+	for (const auto* name: {"active", "activeAsync", "loading"}) {
+		if (QQmlPropertyPrivate::binding(QQmlProperty(this, name)) != nullptr) return true;
+	}
+
+	return false;
+}
+
+void LazyLoader::updateUnloadTimer() {
+	if (this->mItem != nullptr && !this->isItemHidden()) this->itemShown = true;
+
+	// Items that have never been shown are kept, otherwise preloaded items would be dropped
+	// before they are ever used.
+	if (this->mUnloadTimeout < 0 || !this->itemShown || !this->isItemHidden()) {
+		if (this->unloadTimer != nullptr) this->unloadTimer->stop();
+		return;
+	}
+
+	if (this->unloadTimer == nullptr) {
+		this->unloadTimer = new QTimer(this);
+		this->unloadTimer->setSingleShot(true);
+		QObject::connect(this->unloadTimer, &QTimer::timeout, this, &LazyLoader::onUnloadTimeout);
+	}
+
+	this->unloadTimer->start(this->mUnloadTimeout);
+}
+
+void LazyLoader::onItemVisibleChanged() { this->updateUnloadTimer(); }
+
+void LazyLoader::onUnloadTimeout() {
+	if (this->unloadIfHidden()) {
+		LazyLoaderScheduler::instance()->recordUnload(
+		    this,
+		    LazyLoaderScheduler::UnloadReason::Timeout
+		);
+	}
+}
+
+bool LazyLoader::unloadIfHidden() {
+	if (this->isLoading() || !this->isItemHidden()) return false;
+
+	// Unloading writes active, which a binding would not be re-evaluated from, leaving the
+	// loader without an item while the binding still holds true.
+	if (this->hasLoadBinding()) {
+		qCDebug(logLazyLoader) << "Not unloading" << this << "as its loading state is bound.";
+		return false;
+	}
+
+	this->setActive(false);
+	return true;
+}
@@ -4,11 +4,33 @@
 #include <qobject.h>
 #include <qqmlincubator.h>
 #include <qqmlintegration.h>
+#include <qtclasshelpermacros.h>
+#include <qtimer.h>
 #include <qtmetamacros.h>
+#include <qtypes.h>
 
 #include "incubator.hpp"
 #include "reload.hpp"
 
+class LazyLoaderScheduler;
+
+///! Loading priority of a LazyLoader.
+/// See @@LazyLoader.priority.
+namespace LazyLoaderPriority { // NOLINT
+Q_NAMESPACE;
+QML_ELEMENT;
+
+enum Enum : quint8 {
+	/// The component is only loaded when @@LazyLoader.loading or @@LazyLoader.active is set.
+	Normal = 0,
+	/// The component is loaded in the background once quickshell is idle after loading the
+	/// config, in addition to when it is requested.
+	Idle = 1,
+};
+Q_ENUM_NS(Enum);
+
+} // namespace LazyLoaderPriority
+
 ///! Asynchronous component loader.
 /// The LazyLoader can be used to prepare components that don't need to be
 /// created immediately, such as windows that aren't visible until triggered
@@ -85,6 +107,18 @@
 ///
 /// > [!WARNING] LazyLoaders do not start loading before the first window is created,
 /// > meaning if you create all windows inside of lazy loaders, none of them will ever load.
+///
+/// #### Preloading and unloading
+/// Setting @@priority to `LazyLoaderPriority.Idle` loads the component in the background
+/// shortly after the config has loaded, one loader at a time, so it is ready before it is
+/// first needed. Background loading waits for other asynchronous loads to finish and only
+/// uses half of @@Quickshell.incubationBudget. If another asynchronous load starts while a
+/// loader is preloading, the preload is restarted once it has finished.
+///
+/// Setting @@unloadTimeout destroys the item once it has been hidden for that long after
+/// being shown, or as soon as the system reports memory pressure while it is hidden.
+/// Loaders with a binding on @@active, @@activeAsync or @@loading are never unloaded,
+/// as the binding would be left out of sync with the item.
 class LazyLoader: public Reloadable {
 	Q_OBJECT;
 	/// The fully loaded item if the loader is @@loading or @@active, or `null`
@@ -125,10 +159,34 @@ class LazyLoader: public Reloadable {
 	Q_PROPERTY(QQmlComponent* component READ component WRITE setComponent NOTIFY componentChanged);
 	/// The URI to load the component from. Mutually exclusive to @@component.
 	Q_PROPERTY(QString source READ source WRITE setSource NOTIFY sourceChanged);
+	// clang-format off
+	/// When the component should be loaded if it was not requested. Defaults to
+	/// `LazyLoaderPriority.Normal`.
+	Q_PROPERTY(LazyLoaderPriority::Enum priority READ priority WRITE setPriority NOTIFY priorityChanged);
+	/// Time in milliseconds the item may stay hidden after being shown before it is destroyed,
+	/// setting @@active to false. While hidden, the item is also destroyed if the system reports
+	/// memory pressure. Defaults to -1, which never destroys the item.
+	///
+	/// Only items with a `visible` property, such as windows and @@QtQuick.Item$s, are unloaded.
+	/// Items that have not been shown yet, such as preloaded ones, are only destroyed under
+	/// memory pressure.
+	///
+	/// > [!NOTE] Unloading sets @@active to false, which would leave a binding on @@active,
+	/// > @@activeAsync or @@loading evaluating to true without an item, so loaders with such a
+	/// > binding are never unloaded. Set those properties imperatively instead.
+	///
+	/// > [!WARNING] State held in the item is lost when it is destroyed. It will be recreated
+	/// > the next time @@loading or @@active is set.
+	Q_PROPERTY(qint32 unloadTimeout READ unloadTimeout WRITE setUnloadTimeout NOTIFY unloadTimeoutChanged);
+	// clang-format on
 	Q_CLASSINFO("DefaultProperty", "component");
 	QML_ELEMENT;
 
 public:
+	explicit LazyLoader(QObject* parent = nullptr): Reloadable(parent) {}
+	~LazyLoader() override;
+	Q_DISABLE_COPY_MOVE(LazyLoader);
+
 	void onReload(QObject* oldInstance) override;
 
 	[[nodiscard]] bool isActive() const;
@@ -147,21 +205,38 @@ public:
 	[[nodiscard]] QString source() const;
 	void setSource(QString source);
 
+	[[nodiscard]] LazyLoaderPriority::Enum priority() const;
+	void setPriority(LazyLoaderPriority::Enum priority);
+
+	[[nodiscard]] qint32 unloadTimeout() const;
+	void setUnloadTimeout(qint32 unloadTimeout);
+
 signals:
 	void activeChanged();
 	void loadingChanged();
 	void itemChanged();
 	void sourceChanged();
 	void componentChanged();
+	void priorityChanged();
+	void unloadTimeoutChanged();
 
 private slots:
 	void onIncubationCompleted();
 	void onIncubationFailed();
+	void onIncubationCancelled();
 	void onComponentDestroyed();
+	void onItemVisibleChanged();
+	void onUnloadTimeout();
 
 private:
 	void incubateIfReady(bool overrideReloadCheck = false);
 	void waitForObjectCreation();
+	[[nodiscard]] bool isItemHidden() const;
+	// If active, activeAsync or loading has a binding.
+	[[nodiscard]] bool hasLoadBinding();
+	void updateUnloadTimer();
+	// Destroys the item if it is hidden. Returns true if it was destroyed.
+	bool unloadIfHidden();
 
 	bool targetLoading = false;
 	bool targetActive = false;
@@ -170,4 +245,11 @@ private:
 	QQmlComponent* mComponent = nullptr;
 	QsQmlIncubator* incubator = nullptr;
 	bool cleanupComponent = false;
+	LazyLoaderPriority::Enum mPriority = LazyLoaderPriority::Normal;
+	qint32 mUnloadTimeout = -1;
+	QTimer* unloadTimer = nullptr;
+	bool itemShown = false;
+
+	friend class LazyLoaderScheduler;
+	friend class TestLazyLoader;
 };
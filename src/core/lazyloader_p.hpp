@@ -0,0 +1,65 @@
+#pragma once
+
+#include <qlist.h>
+#include <qsocketnotifier.h>
+#include <qtclasshelpermacros.h>
+#include <qtimer.h>
+#include <qtypes.h>
+
+class LazyLoader;
+
+// Process wide scheduler for background work on LazyLoaders.
+//
+// Idle priority loaders are queued as they finish reloading, and preloaded one at a time
+// once no new loaders have been queued for a while. Loaders with an unload timeout are
+// tracked so their hidden items can be dropped when a PSI trigger on /proc/pressure/memory
+// reports memory pressure. Loads and unloads are counted and logged for tuning.
+class LazyLoaderScheduler {
+public:
+	explicit LazyLoaderScheduler();
+	~LazyLoaderScheduler();
+	Q_DISABLE_COPY_MOVE(LazyLoaderScheduler);
+
+	static LazyLoaderScheduler* instance();
+
+	void queuePreload(LazyLoader* loader);
+	// Puts a preload that was cancelled for other work back at the front of the queue.
+	void deferPreload(LazyLoader* loader);
+	[[nodiscard]] bool isPreloading(const LazyLoader* loader) const {
+		return loader == this->preloading;
+	}
+	void setUnloadable(LazyLoader* loader, bool unloadable);
+	void removeLoader(LazyLoader* loader);
+
+	enum class UnloadReason : quint8 {
+		Timeout,
+		Pressure,
+	};
+
+	void recordLoad(LazyLoader* loader);
+	void recordUnload(LazyLoader* loader, UnloadReason reason);
+
+private:
+	void preloadNext();
+	void onPreloadLoadingChanged();
+	void startPressureMonitor();
+	void onMemoryPressure();
+
+	QList<LazyLoader*> preloadQueue;
+	LazyLoader* preloading = nullptr;
+	QList<LazyLoader*> unloadable;
+	QTimer* preloadTimer = nullptr;
+	int pressureFd = -1;
+	QSocketNotifier* pressureNotifier = nullptr;
+	bool pressureMonitorStarted = false;
+
+	struct {
+		quint64 loads = 0;
+		quint64 preloads = 0;
+		quint64 timeoutUnloads = 0;
+		quint64 pressureUnloads = 0;
+		quint64 pressureEvents = 0;
+	} counts;
+
+	friend class TestLazyLoader;
+};
@@ -1,10 +1,13 @@
 #include "model.hpp"
+#include <algorithm>
 
 #include <qabstractitemmodel.h>
+#include <qcontainerfwd.h>
 #include <qhash.h>
 #include <qnamespace.h>
 #include <qobject.h>
 #include <qqmllist.h>
+#include <qset.h>
 #include <qtmetamacros.h>
 #include <qtypes.h>
 #include <qvariant.h>
@@ -41,33 +44,66 @@ QObject* UntypedObjectModel::valueAt(QQmlListProperty<QObject>* property, qsizet
 }
 
 void UntypedObjectModel::insertObject(QObject* object, qsizetype index) {
+	this->insertObjects({object}, index);
+}
+
+void UntypedObjectModel::insertObjects(const QVector<QObject*>& objects, qsizetype index) {
+	if (objects.isEmpty()) return;
+
 	auto iindex = index == -1 ? this->valuesList.length() : index;
-	emit this->objectInsertedPre(object, iindex);
 
-	auto intIndex = static_cast<qint32>(iindex);
-	this->beginInsertRows(QModelIndex(), intIndex, intIndex);
-	this->valuesList.insert(iindex, object);
+	for (auto i = 0; i != objects.length(); i++) {
+		emit this->objectInsertedPre(objects.at(i), iindex + i);
+	}
+
+	this->beginInsertRows(
+	    QModelIndex(),
+	    static_cast<qint32>(iindex),
+	    static_cast<qint32>(iindex + objects.length() - 1)
+	);
+
+	this->valuesList.insert(iindex, objects.length(), nullptr);
+	std::ranges::copy(objects, this->valuesList.begin() + iindex);
+	this->indexedCount = std::min(this->indexedCount, iindex);
 	this->endInsertRows();
 
-	emit this->valuesChanged();
-	emit this->objectInsertedPost(object, iindex);
+	this->onValuesChanged();
+
+	for (auto i = 0; i != objects.length(); i++) {
+		emit this->objectInsertedPost(objects.at(i), iindex + i);
+	}
 }
 
-void UntypedObjectModel::removeAt(qsizetype index) {
-	auto* object = this->valuesList.at(index);
-	emit this->objectRemovedPre(object, index);
+void UntypedObjectModel::removeAt(qsizetype index) { this->removeRange(index, 1); }
 
-	auto intIndex = static_cast<qint32>(index);
-	this->beginRemoveRows(QModelIndex(), intIndex, intIndex);
-	this->valuesList.removeAt(index);
+void UntypedObjectModel::removeRange(qsizetype index, qsizetype count) {
+	if (count == 0) return;
+
+	auto objects = this->valuesList.sliced(index, count);
+
+	for (auto i = 0; i != count; i++) {
+		emit this->objectRemovedPre(objects.at(i), index + i);
+	}
+
+	this->beginRemoveRows(
+	    QModelIndex(),
+	    static_cast<qint32>(index),
+	    static_cast<qint32>(index + count - 1)
+	);
+
+	this->valuesList.remove(index, count);
+	this->indexedCount = std::min(this->indexedCount, index);
 	this->endRemoveRows();
 
-	emit this->valuesChanged();
-	emit this->objectRemovedPost(object, index);
+	this->onValuesChanged();
+
+	for (auto i = 0; i != count; i++) {
+		emit this->objectRemovedPost(objects.at(i), index + i);
+	}
 }
 
 bool UntypedObjectModel::removeObject(const QObject* object) {
-	auto index = this->valuesList.indexOf(object);
+	auto index = this->findIndex(object);
 	if (index == -1) return false;
 
 	this->removeAt(index);
@@ -75,22 +111,138 @@ bool UntypedObjectModel::removeObject(const QObject* object) {
 }
 
 void UntypedObjectModel::diffUpdate(const QVector<QObject*>& newValues) {
-	for (qsizetype i = 0; i < this->valuesList.length();) {
-		if (newValues.contains(this->valuesList.at(i))) i++;
-		else this->removeAt(i);
-	}
+	auto batch = UpdateBatch(this);
 
-	qsizetype oi = 0;
+	auto newSet = QSet<const QObject*>();
+	newSet.reserve(newValues.length());
 	for (auto* object: newValues) {
-		if (this->valuesList.length() == oi || this->valuesList.at(oi) != object) {
-			this->insertObject(object, oi);
+		newSet.insert(object);
+	}
+
+	// Removing from the back keeps the indices of earlier runs valid.
+	for (auto i = this->valuesList.length() - 1; i >= 0;) {
+		if (newSet.contains(this->valuesList.at(i))) {
+			i--;
+			continue;
 		}
 
-		oi++;
+		auto last = i;
+		while (i >= 0 && !newSet.contains(this->valuesList.at(i))) i--;
+		this->removeRange(i + 1, last - i);
 	}
+
+	// Kept objects are ranked by their current order. Everything after the rows already
+	// placed is an unplaced kept object, so an object's row follows from its rank and the
+	// number of lower ranked objects already moved into place.
+	auto ranks = QHash<const QObject*, qsizetype>();
+	ranks.reserve(this->valuesList.length());
+	for (auto i = 0; i != this->valuesList.length(); i++) {
+		ranks.insert(this->valuesList.at(i), i);
+	}
+
+	// binary indexed tree over the ranks of placed objects
+	auto placed = QVector<qsizetype>(this->valuesList.length() + 1, 0);
+
+	auto place = [&](qsizetype rank) {
+		for (auto i = rank + 1; i < placed.length(); i += i & -i) placed[i]++;
+	};
+
+	auto rowOf = [&](qsizetype row, qsizetype rank) {
+		qsizetype placedBefore = 0;
+		for (auto i = rank; i > 0; i -= i & -i) placedBefore += placed.at(i);
+		return row + rank - placedBefore;
+	};
+
+	for (qsizetype row = 0; row != newValues.length();) {
+		auto* object = newValues.at(row);
+
+		if (row != this->valuesList.length() && this->valuesList.at(row) == object) {
+			place(ranks.value(object));
+			row++;
+			continue;
+		}
+
+		auto end = row + 1;
+		auto rankIter = ranks.constFind(object);
+
+		if (rankIter == ranks.constEnd()) {
+			while (end != newValues.length() && !ranks.contains(newValues.at(end))) end++;
+			this->insertObjects(newValues.sliced(row, end - row), row);
+		} else {
+			auto rank = *rankIter;
+			auto source = rowOf(row, rank);
+
+			// Objects adjacent in both lists are moved together.
+			while (end != newValues.length()
+			       && ranks.value(newValues.at(end), -1) == rank + (end - row))
+			{
+				end++;
+			}
+
+			auto len = end - row;
+
+			this->beginMoveRows(
+			    QModelIndex(),
+			    static_cast<qint32>(source),
+			    static_cast<qint32>(source + len - 1),
+			    QModelIndex(),
+			    static_cast<qint32>(row)
+			);
+
+			auto begin = this->valuesList.begin();
+			std::rotate(begin + row, begin + source, begin + source + len);
+			this->indexedCount = std::min(this->indexedCount, row);
+			this->endMoveRows();
+
+			this->onValuesChanged();
+
+			for (auto i = rank; i != rank + len; i++) place(i);
+		}
+
+		row = end;
+	}
+}
+
+qsizetype UntypedObjectModel::indexOf(QObject* object) { return this->findIndex(object); }
+
+qsizetype UntypedObjectModel::findIndex(const QObject* object) {
+	auto validIndex = [this](const QObject* object) -> qsizetype {
+		auto iter = this->indexMap.constFind(object);
+		if (iter == this->indexMap.constEnd()) return -1;
+
+		auto index = *iter;
+		if (index >= this->indexedCount || this->valuesList.at(index) != object) return -1;
+		return index;
+	};
+
+	auto index = validIndex(object);
+	if (index != -1 || this->indexedCount == this->valuesList.length()) return index;
+
+	// stale entries past the indexed range are overwritten or fail validation
+	if (this->indexedCount == 0) this->indexMap.clear();
+
+	for (auto i = this->indexedCount; i != this->valuesList.length(); i++) {
+		auto* value = this->valuesList.at(i);
+		this->indexedCount = i;
+		if (validIndex(value) == -1) this->indexMap.insert(value, i);
+	}
+
+	this->indexedCount = this->valuesList.length();
+	return validIndex(object);
+}
+
+void UntypedObjectModel::onValuesChanged() {
+	if (this->batchDepth == 0) emit this->valuesChanged();
+	else this->batchChanged = true;
 }
 
-qsizetype UntypedObjectModel::indexOf(QObject* object) { return this->valuesList.indexOf(object); }
+UntypedObjectModel::UpdateBatch::~UpdateBatch() {
+	auto* model = this->model;
+	if (--model->batchDepth != 0 || !model->batchChanged) return;
+
+	model->batchChanged = false;
+	emit model->valuesChanged();
+}
 
 UntypedObjectModel* UntypedObjectModel::emptyInstance() {
 	static auto* instance = new UntypedObjectModel(nullptr); // NOLINT
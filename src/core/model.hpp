@@ -3,9 +3,11 @@
 #include <bit>
 #include <qabstractitemmodel.h>
 #include <qcontainerfwd.h>
+#include <qhash.h>
 #include <qobject.h>
 #include <qqmlintegration.h>
 #include <qqmllist.h>
+#include <qtclasshelpermacros.h>
 #include <qtmetamacros.h>
 #include <qtypes.h>
 #include <qvariant.h>
@@ -58,6 +60,18 @@ public:
 
 	static UntypedObjectModel* emptyInstance();
 
+	// Defers valuesChanged until the outermost batch on the model is destroyed, and emits it
+	// once if any change was made.
+	class UpdateBatch {
+	public:
+		explicit UpdateBatch(UntypedObjectModel* model): model(model) { this->model->batchDepth++; }
+		~UpdateBatch();
+		Q_DISABLE_COPY_MOVE(UpdateBatch);
+
+	private:
+		UntypedObjectModel* model;
+	};
+
 signals:
 	void valuesChanged();
 	/// Sent immediately before an object is inserted into the list.
@@ -71,16 +85,36 @@ signals:
 
 protected:
 	void insertObject(QObject* object, qsizetype index = -1);
+	// Inserts a contiguous range of objects with a single row insertion.
+	void insertObjects(const QVector<QObject*>& objects, qsizetype index = -1);
 	bool removeObject(const QObject* object);
+	// Removes a contiguous range of objects with a single row removal.
+	void removeRange(qsizetype index, qsizetype count);
 
 	// Assumes only one instance of a specific value
 	void diffUpdate(const QVector<QObject*>& newValues);
 
+	// Must be called if valuesList is modified directly.
+	void invalidateIndices() { this->indexedCount = 0; }
+
 	QVector<QObject*> valuesList;
 
 private:
+	qsizetype findIndex(const QObject* object);
+	void onValuesChanged();
+
 	static qsizetype valuesCount(QQmlListProperty<QObject>* property);
 	static QObject* valueAt(QQmlListProperty<QObject>* property, qsizetype index);
+
+	// Index of each object in valuesList, valid for the first indexedCount entries.
+	// Extended lazily by indexOf, and truncated by changes before the end of the list.
+	QHash<const QObject*, qsizetype> indexMap;
+	qsizetype indexedCount = 0;
+
+	qint32 batchDepth = 0;
+	bool batchChanged = false;
+
+	friend class TestObjectModel;
 };
 
 template <typename T>
@@ -88,16 +122,29 @@ class ObjectModel: public UntypedObjectModel {
 public:
 	explicit ObjectModel(QObject* parent): UntypedObjectModel(parent) {}
 
-	[[nodiscard]] QVector<T*>& valueList() { return *std::bit_cast<QVector<T*>*>(&this->valuesList); }
-
 	[[nodiscard]] const QVector<T*>& valueList() const {
 		return *std::bit_cast<const QVector<T*>*>(&this->valuesList);
 	}
 
+	// Allows modifying the list directly, bypassing all model signals. Invalidates the index
+	// map, so the returned reference must not be used for modification after another call
+	// on the model.
+	[[nodiscard]] QVector<T*>& mutableValueList() {
+		this->invalidateIndices();
+		return *std::bit_cast<QVector<T*>*>(&this->valuesList);
+	}
+
 	void insertObject(T* object, qsizetype index = -1) {
 		this->UntypedObjectModel::insertObject(object, index);
 	}
 
+	void insertObjects(const QVector<T*>& objects, qsizetype index = -1) {
+		this->UntypedObjectModel::insertObjects(
+		    *std::bit_cast<const QVector<QObject*>*>(&objects),
+		    index
+		);
+	}
+
 	void removeObject(const T* object) { this->UntypedObjectModel::removeObject(object); }
 
 	// Assumes only one instance of a specific value
@@ -66,6 +66,8 @@ void ObjectRepeater::onDelegateDestroyed() {
 }
 
 void ObjectRepeater::reloadElements() {
+	auto batch = UpdateBatch(this);
+
 	for (auto i = this->valuesList.length() - 1; i >= 0; i--) {
 		this->removeComponent(i);
 	}
@@ -113,6 +115,7 @@ void ObjectRepeater::insertModelElements(QAbstractItemModel* model, int first, i
 
 	auto values = QModelRoleDataSpan(roleDataVec);
 	auto props = QVariantMap();
+	auto batch = UpdateBatch(this);
 
 	for (auto i = first; i != last + 1; i++) {
 		auto index = model->index(i, 0);
@@ -137,6 +140,7 @@ void ObjectRepeater::onModelRowsInserted(const QModelIndex& parent, int first, i
 void ObjectRepeater::onModelRowsRemoved(const QModelIndex& parent, int first, int last) {
 	if (parent != QModelIndex()) return;
 
+	auto batch = UpdateBatch(this);
 	for (auto i = last; i != first - 1; i--) {
 		this->removeComponent(i);
 	}
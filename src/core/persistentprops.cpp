@@ -1,10 +1,41 @@
 #include "persistentprops.hpp"
+#include <algorithm>
 
+#include <qjsvalue.h>
+#include <qmetatype.h>
 #include <qobject.h>
 #include <qtmetamacros.h>
+#include <qvariant.h>
+
+#include "relaunchstate.hpp"
+#include "reload.hpp"
+#include "variants.hpp"
+
+namespace {
+
+bool isSerializable(const QVariant& value) {
+	auto type = value.metaType();
+	if (type.flags() & QMetaType::PointerToQObject) return false;
+
+	switch (type.id()) {
+	case QMetaType::QVariantList: return std::ranges::all_of(value.toList(), isSerializable);
+	case QMetaType::QVariantMap: return std::ranges::all_of(value.toMap(), isSerializable);
+	default: return type.hasRegisteredDataStreamOperators();
+	}
+}
+
+} // namespace
+
+PersistentProperties::~PersistentProperties() {
+	RelaunchState::instance()->removePersistentProperties(this);
+}
 
 void PersistentProperties::onReload(QObject* oldInstance) {
-	if (qobject_cast<PersistentProperties*>(oldInstance) == nullptr) {
+	auto* old = qobject_cast<PersistentProperties*>(oldInstance);
+	auto restored = old == nullptr ? RelaunchState::takeRestored(this->relaunchKey()) : QVariantMap();
+
+	if (old == nullptr && restored.isEmpty()) {
+		RelaunchState::instance()->addPersistentProperties(this);
 		emit this->loaded();
 		return;
 	}
@@ -12,13 +43,56 @@ void PersistentProperties::onReload(QObject* oldInstance) {
 	const auto* metaObject = this->metaObject();
 	for (auto i = metaObject->propertyOffset(); i < metaObject->propertyCount(); i++) {
 		const auto prop = metaObject->property(i);
-		auto oldProp = oldInstance->property(prop.name());
+		auto oldProp = old != nullptr ? old->property(prop.name()) : restored.value(prop.name());
 
 		if (oldProp.isValid()) {
 			this->setProperty(prop.name(), oldProp);
 		}
 	}
 
+	RelaunchState::instance()->addPersistentProperties(this);
 	emit this->loaded();
 	emit this->reloaded();
 }
+
+QString PersistentProperties::relaunchKey() const {
+	if (this->mReloadableId.isEmpty()) return QString();
+
+	auto key = this->mReloadableId;
+	const QObject* child = this;
+
+	for (auto* object = this->parent(); object != nullptr; object = object->parent()) {
+		// instances of the same delegate share reloadable ids
+		if (auto* variants = qobject_cast<Variants*>(object)) {
+			auto instanceKey = variants->instanceKey(child);
+			if (!instanceKey.isEmpty()) key.prepend(u'[' + instanceKey + u"]/");
+		}
+
+		if (auto* reloadable = qobject_cast<Reloadable*>(object)) {
+			key.prepend(reloadable->mReloadableId + u'/');
+		}
+
+		child = object;
+	}
+
+	return key;
+}
+
+QVariantMap PersistentProperties::serializableValues() const {
+	auto values = QVariantMap();
+
+	const auto* metaObject = this->metaObject();
+	for (auto i = metaObject->propertyOffset(); i < metaObject->propertyCount(); i++) {
+		const auto prop = metaObject->property(i);
+		auto value = prop.read(this);
+
+		// `property var` values are held as js values
+		if (value.metaType() == QMetaType::fromType<QJSValue>()) {
+			value = value.value<QJSValue>().toVariant();
+		}
+
+		if (isSerializable(value)) values.insert(prop.name(), value);
+	}
+
+	return values;
+}
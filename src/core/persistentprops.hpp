@@ -1,7 +1,10 @@
 #pragma once
 
+#include <qcontainerfwd.h>
 #include <qobject.h>
 #include <qqmlintegration.h>
+#include <qtclasshelpermacros.h>
+#include <qtmetamacros.h>
 
 #include "reload.hpp"
 
@@ -38,20 +41,35 @@
 ///   visible: persist.expanderOpen
 /// }
 /// ```
+///
+/// If quickshell crashes and is restarted, properties of objects with a @@Reloadable.reloadableId
+/// are restored to their last values. Only plain data such as strings, numbers, lists and
+/// maps is kept across a crash, object references are not.
+/// Within a @@Variants delegate, each instance is told apart by its model value, or by its
+/// position in the model if the value is not a string or number, such as a screen.
 class PersistentProperties: public Reloadable {
 	Q_OBJECT;
 	QML_ELEMENT;
 
 public:
 	PersistentProperties(QObject* parent = nullptr): Reloadable(parent) {}
+	~PersistentProperties() override;
+	Q_DISABLE_COPY_MOVE(PersistentProperties);
 
 	void onReload(QObject* oldInstance) override;
 
+	// Identifies this object across processes by the reloadable ids of its reload scopes.
+	// Empty if the object has no reloadable id.
+	[[nodiscard]] QString relaunchKey() const;
+	// Property values that can be written to a relaunch state snapshot.
+	[[nodiscard]] QVariantMap serializableValues() const;
+
 signals:
 	/// Called every time the reload stage completes.
 	/// Will be called every time, including when nothing was loaded from an old instance.
 	void loaded();
 	/// Called every time the properties are reloaded.
-	/// Will not be called if no old instance was loaded.
+	/// Will not be called if no old instance was loaded, either from the previous
+	/// config revision or from before a crash.
 	void reloaded();
 };
@@ -1,4 +1,5 @@
 #include "qmlglobal.hpp"
+#include <algorithm>
 #include <utility>
 
 #include <qcontainerfwd.h>
@@ -21,6 +22,7 @@
 
 #include "generation.hpp"
 #include "iconimageprovider.hpp"
+#include "incubator.hpp"
 #include "qmlscreen.hpp"
 #include "rootwrapper.hpp"
 
@@ -42,7 +44,12 @@ QuickshellSettings* QuickshellSettings::instance() {
 	return instance;
 }
 
-void QuickshellSettings::reset() { QuickshellSettings::instance()->mWatchFiles = true; }
+void QuickshellSettings::reset() {
+	auto* instance = QuickshellSettings::instance();
+	instance->mWatchFiles = true;
+	instance->mIncubationBudget = 5;
+	instance->mScreencopyBandwidth = -1;
+}
 
 QString QuickshellSettings::workingDirectory() const { // NOLINT
 	return QDir::current().absolutePath();
@@ -61,6 +68,26 @@ void QuickshellSettings::setWatchFiles(bool watchFiles) {
 	emit this->watchFilesChanged();
 }
 
+qreal QuickshellSettings::incubationBudget() const { return this->mIncubationBudget; }
+
+void QuickshellSettings::setIncubationBudget(qreal incubationBudget) {
+	// incubation can't be limited to less than a millisecond at a time
+	incubationBudget = std::max(incubationBudget, 1.0);
+	if (incubationBudget == this->mIncubationBudget) return;
+	this->mIncubationBudget = incubationBudget;
+	emit this->incubationBudgetChanged();
+}
+
+qreal QuickshellSettings::screencopyBandwidth() const { return this->mScreencopyBandwidth; }
+
+void QuickshellSettings::setScreencopyBandwidth(qreal screencopyBandwidth) {
+	// any negative value selects the default
+	if (screencopyBandwidth < 0) screencopyBandwidth = -1;
+	if (screencopyBandwidth == this->mScreencopyBandwidth) return;
+	this->mScreencopyBandwidth = screencopyBandwidth;
+	emit this->screencopyBandwidthChanged();
+}
+
 QuickshellTracked::QuickshellTracked() {
 	auto* app = QCoreApplication::instance();
 	auto* guiApp = qobject_cast<QGuiApplication*>(app);
@@ -127,6 +154,8 @@ QuickshellGlobal::QuickshellGlobal(QObject* parent): QObject(parent) {
 	// clang-format off
 	QObject::connect(QuickshellSettings::instance(), &QuickshellSettings::workingDirectoryChanged, this, &QuickshellGlobal::workingDirectoryChanged);
 	QObject::connect(QuickshellSettings::instance(), &QuickshellSettings::watchFilesChanged, this, &QuickshellGlobal::watchFilesChanged);
+	QObject::connect(QuickshellSettings::instance(), &QuickshellSettings::incubationBudgetChanged, this, &QuickshellGlobal::incubationBudgetChanged);
+	QObject::connect(QuickshellSettings::instance(), &QuickshellSettings::screencopyBandwidthChanged, this, &QuickshellGlobal::screencopyBandwidthChanged);
 	QObject::connect(QuickshellSettings::instance(), &QuickshellSettings::lastWindowClosed, this, &QuickshellGlobal::lastWindowClosed);
 
 	QObject::connect(QuickshellTracked::instance(), &QuickshellTracked::screensChanged, this, &QuickshellGlobal::screensChanged);
@@ -189,6 +218,32 @@ void QuickshellGlobal::setWatchFiles(bool watchFiles) { // NOLINT
 	QuickshellSettings::instance()->setWatchFiles(watchFiles);
 }
 
+qreal QuickshellGlobal::incubationBudget() const { // NOLINT
+	return QuickshellSettings::instance()->incubationBudget();
+}
+
+void QuickshellGlobal::setIncubationBudget(qreal incubationBudget) { // NOLINT
+	QuickshellSettings::instance()->setIncubationBudget(incubationBudget);
+}
+
+qreal QuickshellGlobal::screencopyBandwidth() const { // NOLINT
+	return QuickshellSettings::instance()->screencopyBandwidth();
+}
+
+void QuickshellGlobal::setScreencopyBandwidth(qreal screencopyBandwidth) { // NOLINT
+	QuickshellSettings::instance()->setScreencopyBandwidth(screencopyBandwidth);
+}
+
+qint32 QuickshellGlobal::incubatingObjects() const {
+	auto* generation = EngineGeneration::findObjectGeneration(this);
+	return generation == nullptr ? 0 : generation->incubationController.incubatingObjectCount();
+}
+
+qreal QuickshellGlobal::incubationTime() const {
+	auto* generation = EngineGeneration::findObjectGeneration(this);
+	return generation == nullptr ? 0 : generation->incubationController.incubationTime();
+}
+
 QVariant QuickshellGlobal::env(const QString& variable) { // NOLINT
 	auto vstr = variable.toStdString();
 	if (!qEnvironmentVariableIsSet(vstr.data())) return QVariant::fromValue(nullptr);
@@ -217,5 +272,12 @@ QuickshellGlobal* QuickshellGlobal::create(QQmlEngine* engine, QJSEngine* /*unus
 		generation->qsgInstance = qsg;
 	}
 
+	QObject::connect(
+	    &generation->incubationController,
+	    &QsIncubationController::incubationChanged,
+	    qsg,
+	    &QuickshellGlobal::incubationChanged
+	);
+
 	return qsg;
 }
@@ -22,6 +22,12 @@ class QuickshellSettings: public QObject {
 	/// If true then the configuration will be reloaded whenever any files change.
 	/// Defaults to true.
 	Q_PROPERTY(bool watchFiles READ watchFiles WRITE setWatchFiles NOTIFY watchFilesChanged);
+	/// Time in milliseconds asynchronous object creation may use per frame. Defaults to 5.
+	/// Values below 1 are raised to 1.
+	Q_PROPERTY(qreal incubationBudget READ incubationBudget WRITE setIncubationBudget NOTIFY incubationBudgetChanged);
+	/// Megapixels per second all screencopy captures may copy together. Defaults to -1, which
+	/// allows copying every output once per refresh. 0 disables the limit.
+	Q_PROPERTY(qreal screencopyBandwidth READ screencopyBandwidth WRITE setScreencopyBandwidth NOTIFY screencopyBandwidthChanged);
 	// clang-format on
 	QML_ELEMENT;
 	QML_UNCREATABLE("singleton");
@@ -35,6 +41,12 @@ public:
 	[[nodiscard]] bool watchFiles() const;
 	void setWatchFiles(bool watchFiles);
 
+	[[nodiscard]] qreal incubationBudget() const;
+	void setIncubationBudget(qreal incubationBudget);
+
+	[[nodiscard]] qreal screencopyBandwidth() const;
+	void setScreencopyBandwidth(qreal screencopyBandwidth);
+
 	[[nodiscard]] bool quitOnLastClosed() const;
 	void setQuitOnLastClosed(bool exitOnLastClosed);
 
@@ -49,9 +61,13 @@ signals:
 
 	void workingDirectoryChanged();
 	void watchFilesChanged();
+	void incubationBudgetChanged();
+	void screencopyBandwidthChanged();
 
 private:
 	bool mWatchFiles = true;
+	qreal mIncubationBudget = 5;
+	qreal mScreencopyBandwidth = -1;
 };
 
 class QuickshellTracked: public QObject {
@@ -108,6 +124,23 @@ class QuickshellGlobal: public QObject {
 	/// If true then the configuration will be reloaded whenever any files change.
 	/// Defaults to true.
 	Q_PROPERTY(bool watchFiles READ watchFiles WRITE setWatchFiles NOTIFY watchFilesChanged);
+	/// Time in milliseconds asynchronous object creation, such as by @@LazyLoader, may use per frame.
+	/// Defaults to 5. Values below 1 are raised to 1.
+	///
+	/// The budget is shared by all windows. Idle priority loaders (see @@LazyLoader.priority) only
+	/// get half of it while nothing else is being created, and are restarted later if anything
+	/// else starts being created.
+	Q_PROPERTY(qreal incubationBudget READ incubationBudget WRITE setIncubationBudget NOTIFY incubationBudgetChanged);
+	/// Megapixels per second all screencopy captures, such as by @@Quickshell.Wayland.ScreencopyView,
+	/// may copy together. Captures that would exceed it are delayed, taking turns.
+	///
+	/// Defaults to -1, which allows copying every output once per refresh at its full resolution.
+	/// 0 disables the limit.
+	Q_PROPERTY(qreal screencopyBandwidth READ screencopyBandwidth WRITE setScreencopyBandwidth NOTIFY screencopyBandwidthChanged);
+	/// Number of objects currently being created asynchronously.
+	Q_PROPERTY(qint32 incubatingObjects READ incubatingObjects NOTIFY incubationChanged);
+	/// Total time in milliseconds spent creating objects asynchronously since the config was loaded.
+	Q_PROPERTY(qreal incubationTime READ incubationTime NOTIFY incubationChanged);
 	// clang-format on
 	QML_SINGLETON;
 	QML_NAMED_ELEMENT(Quickshell);
@@ -152,6 +185,15 @@ public:
 	[[nodiscard]] bool watchFiles() const;
 	void setWatchFiles(bool watchFiles);
 
+	[[nodiscard]] qreal incubationBudget() const;
+	void setIncubationBudget(qreal incubationBudget);
+
+	[[nodiscard]] qreal screencopyBandwidth() const;
+	void setScreencopyBandwidth(qreal screencopyBandwidth);
+
+	[[nodiscard]] qint32 incubatingObjects() const;
+	[[nodiscard]] qreal incubationTime() const;
+
 	static QuickshellGlobal* create(QQmlEngine* engine, QJSEngine* /*unused*/);
 
 signals:
@@ -167,6 +209,9 @@ signals:
 	void screensChanged();
 	void workingDirectoryChanged();
 	void watchFilesChanged();
+	void incubationBudgetChanged();
+	void screencopyBandwidthChanged();
+	void incubationChanged();
 
 private:
 	QuickshellGlobal(QObject* parent = nullptr);
@@ -0,0 +1,133 @@
+#include "qoi.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include <qbytearray.h>
+#include <qimage.h>
+#include <qtypes.h>
+
+namespace {
+
+constexpr quint8 QOI_OP_INDEX = 0x00;
+constexpr quint8 QOI_OP_DIFF = 0x40;
+constexpr quint8 QOI_OP_LUMA = 0x80;
+constexpr quint8 QOI_OP_RUN = 0xc0;
+constexpr quint8 QOI_OP_RGB = 0xfe;
+constexpr quint8 QOI_OP_RGBA = 0xff;
+
+constexpr qint32 MAX_RUN = 62;
+constexpr qint32 HEADER_SIZE = 14;
+constexpr std::array<char, 8> END_MARKER = {0, 0, 0, 0, 0, 0, 0, 1};
+
+struct Pixel {
+	quint8 r = 0;
+	quint8 g = 0;
+	quint8 b = 0;
+	quint8 a = 0;
+
+	[[nodiscard]] bool operator==(const Pixel& other) const = default;
+	[[nodiscard]] quint8 hash() const {
+		return (this->r * 3 + this->g * 5 + this->b * 7 + this->a * 11) % 64;
+	}
+};
+
+void appendBigEndian(QByteArray& data, quint32 value) {
+	data.append(static_cast<char>(value >> 24));
+	data.append(static_cast<char>(value >> 16));
+	data.append(static_cast<char>(value >> 8));
+	data.append(static_cast<char>(value));
+}
+
+} // namespace
+
+QByteArray QoiEncoder::encode(const QImage& image) {
+	if (image.isNull()) return QByteArray();
+
+	auto hasAlpha = image.hasAlphaChannel();
+	// QOI stores unpremultiplied alpha, and opaque formats convert with an alpha of 255.
+	auto rgba = image.convertToFormat(QImage::Format_RGBA8888);
+	auto width = rgba.width();
+	auto height = rgba.height();
+
+	auto data = QByteArray();
+	// worst case is a QOI_OP_RGBA for every pixel
+	data.reserve(HEADER_SIZE + static_cast<qsizetype>(width) * height * 5 + END_MARKER.size());
+
+	data.append("qoif");
+	appendBigEndian(data, width);
+	appendBigEndian(data, height);
+	data.append(static_cast<char>(hasAlpha ? 4 : 3));
+	data.append(static_cast<char>(0)); // sRGB with linear alpha
+
+	auto index = std::array<Pixel, 64>();
+	auto prev = Pixel {.r = 0, .g = 0, .b = 0, .a = 255};
+	qint32 run = 0;
+
+	auto op = [&](quint8 byte) { data.append(static_cast<char>(byte)); };
+
+	for (qint32 y = 0; y != height; y++) {
+		const auto* line = rgba.constScanLine(y);
+
+		for (qint32 x = 0; x != width; x++) {
+			const auto* bytes = line + static_cast<ptrdiff_t>(x) * 4; // NOLINT
+			auto px = Pixel {.r = bytes[0], .g = bytes[1], .b = bytes[2], .a = bytes[3]}; // NOLINT
+
+			if (px == prev) {
+				run++;
+
+				if (run == MAX_RUN || (y == height - 1 && x == width - 1)) {
+					op(QOI_OP_RUN | (run - 1));
+					run = 0;
+				}
+
+				continue;
+			}
+
+			if (run != 0) {
+				op(QOI_OP_RUN | (run - 1));
+				run = 0;
+			}
+
+			auto hash = px.hash();
+
+			if (index.at(hash) == px) {
+				op(QOI_OP_INDEX | hash);
+			} else {
+				index.at(hash) = px;
+
+				if (px.a == prev.a) {
+					// channel differences wrap around
+					auto dr = static_cast<int8_t>(px.r - prev.r);
+					auto dg = static_cast<int8_t>(px.g - prev.g);
+					auto db = static_cast<int8_t>(px.b - prev.b);
+					auto drg = dr - dg;
+					auto dbg = db - dg;
+
+					if (dr >= -2 && dr <= 1 && dg >= -2 && dg <= 1 && db >= -2 && db <= 1) {
+						op(QOI_OP_DIFF | (dr + 2) << 4 | (dg + 2) << 2 | (db + 2));
+					} else if (dg >= -32 && dg <= 31 && drg >= -8 && drg <= 7 && dbg >= -8 && dbg <= 7) {
+						op(QOI_OP_LUMA | (dg + 32));
+						op((drg + 8) << 4 | (dbg + 8));
+					} else {
+						op(QOI_OP_RGB);
+						op(px.r);
+						op(px.g);
+						op(px.b);
+					}
+				} else {
+					op(QOI_OP_RGBA);
+					op(px.r);
+					op(px.g);
+					op(px.b);
+					op(px.a);
+				}
+			}
+
+			prev = px;
+		}
+	}
+
+	data.append(END_MARKER.data(), END_MARKER.size());
+	return data;
+}
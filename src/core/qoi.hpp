@@ -0,0 +1,15 @@
+#pragma once
+
+#include <qbytearray.h>
+#include <qimage.h>
+
+// Encoder for the Quite OK Image format (https://qoiformat.org).
+//
+// QOI compresses considerably worse than PNG, but encodes several times faster, which
+// makes it a good fit for large images that are written often, such as screenshots.
+class QoiEncoder {
+public:
+	// Encodes image in sRGB with 4 channels if it has an alpha channel, otherwise 3.
+	// Returns an empty array if the image is null.
+	[[nodiscard]] static QByteArray encode(const QImage& image);
+};
@@ -0,0 +1,146 @@
+#include "relaunchstate.hpp"
+#include <utility>
+
+#include <qdatastream.h>
+#include <qfile.h>
+#include <qhash.h>
+#include <qlogging.h>
+#include <qloggingcategory.h>
+#include <qmetaobject.h>
+#include <qobject.h>
+#include <qtmetamacros.h>
+#include <qtypes.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "instanceinfo.hpp"
+#include "persistentprops.hpp"
+
+namespace {
+Q_LOGGING_CATEGORY(logRelaunch, "quickshell.relaunch", QtWarningMsg);
+
+constexpr quint32 SNAPSHOT_VERSION = 1;
+// delay between a change and the snapshot including it, batching rapid changes
+constexpr qint32 SNAPSHOT_DELAY_MS = 500;
+
+QHash<QString, QVariantMap> RESTORED; // NOLINT
+
+} // namespace
+
+RelaunchState::RelaunchState() {
+	this->snapshotTimer.setSingleShot(true);
+	this->snapshotTimer.setInterval(SNAPSHOT_DELAY_MS);
+
+	QObject::connect(&this->snapshotTimer, &QTimer::timeout, this, &RelaunchState::writeSnapshot);
+}
+
+RelaunchState* RelaunchState::instance() {
+	static auto* instance = new RelaunchState(); // NOLINT
+	return instance;
+}
+
+void RelaunchState::enable() {
+	if (this->enabled) return;
+	this->enabled = true;
+	this->scheduleSnapshot();
+}
+
+void RelaunchState::addPersistentProperties(PersistentProperties* properties) {
+	if (this->persistentProperties.contains(properties)) return;
+	this->persistentProperties.push_back(properties);
+
+	static const auto slot = RelaunchState::staticMetaObject.method(
+	    RelaunchState::staticMetaObject.indexOfSlot("scheduleSnapshot()")
+	);
+
+	const auto* metaObject = properties->metaObject();
+	for (auto i = metaObject->propertyOffset(); i < metaObject->propertyCount(); i++) {
+		auto prop = metaObject->property(i);
+		if (prop.hasNotifySignal()) QObject::connect(properties, prop.notifySignal(), this, slot);
+	}
+
+	this->scheduleSnapshot();
+}
+
+void RelaunchState::removePersistentProperties(PersistentProperties* properties) {
+	// Not followed by a snapshot, as this also happens during shutdown, possibly after the
+	// application object is gone. Stale entries are harmless as nothing will match them.
+	if (!this->persistentProperties.removeOne(properties)) return;
+	QObject::disconnect(properties, nullptr, this, nullptr);
+}
+
+void RelaunchState::scheduleSnapshot() {
+	if (!this->enabled || this->snapshotTimer.isActive()) return;
+	this->snapshotTimer.start();
+}
+
+void RelaunchState::writeSnapshot() {
+	auto state = QHash<QString, QVariantMap>();
+
+	// During a reload both generations are registered, and the newer one is registered last.
+	for (auto* properties: this->persistentProperties) {
+		auto key = properties->relaunchKey();
+		if (!key.isEmpty()) state.insert(key, properties->serializableValues());
+	}
+
+	auto fd = memfd_create("quickshell:relaunch_state", MFD_CLOEXEC);
+
+	if (fd == -1) {
+		qCWarning(logRelaunch) << "Failed to create memfd for relaunch state" << qt_error_string(-1);
+		return;
+	}
+
+	{
+		auto file = QFile();
+		file.open(fd, QFile::WriteOnly, QFile::DontCloseHandle);
+
+		auto ds = QDataStream(&file);
+		ds << SNAPSHOT_VERSION << state;
+		file.flush();
+
+		if (ds.status() != QDataStream::Ok) {
+			qCWarning(logRelaunch) << "Failed to write relaunch state snapshot.";
+			close(fd);
+			return;
+		}
+	}
+
+	auto oldFd = std::exchange(qs::crash::CrashInfo::INSTANCE.stateFd, fd);
+	if (oldFd != -1) close(oldFd);
+
+	qCDebug(logRelaunch) << "Wrote relaunch state snapshot with" << state.size() << "entries";
+}
+
+void RelaunchState::loadSnapshot(int fd) {
+	auto file = QFile();
+
+	if (!file.open(fd, QFile::ReadOnly, QFile::AutoCloseHandle)) {
+		qCWarning(logRelaunch) << "Failed to open relaunch state snapshot.";
+		return;
+	}
+
+	file.seek(0);
+	auto ds = QDataStream(&file);
+
+	quint32 version = 0;
+	ds >> version;
+
+	if (version != SNAPSHOT_VERSION) {
+		qCWarning(logRelaunch) << "Ignoring relaunch state snapshot with unknown version" << version;
+		return;
+	}
+
+	auto state = QHash<QString, QVariantMap>();
+	ds >> state;
+
+	if (ds.status() != QDataStream::Ok) {
+		qCWarning(logRelaunch) << "Ignoring unreadable relaunch state snapshot.";
+		return;
+	}
+
+	qCInfo(logRelaunch) << "Restoring" << state.size()
+	                    << "PersistentProperties from before the crash.";
+	RESTORED = std::move(state);
+}
+
+QVariantMap RelaunchState::takeRestored(const QString& key) { return RESTORED.take(key); }
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <qcontainerfwd.h>
+#include <qlist.h>
+#include <qobject.h>
+#include <qtimer.h>
+#include <qtmetamacros.h>
+
+class PersistentProperties;
+
+// State carried over to the instance relaunched after a crash.
+//
+// Once enabled, a snapshot of all PersistentProperties is written shortly after any of them
+// change. Each snapshot is written to a new memfd which only replaces CrashInfo::stateFd once
+// complete, so the crash handler never hands a partial snapshot to the relaunched process.
+class RelaunchState: public QObject {
+	Q_OBJECT;
+
+public:
+	static RelaunchState* instance();
+
+	// Starts writing snapshots. Should only be called if the crash handler is active.
+	void enable();
+
+	void addPersistentProperties(PersistentProperties* properties);
+	void removePersistentProperties(PersistentProperties* properties);
+
+	// Reads a snapshot passed by the crash handler. Must be called before the first config load.
+	static void loadSnapshot(int fd);
+	// Returns and forgets the restored values for the given PersistentProperties key.
+	static QVariantMap takeRestored(const QString& key);
+
+public slots:
+	void scheduleSnapshot();
+
+private slots:
+	void writeSnapshot();
+
+private:
+	explicit RelaunchState();
+
+	bool enabled = false;
+	QList<PersistentProperties*> persistentProperties;
+	QTimer snapshotTimer;
+
+	friend class TestRelaunchState;
+};
@@ -1,125 +1,387 @@
 #include "scriptmodel.hpp"
 #include <algorithm>
-#include <iterator>
+#include <cstddef>
+#include <utility>
 
 #include <qabstractitemmodel.h>
+#include <qbytearray.h>
 #include <qcontainerfwd.h>
+#include <qhash.h>
+#include <qhashfunctions.h>
+#include <qjsvalue.h>
 #include <qlist.h>
+#include <qmetatype.h>
 #include <qnamespace.h>
+#include <qobject.h>
 #include <qtmetamacros.h>
-#include <qtversionchecks.h>
 #include <qtypes.h>
 #include <qvariant.h>
 
-void ScriptModel::updateValuesUnique(const QVariantList& newValues) {
-	this->mValues.reserve(newValues.size());
+namespace {
 
-	auto iter = this->mValues.begin();
-	auto newIter = newValues.begin();
+bool isNumeric(const QMetaType& type) {
+	switch (type.id()) {
+	case QMetaType::Bool:
+	case QMetaType::Char:
+	case QMetaType::SChar:
+	case QMetaType::UChar:
+	case QMetaType::Short:
+	case QMetaType::UShort:
+	case QMetaType::Int:
+	case QMetaType::UInt:
+	case QMetaType::Long:
+	case QMetaType::ULong:
+	case QMetaType::LongLong:
+	case QMetaType::ULongLong:
+	case QMetaType::Float16:
+	case QMetaType::Float:
+	case QMetaType::Double: return true;
+	default: return false;
+	}
+}
+
+// Must hash values that compare equal as QVariants equally. Containers are hashed by
+// their contents so structurally different values rarely collide.
+size_t variantHash(const QVariant& value, size_t seed = 0) {
+	auto type = value.metaType();
+
+	if (type.flags() & QMetaType::PointerToQObject) {
+		return qHash(value.value<QObject*>(), seed);
+	}
+
+	// numeric types compare equal across types, so they must hash equally
+	if (isNumeric(type)) return qHash(value.toDouble(), seed);
+
+	switch (type.id()) {
+	case QMetaType::QString: return qHash(value.toString(), seed);
+	case QMetaType::QVariantList: {
+		auto hash = seed;
+		for (const auto& item: value.toList()) {
+			hash = variantHash(item, hash);
+		}
+
+		return hash;
+	}
+	case QMetaType::QVariantMap: {
+		auto hash = seed;
+		for (const auto& [key, item]: value.toMap().asKeyValueRange()) {
+			hash = variantHash(item, qHash(key, hash));
+		}
+
+		return hash;
+	}
+	case QMetaType::QVariantHash: {
+		// iteration order is unspecified, so entries are combined commutatively
+		auto hash = seed;
+		for (const auto& [key, item]: value.toHash().asKeyValueRange()) {
+			hash += variantHash(item, qHash(key, seed));
+		}
+
+		return hash;
+	}
+	default:
+		// Other types, such as colors and urls, are hashed by their string form where one
+		// exists. Values are still told apart by equality.
+		if (QMetaType::canConvert(type, QMetaType::fromType<QString>())) {
+			return qHashMulti(seed, type.id(), value.toString());
+		}
+
+		return qHashMulti(seed, type.id());
+	}
+}
+
+// Identity of a value when matching the old and new value list.
+struct ValueKey {
+	explicit ValueKey(const QVariant& value)
+	    : value(
+	          // JS values are compared by their contents
+	          value.metaType() == QMetaType::fromType<QJSValue>()
+	              ? value.value<QJSValue>().toVariant()
+	              : value
+	      )
+	    , hash(variantHash(this->value)) {}
+
+	QVariant value;
+	size_t hash;
+
+	[[nodiscard]] bool operator==(const ValueKey& other) const {
+		return this->hash == other.hash && this->value == other.value;
+	}
+};
+
+size_t qHash(const ValueKey& key, size_t seed = 0) { return qHashMulti(seed, key.hash); }
+
+// Binary indexed tree over item presence, used to find the current row of an item by its
+// order key in logarithmic time.
+class PresenceTree {
+public:
+	explicit PresenceTree(qsizetype size): tree(size + 1, 0) {}
 
-	while (true) {
-		if (newIter == newValues.end()) {
-			if (iter == this->mValues.end()) break;
+	void add(qsizetype index, qsizetype delta) {
+		for (auto i = index + 1; i < this->tree.size(); i += i & -i) {
+			this->tree[i] += delta;
+		}
+	}
+
+	// Number of present items before index.
+	[[nodiscard]] qsizetype countBefore(qsizetype index) const {
+		qsizetype count = 0;
+		for (auto i = index; i > 0; i -= i & -i) {
+			count += this->tree.at(i);
+		}
+
+		return count;
+	}
+
+private:
+	QVector<qsizetype> tree;
+};
+
+} // namespace
+
+void ScriptModel::updateValues(const QVariantList& newValues) {
+	const auto oldSize = this->mValues.size();
+	const auto newSize = newValues.size();
+
+	auto keyName = this->mKey.toUtf8();
+	auto valueKey = [&](const QVariant& value) {
+		if (!keyName.isEmpty()) {
+			auto key = QVariant();
+			auto type = value.metaType();
+
+			if (type.flags() & QMetaType::PointerToQObject) {
+				if (auto* object = value.value<QObject*>()) key = object->property(keyName.constData());
+			} else if (type.id() == QMetaType::QVariantMap) {
+				key = value.toMap().value(this->mKey);
+			} else if (type == QMetaType::fromType<QJSValue>()) {
+				key = value.value<QJSValue>().property(this->mKey).toVariant();
+			}
+
+			if (key.isValid()) return ValueKey(key);
+		}
+
+		return ValueKey(value);
+	};
+
+	// Match each new value to the first unmatched old value with the same key.
+	auto newToOld = QVector<qsizetype>(newSize, -1);
+	auto oldKept = QVector<bool>(oldSize, false);
+
+	{
+		auto firstUnmatched = QHash<ValueKey, qsizetype>();
+		firstUnmatched.reserve(oldSize);
+		auto nextOccurrence = QVector<qsizetype>(oldSize, -1);
 
-			auto startIndex = static_cast<qint32>(newValues.length());
-			auto endIndex = static_cast<qint32>(this->mValues.length() - 1);
+		for (auto i = oldSize - 1; i >= 0; i--) {
+			auto key = valueKey(this->mValues.at(i));
+			auto iter = firstUnmatched.find(key);
 
-			this->beginRemoveRows(QModelIndex(), startIndex, endIndex);
-			this->mValues.erase(iter, this->mValues.end());
-			this->endRemoveRows();
+			if (iter == firstUnmatched.end()) {
+				firstUnmatched.insert(std::move(key), i);
+			} else {
+				nextOccurrence[i] = *iter;
+				*iter = i;
+			}
+		}
+
+		for (qsizetype j = 0; j != newSize; j++) {
+			auto iter = firstUnmatched.find(valueKey(newValues.at(j)));
+			if (iter == firstUnmatched.end() || *iter == -1) continue;
+
+			newToOld[j] = *iter;
+			oldKept[*iter] = true;
+			*iter = nextOccurrence.at(*iter);
+		}
+	}
+
+	// Removing from the back keeps the indices of earlier runs valid.
+	for (auto i = oldSize - 1; i >= 0;) {
+		if (oldKept.at(i)) {
+			i--;
+			continue;
+		}
 
-			break;
-		} else if (iter == this->mValues.end()) {
-			// Prior branch ensures length is at least 1.
-			auto startIndex = static_cast<qint32>(this->mValues.length());
-			auto endIndex = static_cast<qint32>(newValues.length() - 1);
+		auto last = i;
+		while (i >= 0 && !oldKept.at(i)) i--;
+		auto first = i + 1;
 
-			this->beginInsertRows(QModelIndex(), startIndex, endIndex);
-			this->mValues.append(newValues.sliced(startIndex));
+		this->beginRemoveRows(QModelIndex(), static_cast<qint32>(first), static_cast<qint32>(last));
+		this->mValues.remove(first, last - first + 1);
+		this->endRemoveRows();
+	}
+
+	// Kept values forming the longest increasing subsequence of old indices (in new order) are
+	// already in the right relative order and never move. Every other kept value moves once.
+	auto stable = QVector<bool>(newSize, false);
+
+	{
+		// new index ending the lowest tail of each subsequence length
+		auto tails = QVector<qsizetype>();
+		auto predecessor = QVector<qsizetype>(newSize, -1);
+
+		for (qsizetype j = 0; j != newSize; j++) {
+			auto oldIndex = newToOld.at(j);
+			if (oldIndex == -1) continue;
+
+			auto tailOldIndex = [&](qsizetype tail) { return newToOld.at(tail); };
+			auto pos = std::ranges::lower_bound(tails, oldIndex, {}, tailOldIndex) - tails.begin();
+
+			if (pos != 0) predecessor[j] = tails.at(pos - 1);
+			if (pos == tails.size()) tails.push_back(j);
+			else tails[pos] = j;
+		}
+
+		for (auto j = tails.isEmpty() ? -1 : tails.last(); j != -1; j = predecessor.at(j)) {
+			stable[j] = true;
+		}
+	}
+
+	// Every item gets an order key for its position before and after it is placed, such that
+	// the current list is always sorted by key. Unplaced items are keyed by their old index,
+	// and placed items sit in a gap directly before the next stable item in the new list.
+	// Rows can then be located by counting present keys, in any order of operations.
+	const auto stride = static_cast<qint64>(newSize) + 1;
+	auto oldKey = [&](qsizetype oldIndex) { return oldIndex * stride + newSize; };
+	auto newKeys = QVector<qint64>(newSize);
+
+	{
+		auto gap = oldSize;
+		qsizetype gapCount = 0;
+
+		for (auto j = newSize - 1; j >= 0; j--) {
+			if (stable.at(j)) {
+				gap = newToOld.at(j);
+				gapCount = 0;
+				newKeys[j] = oldKey(gap);
+			} else {
+				newKeys[j] = gap * stride + newSize - ++gapCount;
+			}
+		}
+	}
+
+	auto keys = QVector<qint64>();
+	keys.reserve(oldSize + newSize);
+
+	for (qsizetype i = 0; i != oldSize; i++) {
+		if (oldKept.at(i)) keys.push_back(oldKey(i));
+	}
+
+	for (qsizetype j = 0; j != newSize; j++) {
+		if (!stable.at(j)) keys.push_back(newKeys.at(j));
+	}
+
+	std::ranges::sort(keys);
+
+	auto rank = [&](qint64 key) { return std::ranges::lower_bound(keys, key) - keys.begin(); };
+	auto present = PresenceTree(keys.size());
+	auto rowOf = [&](qint64 key) { return present.countBefore(rank(key)); };
+
+	for (qsizetype i = 0; i != oldSize; i++) {
+		if (oldKept.at(i)) present.add(rank(oldKey(i)), 1);
+	}
+
+	for (qsizetype j = 0; j != newSize;) {
+		if (stable.at(j)) {
+			j++;
+			continue;
+		}
+
+		auto end = j + 1;
+		auto dest = rowOf(newKeys.at(j));
+
+		if (newToOld.at(j) == -1) {
+			while (end != newSize && newToOld.at(end) == -1) end++;
+			auto len = end - j;
+
+			this->beginInsertRows(
+			    QModelIndex(),
+			    static_cast<qint32>(dest),
+			    static_cast<qint32>(dest + len - 1)
+			);
+
+			this->mValues.insert(dest, len, QVariant());
+			std::copy(newValues.begin() + j, newValues.begin() + end, this->mValues.begin() + dest);
 			this->endInsertRows();
 
-			break;
-		} else if (*newIter != *iter) {
-			auto oldIter = std::find(iter, this->mValues.end(), *newIter);
+			for (auto k = j; k != end; k++) {
+				present.add(rank(newKeys.at(k)), 1);
+			}
+		} else {
+			auto source = rowOf(oldKey(newToOld.at(j)));
+
+			// Capture items that are adjacent in both lists as a single move.
+			while (end != newSize && !stable.at(end) && newToOld.at(end) != -1
+			       && rowOf(oldKey(newToOld.at(end))) == source + (end - j))
+			{
+				end++;
+			}
 
-			if (oldIter != this->mValues.end()) {
-				if (std::find(newIter, newValues.end(), *iter) == newValues.end()) {
-					// Remove any entries we would otherwise move around that aren't in the new list.
-					auto startIter = iter;
+			auto len = end - j;
 
-					do {
-						++iter;
-					} while (iter != this->mValues.end()
-					         && std::find(newIter, newValues.end(), *iter) == newValues.end());
+			// A move into its own range can happen if the items in between are moved later.
+			if (dest < source || dest > source + len) {
+				this->beginMoveRows(
+				    QModelIndex(),
+				    static_cast<qint32>(source),
+				    static_cast<qint32>(source + len - 1),
+				    QModelIndex(),
+				    static_cast<qint32>(dest)
+				);
 
-					auto index = static_cast<qint32>(std::distance(this->mValues.begin(), iter));
-					auto startIndex = static_cast<qint32>(std::distance(this->mValues.begin(), startIter));
+				auto begin = this->mValues.begin();
 
-					this->beginRemoveRows(QModelIndex(), startIndex, index - 1);
-					iter = this->mValues.erase(startIter, iter);
-					this->endRemoveRows();
+				if (dest > source) {
+					std::rotate(begin + source, begin + source + len, begin + dest);
 				} else {
-					// Advance iters to capture a whole move sequence as a single operation if possible.
-					auto oldStartIter = oldIter;
-					do {
-						++oldIter;
-						++newIter;
-					} while (oldIter != this->mValues.end() && newIter != newValues.end()
-					         && *oldIter == *newIter);
-
-					auto index = static_cast<qint32>(std::distance(this->mValues.begin(), iter));
-					auto oldStartIndex =
-					    static_cast<qint32>(std::distance(this->mValues.begin(), oldStartIter));
-					auto oldIndex = static_cast<qint32>(std::distance(this->mValues.begin(), oldIter));
-					auto len = oldIndex - oldStartIndex;
-
-					this->beginMoveRows(QModelIndex(), oldStartIndex, oldIndex - 1, QModelIndex(), index);
-
-					// While it is possible to optimize this further, it is currently not worth the time.
-					for (auto i = 0; i != len; i++) {
-						this->mValues.move(oldStartIndex + i, index + i);
-					}
-
-					iter = this->mValues.begin() + (index + len);
-					this->endMoveRows();
+					std::rotate(begin + dest, begin + source, begin + source + len);
 				}
-			} else {
-				auto startNewIter = newIter;
-
-				do {
-					newIter++;
-				} while (newIter != newValues.end()
-				         && std::find(iter, this->mValues.end(), *newIter) == this->mValues.end());
-
-				auto index = static_cast<qint32>(std::distance(this->mValues.begin(), iter));
-				auto newIndex = static_cast<qint32>(std::distance(newValues.begin(), newIter));
-				auto startNewIndex = static_cast<qint32>(std::distance(newValues.begin(), startNewIter));
-				auto len = newIndex - startNewIndex;
-
-				this->beginInsertRows(QModelIndex(), index, index + len - 1);
-#if QT_VERSION <= QT_VERSION_CHECK(6, 8, 0)
-				this->mValues.resize(this->mValues.length() + len);
-#else
-				this->mValues.resizeForOverwrite(this->mValues.length() + len);
-#endif
-				iter = this->mValues.begin() + index; // invalidated
-				std::move_backward(iter, this->mValues.end() - len, this->mValues.end());
-				iter = std::copy(startNewIter, newIter, iter);
-				this->endInsertRows();
+
+				this->endMoveRows();
 			}
-		} else {
-			++iter;
-			++newIter;
+
+			for (auto k = j; k != end; k++) {
+				present.add(rank(oldKey(newToOld.at(k))), -1);
+				present.add(rank(newKeys.at(k)), 1);
+			}
+		}
+
+		j = end;
+	}
+
+	// Values matched by key may differ in other properties.
+	if (!keyName.isEmpty()) {
+		for (qsizetype j = 0; j != newSize;) {
+			if (this->mValues.at(j) == newValues.at(j)) {
+				j++;
+				continue;
+			}
+
+			auto first = j;
+			for (; j != newSize && this->mValues.at(j) != newValues.at(j); j++) {
+				this->mValues[j] = newValues.at(j);
+			}
+
+			emit this->dataChanged(
+			    this->index(static_cast<qint32>(first)),
+			    this->index(static_cast<qint32>(j - 1)),
+			    {Qt::UserRole}
+			);
 		}
 	}
 }
 
 void ScriptModel::setValues(const QVariantList& newValues) {
 	if (newValues == this->mValues) return;
-	this->updateValuesUnique(newValues);
+	this->updateValues(newValues);
 	emit this->valuesChanged();
 }
 
+void ScriptModel::setKey(const QString& key) {
+	if (key == this->mKey) return;
+	this->mKey = key;
+	emit this->keyChanged();
+}
+
 qint32 ScriptModel::rowCount(const QModelIndex& parent) const {
 	if (parent != QModelIndex()) return 0;
 	return static_cast<qint32>(this->mValues.length());
@@ -41,8 +41,9 @@
 class ScriptModel: public QAbstractListModel {
 	Q_OBJECT;
 	/// The list of values to reflect in the model.
-	/// > [!WARNING] ScriptModel currently only works with lists of *unique* values.
-	/// > There must not be any duplicates in the given list, or behavior of the model is undefined.
+	///
+	/// When the list changes, values are matched against the previous list by equality,
+	/// or by @@key if set. Duplicate values are matched in order of appearance.
 	///
 	/// > [!TIP] @@ObjectModel$s supplied by Quickshell types will only contain unique values,
 	/// > and can be used like so:
@@ -67,21 +68,42 @@ class ScriptModel: public QAbstractListModel {
 	/// > }
 	/// > ```
 	Q_PROPERTY(QVariantList values READ values WRITE setValues NOTIFY valuesChanged);
+	/// The name of a property identifying each value, such as `"id"`. Defaults to empty,
+	/// which identifies values by equality.
+	///
+	/// If set, values of the old and new list with the same key are treated as the same entry,
+	/// even if other properties changed. The entry is updated in place instead of being removed
+	/// and re-added, which keeps its delegate alive. Values without the property, or that are
+	/// not objects, are identified by equality.
+	///
+	/// ```qml
+	/// ScriptModel {
+	///   key: "pid"
+	///   // process objects are recreated on every update, but delegates are reused by pid
+	///   values: processes.map(p => ({ pid: p.pid, cpu: p.cpu }))
+	/// }
+	/// ```
+	Q_PROPERTY(QString key READ key WRITE setKey NOTIFY keyChanged);
 	QML_ELEMENT;
 
 public:
 	[[nodiscard]] const QVariantList& values() const { return this->mValues; }
 	void setValues(const QVariantList& newValues);
 
+	[[nodiscard]] QString key() const { return this->mKey; }
+	void setKey(const QString& key);
+
 	[[nodiscard]] qint32 rowCount(const QModelIndex& parent) const override;
 	[[nodiscard]] QVariant data(const QModelIndex& index, qint32 role) const override;
 	[[nodiscard]] QHash<int, QByteArray> roleNames() const override;
 
 signals:
 	void valuesChanged();
+	void keyChanged();
 
 private:
 	QVariantList mValues;
+	QString mKey;
 
-	void updateValuesUnique(const QVariantList& newValues);
+	void updateValues(const QVariantList& newValues);
 };
@@ -0,0 +1,542 @@
+#include "spawn.hpp"
+
+#include <array>
+#include <cerrno>
+#include <csignal>
+#include <utility>
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <qbytearray.h>
+#include <qcontainerfwd.h>
+#include <qdebug.h>
+#include <qelapsedtimer.h>
+#include <qlogging.h>
+#include <qloggingcategory.h>
+#include <qnamespace.h>
+#include <qobject.h>
+#include <qprocess.h>
+#include <qsocketnotifier.h>
+#include <qtimer.h>
+#include <qtmetamacros.h>
+#include <qtypes.h>
+#include <spawn.h>
+#include <sys/types.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char** environ; // NOLINT
+
+namespace {
+Q_LOGGING_CATEGORY(logSpawn, "quickshell.spawn", QtWarningMsg);
+
+// Used when pidfds are not available.
+constexpr int EXIT_POLL_INTERVAL_MS = 50;
+// Upper bound on the amount read from a channel per event loop iteration.
+constexpr int MAX_READS_PER_NOTIFY = 16;
+
+int openPidFd(pid_t pid) {
+#ifdef SYS_pidfd_open
+	return static_cast<int>(syscall(SYS_pidfd_open, pid, 0));
+#else
+	Q_UNUSED(pid);
+	errno = ENOSYS;
+	return -1;
+#endif
+}
+
+void closeFd(int& fd) {
+	if (fd == -1) return;
+	close(fd);
+	fd = -1;
+}
+
+// Writes to a pipe without raising SIGPIPE if the reader has exited, which would otherwise
+// kill quickshell. SIGPIPE is blocked for the calling thread during the write and a SIGPIPE
+// raised by it is consumed, leaving the process wide disposition untouched.
+ssize_t writeNoSigpipe(int fd, const char* data, size_t size) {
+	sigset_t sigpipe;
+	sigemptyset(&sigpipe);
+	sigaddset(&sigpipe, SIGPIPE);
+
+	// a SIGPIPE already pending was not caused by this write and must be left alone
+	sigset_t pending;
+	sigpending(&pending);
+	auto wasPending = sigismember(&pending, SIGPIPE) == 1;
+
+	sigset_t oldMask;
+	pthread_sigmask(SIG_BLOCK, &sigpipe, &oldMask);
+
+	auto written = ::write(fd, data, size);
+	auto error = errno;
+
+	if (written == -1 && error == EPIPE && !wasPending) {
+		const timespec timeout {};
+		while (sigtimedwait(&sigpipe, nullptr, &timeout) == -1 && errno == EINTR) {}
+	}
+
+	pthread_sigmask(SIG_SETMASK, &oldMask, nullptr);
+
+	errno = error;
+	return written;
+}
+
+// Reaps a killed child from the event loop instead of blocking until it has exited.
+// Takes ownership of pidFd.
+void reapLater(pid_t pid, int pidFd) {
+	if (waitpid(pid, nullptr, WNOHANG) != 0) {
+		closeFd(pidFd);
+		return;
+	}
+
+	if (pidFd != -1) {
+		auto* notifier = new QSocketNotifier(pidFd, QSocketNotifier::Read);
+
+		QObject::connect(notifier, &QSocketNotifier::activated, notifier, [=]() {
+			if (waitpid(pid, nullptr, WNOHANG) == 0) return;
+			notifier->setEnabled(false);
+			notifier->deleteLater();
+			close(pidFd);
+		});
+	} else {
+		auto* timer = new QTimer();
+
+		QObject::connect(timer, &QTimer::timeout, timer, [=]() {
+			if (waitpid(pid, nullptr, WNOHANG) == 0) return;
+			timer->stop();
+			timer->deleteLater();
+		});
+
+		timer->start(EXIT_POLL_INTERVAL_MS);
+	}
+}
+
+// NUL terminated list of pointers into `storage`, valid while storage is alive.
+QList<char*> toArgv(const QList<QByteArray>& storage) {
+	auto argv = QList<char*>();
+	argv.reserve(storage.size() + 1);
+
+	for (const auto& arg: storage) {
+		argv.push_back(const_cast<char*>(arg.constData())); // NOLINT
+	}
+
+	argv.push_back(nullptr);
+	return argv;
+}
+
+struct SpawnChannel {
+	std::array<int, 2> pipe = {-1, -1};
+
+	[[nodiscard]] int parentEnd(bool input) const { return input ? this->pipe[1] : this->pipe[0]; }
+	[[nodiscard]] int childEnd(bool input) const { return input ? this->pipe[0] : this->pipe[1]; }
+
+	void closeAll() {
+		closeFd(this->pipe[0]);
+		closeFd(this->pipe[1]);
+	}
+};
+
+} // namespace
+
+SpawnedProcess::~SpawnedProcess() {
+	if (this->pid != -1) {
+		::kill(static_cast<pid_t>(this->pid), SIGKILL);
+
+		// the pidfd is handed over to the reaper
+		delete this->exitNotifier;
+		this->exitNotifier = nullptr;
+		reapLater(static_cast<pid_t>(this->pid), this->pidFd);
+		this->pidFd = -1;
+	}
+
+	this->closeFds();
+}
+
+void SpawnedProcess::setProcessEnvironment(const QProcessEnvironment& environment) {
+	this->mEnvironment = environment.toStringList();
+	this->hasEnvironment = true;
+}
+
+bool SpawnedProcess::startDetached(
+    QString program,
+    QList<QString> arguments,
+    QString workingDirectory,
+    qint64* pid
+) {
+	auto process = SpawnedProcess();
+	process.setProgram(std::move(program));
+	process.setArguments(std::move(arguments));
+	process.setWorkingDirectory(std::move(workingDirectory));
+
+	if (!process.spawn(true)) return false;
+	if (pid != nullptr) *pid = process.pid;
+
+	// the process is handed to the reaper, and is no longer tracked once it has exited
+	reapLater(static_cast<pid_t>(process.pid), openPidFd(static_cast<pid_t>(process.pid)));
+	process.pid = -1;
+	return true;
+}
+
+bool SpawnedProcess::start() { return this->spawn(false); }
+
+bool SpawnedProcess::spawn(bool detached) {
+	if (this->pid != -1) return false;
+
+	auto timer = QElapsedTimer();
+	timer.start();
+
+	auto channels = std::array<SpawnChannel, 3>();
+	const auto enabled = std::array<bool, 3> {
+	    this->stdinEnabled && !detached,
+	    this->stdoutEnabled && !detached,
+	    this->stderrEnabled && !detached,
+	};
+
+	posix_spawn_file_actions_t actions;
+	posix_spawn_file_actions_init(&actions);
+
+	posix_spawnattr_t attr;
+	posix_spawnattr_init(&attr);
+
+	// Signals blocked or ignored by quickshell must not leak into the child.
+	sigset_t mask;
+	sigemptyset(&mask);
+	posix_spawnattr_setsigmask(&attr, &mask);
+
+	sigset_t defaults;
+	sigemptyset(&defaults);
+	sigaddset(&defaults, SIGPIPE);
+	sigaddset(&defaults, SIGCHLD);
+	sigaddset(&defaults, SIGINT);
+	sigaddset(&defaults, SIGTERM);
+	sigaddset(&defaults, SIGHUP);
+	posix_spawnattr_setsigdefault(&attr, &defaults);
+
+	short flags = POSIX_SPAWN_SETSIGMASK | POSIX_SPAWN_SETSIGDEF;
+
+#ifdef POSIX_SPAWN_SETSID
+	// keeps detached processes out of quickshell's session, so they don't receive its signals
+	if (detached) flags |= POSIX_SPAWN_SETSID;
+#endif
+
+	auto failed = false;
+
+	for (auto i = 0; i != 3; i++) {
+		auto input = i == STDIN_FILENO;
+		auto& channel = channels.at(i);
+
+		if (!enabled.at(i)) {
+			posix_spawn_file_actions_addopen(
+			    &actions,
+			    i,
+			    "/dev/null",
+			    input ? O_RDONLY : O_WRONLY,
+			    0
+			);
+
+			continue;
+		}
+
+		if (pipe2(channel.pipe.data(), O_CLOEXEC) == -1) {
+			qCWarning(logSpawn) << "Failed to create pipe for" << this->mProgram
+			                    << qt_error_string(errno);
+			failed = true;
+			break;
+		}
+
+		// dup2 clears O_CLOEXEC on the target fd
+		posix_spawn_file_actions_adddup2(&actions, channel.childEnd(input), i);
+		fcntl(channel.parentEnd(input), F_SETFL, O_NONBLOCK);
+	}
+
+	posix_spawnattr_setflags(&attr, flags);
+
+	auto program = this->mProgram.toLocal8Bit();
+
+	auto argStorage = QList<QByteArray>();
+	argStorage.reserve(this->mArguments.size() + 1);
+	argStorage.push_back(program);
+	for (const auto& arg: this->mArguments) {
+		argStorage.push_back(arg.toLocal8Bit());
+	}
+
+	auto workingDirectory = this->mWorkingDirectory.toLocal8Bit();
+	if (!workingDirectory.isEmpty()) {
+#ifdef QS_SPAWN_ADDCHDIR
+		posix_spawn_file_actions_addchdir_np(&actions, workingDirectory.constData());
+#else
+		// Without posix_spawn_file_actions_addchdir_np (glibc < 2.29) a shell changes the working
+		// directory before executing the program. A missing program is then reported as exit
+		// code 127 instead of a failure to start.
+		auto shellArgs = QList<QByteArray> {
+		    "/bin/sh",
+		    "-c",
+		    R"(cd -- "$1" && shift && exec "$@")",
+		    "sh",
+		    workingDirectory,
+		};
+
+		argStorage = shellArgs + argStorage;
+		program = "/bin/sh";
+#endif
+	}
+
+	auto envStorage = QList<QByteArray>();
+	if (this->hasEnvironment) {
+		envStorage.reserve(this->mEnvironment.size());
+		for (const auto& var: this->mEnvironment) {
+			envStorage.push_back(var.toLocal8Bit());
+		}
+	}
+
+	auto argv = toArgv(argStorage);
+	auto envp = this->hasEnvironment ? toArgv(envStorage) : QList<char*>();
+
+	pid_t child = -1;
+	auto error = 0;
+
+	if (!failed) {
+		error = posix_spawnp(
+		    &child,
+		    program.constData(),
+		    &actions,
+		    &attr,
+		    argv.data(),
+		    this->hasEnvironment ? envp.data() : environ
+		);
+	}
+
+	posix_spawn_file_actions_destroy(&actions);
+	posix_spawnattr_destroy(&attr);
+
+	for (auto i = 0; i != 3; i++) {
+		auto input = i == STDIN_FILENO;
+		closeFd(channels.at(i).pipe.at(input ? 0 : 1));
+	}
+
+	if (failed || error != 0) {
+		for (auto& channel: channels) channel.closeAll();
+
+		if (error != 0) {
+			qCWarning(logSpawn) << "Failed to start" << this->mProgram << qt_error_string(error);
+		}
+
+		return false;
+	}
+
+	this->pid = child;
+
+	if (detached) {
+		qCDebug(logSpawn) << "Spawned detached" << this->mProgram << "as pid" << child << "in"
+		                  << timer.nsecsElapsed() / 1000 << "us";
+		return true;
+	}
+
+	this->stdinFd = channels.at(STDIN_FILENO).parentEnd(true);
+	this->stdoutFd = channels.at(STDOUT_FILENO).parentEnd(false);
+	this->stderrFd = channels.at(STDERR_FILENO).parentEnd(false);
+
+	if (this->stdoutFd != -1) {
+		this->stdoutNotifier = new QSocketNotifier(this->stdoutFd, QSocketNotifier::Read, this);
+		QObject::connect(
+		    this->stdoutNotifier,
+		    &QSocketNotifier::activated,
+		    this,
+		    &SpawnedProcess::onStdoutReadable
+		);
+	}
+
+	if (this->stderrFd != -1) {
+		this->stderrNotifier = new QSocketNotifier(this->stderrFd, QSocketNotifier::Read, this);
+		QObject::connect(
+		    this->stderrNotifier,
+		    &QSocketNotifier::activated,
+		    this,
+		    &SpawnedProcess::onStderrReadable
+		);
+	}
+
+	if (this->stdinFd != -1) {
+		this->stdinNotifier = new QSocketNotifier(this->stdinFd, QSocketNotifier::Write, this);
+		this->stdinNotifier->setEnabled(false);
+		QObject::connect(
+		    this->stdinNotifier,
+		    &QSocketNotifier::activated,
+		    this,
+		    &SpawnedProcess::onStdinWritable
+		);
+	}
+
+	this->pidFd = openPidFd(child);
+
+	if (this->pidFd != -1) {
+		fcntl(this->pidFd, F_SETFD, FD_CLOEXEC);
+		this->exitNotifier = new QSocketNotifier(this->pidFd, QSocketNotifier::Read, this);
+		QObject::connect(
+		    this->exitNotifier,
+		    &QSocketNotifier::activated,
+		    this,
+		    &SpawnedProcess::onExitNotify
+		);
+	} else {
+		qCDebug(logSpawn) << "pidfd unavailable, polling for exit of pid" << child
+		                  << qt_error_string(errno);
+
+		this->exitPollTimer = new QTimer(this);
+		QObject::connect(
+		    this->exitPollTimer,
+		    &QTimer::timeout,
+		    this,
+		    &SpawnedProcess::onExitNotify
+		);
+		this->exitPollTimer->start(EXIT_POLL_INTERVAL_MS);
+	}
+
+	qCDebug(logSpawn) << "Spawned" << this->mProgram << "as pid" << child << "in"
+	                  << timer.nsecsElapsed() / 1000 << "us";
+
+	this->lifetime.start();
+	QMetaObject::invokeMethod(this, &SpawnedProcess::started, Qt::QueuedConnection);
+	return true;
+}
+
+void SpawnedProcess::signal(qint32 signal) const {
+	if (this->pid == -1) return;
+	::kill(static_cast<pid_t>(this->pid), signal);
+}
+
+void SpawnedProcess::terminate() const { this->signal(SIGTERM); }
+
+void SpawnedProcess::write(const QByteArray& data) {
+	if (this->stdinFd == -1 || this->stdinCloseRequested) return;
+	this->writeBuffer.append(data);
+	this->onStdinWritable();
+}
+
+void SpawnedProcess::closeWriteChannel() {
+	this->stdinCloseRequested = true;
+	if (this->writeBuffer.isEmpty()) this->closeStdinFd();
+}
+
+void SpawnedProcess::onStdinWritable() {
+	while (!this->writeBuffer.isEmpty()) {
+		auto written =
+		    writeNoSigpipe(this->stdinFd, this->writeBuffer.constData(), this->writeBuffer.size());
+
+		if (written > 0) {
+			this->writeBuffer.remove(0, written);
+		} else if (written == -1 && errno == EINTR) {
+			continue;
+		} else if (written == -1 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+			this->stdinNotifier->setEnabled(true);
+			return;
+		} else {
+			qCDebug(logSpawn) << "Failed to write to stdin of pid" << this->pid << qt_error_string(errno);
+			this->writeBuffer.clear();
+			this->closeStdinFd();
+			return;
+		}
+	}
+
+	if (this->stdinNotifier) this->stdinNotifier->setEnabled(false);
+	if (this->stdinCloseRequested) this->closeStdinFd();
+}
+
+void SpawnedProcess::onStdoutReadable() {
+	this->readChannel(this->stdoutFd, this->stdoutNotifier, this->stdoutClosed, true);
+}
+
+void SpawnedProcess::onStderrReadable() {
+	this->readChannel(this->stderrFd, this->stderrNotifier, this->stderrClosed, false);
+}
+
+void SpawnedProcess::readChannel(int& fd, QSocketNotifier*& notifier, bool closed, bool isStdout) {
+	if (fd == -1) return;
+
+	auto buffer = std::array<char, 16384>();
+	auto data = QByteArray();
+	auto eof = false;
+
+	for (auto i = 0; i != MAX_READS_PER_NOTIFY; i++) {
+		auto count = read(fd, buffer.data(), buffer.size());
+
+		if (count > 0) {
+			if (!closed) data.append(buffer.data(), count);
+		} else if (count == -1 && errno == EINTR) {
+			continue;
+		} else {
+			eof = count == 0 || (errno != EAGAIN && errno != EWOULDBLOCK);
+			break;
+		}
+	}
+
+	if (eof) {
+		delete notifier;
+		notifier = nullptr;
+		closeFd(fd);
+	}
+
+	if (!data.isEmpty()) {
+		if (isStdout) emit this->stdoutRead(data);
+		else emit this->stderrRead(data);
+	}
+}
+
+void SpawnedProcess::onExitNotify() {
+	if (this->pid == -1) return;
+
+	auto status = 0;
+	auto result = waitpid(static_cast<pid_t>(this->pid), &status, WNOHANG);
+
+	if (result == 0 || (result == -1 && errno == EINTR)) return;
+
+	auto exitCode = -1;
+	auto exitStatus = QProcess::CrashExit;
+
+	if (result == -1) {
+		qCWarning(logSpawn) << "Failed to reap pid" << this->pid << qt_error_string(errno);
+	} else if (WIFEXITED(status)) {
+		exitCode = WEXITSTATUS(status);
+		exitStatus = QProcess::NormalExit;
+	} else if (WIFSIGNALED(status)) {
+		exitCode = WTERMSIG(status);
+	}
+
+	qCDebug(logSpawn) << "Pid" << this->pid << "exited with code" << exitCode << "after"
+	                  << this->lifetime.elapsed() << "ms";
+
+	// deliver output written right before exiting
+	this->onStdoutReadable();
+	this->onStderrReadable();
+
+	this->pid = -1;
+	this->closeFds();
+
+	emit this->finished(exitCode, exitStatus);
+}
+
+void SpawnedProcess::closeStdinFd() {
+	delete this->stdinNotifier;
+	this->stdinNotifier = nullptr;
+	closeFd(this->stdinFd);
+}
+
+void SpawnedProcess::closeFds() {
+	this->closeStdinFd();
+
+	delete this->stdoutNotifier;
+	this->stdoutNotifier = nullptr;
+	closeFd(this->stdoutFd);
+
+	delete this->stderrNotifier;
+	this->stderrNotifier = nullptr;
+	closeFd(this->stderrFd);
+
+	delete this->exitNotifier;
+	this->exitNotifier = nullptr;
+	closeFd(this->pidFd);
+
+	delete this->exitPollTimer;
+	this->exitPollTimer = nullptr;
+}
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <utility>
+
+#include <qbytearray.h>
+#include <qcontainerfwd.h>
+#include <qelapsedtimer.h>
+#include <qobject.h>
+#include <qprocess.h>
+#include <qsocketnotifier.h>
+#include <qtclasshelpermacros.h>
+#include <qtimer.h>
+#include <qtmetamacros.h>
+#include <qtypes.h>
+
+// A child process started with posix_spawn.
+//
+// Unlike QProcess, which forks the whole process, posix_spawn uses vfork semantics and does
+// not copy quickshell's page tables, which is significantly cheaper for a large process.
+// Process exit is observed through a pidfd in the event loop, falling back to polling if
+// pidfds are unsupported by the kernel.
+class SpawnedProcess: public QObject {
+	Q_OBJECT;
+
+public:
+	explicit SpawnedProcess(QObject* parent = nullptr): QObject(parent) {}
+	// Kills the process if it is still running. It is reaped from the event loop once it exits.
+	~SpawnedProcess() override;
+	Q_DISABLE_COPY_MOVE(SpawnedProcess);
+
+	void setProgram(QString program) { this->mProgram = std::move(program); }
+	void setArguments(QList<QString> arguments) { this->mArguments = std::move(arguments); }
+	void setWorkingDirectory(QString directory) { this->mWorkingDirectory = std::move(directory); }
+	void setProcessEnvironment(const QProcessEnvironment& environment);
+
+	// Channels that are not enabled are connected to /dev/null. Must be called before start().
+	void setStdinEnabled(bool enabled) { this->stdinEnabled = enabled; }
+	void setStdoutEnabled(bool enabled) { this->stdoutEnabled = enabled; }
+	void setStderrEnabled(bool enabled) { this->stderrEnabled = enabled; }
+
+	// Starts the process. Returns false if it could not be started, e.g. if the program
+	// was not found. `started` is emitted from the event loop after a successful start.
+	bool start();
+
+	// Starts a process in its own session with all channels connected to /dev/null, without
+	// tracking it further. It is reaped from the event loop once it exits.
+	// Returns false if it could not be started. The pid is written to `pid` if given.
+	static bool startDetached(
+	    QString program,
+	    QList<QString> arguments,
+	    QString workingDirectory = QString(),
+	    qint64* pid = nullptr
+	);
+
+	[[nodiscard]] bool isRunning() const { return this->pid != -1; }
+	[[nodiscard]] qint64 processId() const { return this->pid; }
+
+	void signal(qint32 signal) const;
+	void terminate() const;
+
+	// Queues data to be written to stdin. Does nothing if stdin is not enabled or closed.
+	void write(const QByteArray& data);
+	// Closes stdin once all queued data has been written.
+	void closeWriteChannel();
+
+	// Stops delivering output of the given channel. Output is still read and discarded so
+	// the child does not block or receive SIGPIPE.
+	void closeStdout() { this->stdoutClosed = true; }
+	void closeStderr() { this->stderrClosed = true; }
+
+signals:
+	void started();
+	void stdoutRead(const QByteArray& data);
+	void stderrRead(const QByteArray& data);
+	void finished(qint32 exitCode, QProcess::ExitStatus exitStatus);
+
+private slots:
+	void onExitNotify();
+	void onStdoutReadable();
+	void onStderrReadable();
+	void onStdinWritable();
+
+private:
+	bool spawn(bool detached);
+	void readChannel(int& fd, QSocketNotifier*& notifier, bool closed, bool isStdout);
+	void closeStdinFd();
+	void closeFds();
+
+	QString mProgram;
+	QList<QString> mArguments;
+	QString mWorkingDirectory;
+	QList<QString> mEnvironment;
+	bool hasEnvironment = false;
+
+	bool stdinEnabled = false;
+	bool stdoutEnabled = false;
+	bool stderrEnabled = false;
+	bool stdoutClosed = false;
+	bool stderrClosed = false;
+	bool stdinCloseRequested = false;
+
+	qint64 pid = -1;
+	int pidFd = -1;
+	int stdinFd = -1;
+	int stdoutFd = -1;
+	int stderrFd = -1;
+	QSocketNotifier* exitNotifier = nullptr;
+	QSocketNotifier* stdinNotifier = nullptr;
+	QSocketNotifier* stdoutNotifier = nullptr;
+	QSocketNotifier* stderrNotifier = nullptr;
+	QTimer* exitPollTimer = nullptr;
+	QByteArray writeBuffer;
+	QElapsedTimer lifetime;
+
+	friend class TestSpawnedProcess;
+};
@@ -0,0 +1,264 @@
+#include "delegatepool.hpp"
+
+#include <qcontainerfwd.h>
+#include <qobject.h>
+#include <qpointer.h>
+#include <qqmlcomponent.h>
+#include <qqmlengine.h>
+#include <qqmlincubator.h>
+#include <qsignalspy.h>
+#include <qtest.h>
+#include <qtestcase.h>
+#include <qurl.h>
+#include <qvariant.h>
+
+#include "../delegatepool.hpp"
+#include "../variants.hpp"
+
+namespace {
+
+constexpr auto DELEGATE = "import QtQml\n"
+                          "QtObject {\n"
+                          "  property var modelData\n"
+                          "  property string kind: \"a\"\n"
+                          "  property int pooledCount: 0\n"
+                          "  property int reusedCount: 0\n"
+                          "  function pooled() { pooledCount++ }\n"
+                          "  function reused() { reusedCount++ }\n"
+                          "}";
+
+constexpr auto OTHER_DELEGATE = "import QtQml\n"
+                                "QtObject {\n"
+                                "  property var modelData\n"
+                                "  property string kind: \"b\"\n"
+                                "}";
+
+QObject* instanceFor(Variants& variants, const QVariant& value) {
+	for (auto& [variant, instance]: variants.mInstances.values) {
+		if (variant == value) return instance;
+	}
+
+	return nullptr;
+}
+
+} // namespace
+
+void TestDelegatePool::parkAndTake() {
+	auto engine = QQmlEngine();
+	auto component = QQmlComponent(&engine);
+	component.setData(DELEGATE, QUrl());
+	QVERIFY(component.isReady());
+
+	auto pool = DelegatePool();
+	pool.setComponent(&component);
+
+	// a disabled pool neither parks nor counts misses
+	auto* instance = component.create();
+	QVERIFY(!pool.park(instance));
+	QCOMPARE(pool.take({}), nullptr);
+	QCOMPARE(pool.misses(), 0);
+
+	pool.setCapacity(2);
+	QVERIFY(pool.park(instance));
+	QCOMPARE(pool.size(), 1);
+	QCOMPARE(instance->property("pooledCount").toInt(), 1);
+
+	auto* taken = pool.take({{"modelData", 5}});
+	QCOMPARE(taken, instance);
+	QCOMPARE(pool.size(), 0);
+	QCOMPARE(taken->property("modelData").toInt(), 5);
+	QCOMPARE(taken->property("reusedCount").toInt(), 1);
+	QCOMPARE(pool.hits(), 1);
+	QCOMPARE(pool.misses(), 0);
+
+	QCOMPARE(pool.take({{"modelData", 6}}), nullptr);
+	QCOMPARE(pool.hits(), 1);
+	QCOMPARE(pool.misses(), 1);
+
+	// instances destroyed while parked are skipped
+	QVERIFY(pool.park(taken));
+	delete taken;
+	QCOMPARE(pool.take({}), nullptr);
+	QCOMPARE(pool.misses(), 2);
+}
+
+void TestDelegatePool::capacityEviction() {
+	auto engine = QQmlEngine();
+	auto component = QQmlComponent(&engine);
+	component.setData(DELEGATE, QUrl());
+	QVERIFY(component.isReady());
+
+	auto pool = DelegatePool();
+	pool.setComponent(&component);
+	pool.setCapacity(2);
+
+	auto a = QPointer(component.create());
+	auto b = QPointer(component.create());
+	auto* c = component.create();
+	QVERIFY(pool.park(a));
+	QVERIFY(pool.park(b));
+	QVERIFY(!pool.park(c));
+	delete c;
+
+	// the most recently parked instance is evicted first
+	pool.setCapacity(1);
+	QCOMPARE(pool.size(), 1);
+	QTRY_VERIFY(b.isNull());
+	QVERIFY(!a.isNull());
+
+	pool.setCapacity(0);
+	QCOMPARE(pool.size(), 0);
+	QTRY_VERIFY(a.isNull());
+}
+
+void TestDelegatePool::componentChange() {
+	auto engine = QQmlEngine();
+	auto component = QQmlComponent(&engine);
+	component.setData(DELEGATE, QUrl());
+	auto other = QQmlComponent(&engine);
+	other.setData(OTHER_DELEGATE, QUrl());
+	QVERIFY(component.isReady());
+	QVERIFY(other.isReady());
+
+	auto pool = DelegatePool();
+	pool.setComponent(&component);
+	pool.setCapacity(2);
+
+	auto instance = QPointer(component.create());
+	QVERIFY(pool.park(instance));
+
+	pool.setComponent(&component);
+	QCOMPARE(pool.size(), 1);
+
+	pool.setComponent(&other);
+	QCOMPARE(pool.size(), 0);
+	QTRY_VERIFY(instance.isNull());
+	QCOMPARE(pool.take({}), nullptr);
+}
+
+void TestDelegatePool::variantsReuse() {
+	auto engine = QQmlEngine();
+	auto component = QQmlComponent(&engine);
+	component.setData(DELEGATE, QUrl());
+	QVERIFY(component.isReady());
+
+	auto variants = Variants();
+	variants.setProperty("delegate", QVariant::fromValue(&component));
+	variants.setReusePoolSize(1);
+	variants.reload();
+
+	auto statsSpy = QSignalSpy(&variants, &Variants::poolStatsChanged);
+
+	variants.setModel(QVariantList {1, 2});
+	QCOMPARE(variants.mInstances.values.size(), 2);
+	QCOMPARE(variants.poolHits(), 0);
+	QCOMPARE(variants.poolMisses(), 2);
+	QCOMPARE(statsSpy.count(), 1);
+
+	auto* first = instanceFor(variants, 1);
+	QVERIFY(first != nullptr);
+
+	// the removed instance is parked, then reused for the added value
+	variants.setModel(QVariantList {2, 3});
+	QCOMPARE(instanceFor(variants, 3), first);
+	QCOMPARE(first->property("modelData").toInt(), 3);
+	QCOMPARE(first->property("pooledCount").toInt(), 1);
+	QCOMPARE(first->property("reusedCount").toInt(), 1);
+	QCOMPARE(variants.poolHits(), 1);
+	QCOMPARE(variants.poolMisses(), 2);
+	QCOMPARE(statsSpy.count(), 2);
+
+	// removals alone don't change the stats
+	auto parked = QPointer(instanceFor(variants, 2));
+	variants.setModel(QVariantList {3});
+	QCOMPARE(variants.pool.size(), 1);
+	QCOMPARE(statsSpy.count(), 2);
+
+	// a removal over capacity destroys the instance
+	auto destroyed = QPointer(first);
+	variants.setModel(QVariantList());
+	QCOMPARE(variants.pool.size(), 1);
+	QTRY_VERIFY(destroyed.isNull());
+	QVERIFY(!parked.isNull());
+
+	auto sizeSpy = QSignalSpy(&variants, &Variants::reusePoolSizeChanged);
+	variants.setReusePoolSize(0);
+	QCOMPARE(sizeSpy.count(), 1);
+	QCOMPARE(variants.pool.size(), 0);
+	QTRY_VERIFY(parked.isNull());
+}
+
+void TestDelegatePool::variantsDelegateChange() {
+	auto engine = QQmlEngine();
+	auto component = QQmlComponent(&engine);
+	component.setData(DELEGATE, QUrl());
+	auto other = QQmlComponent(&engine);
+	other.setData(OTHER_DELEGATE, QUrl());
+	QVERIFY(component.isReady());
+	QVERIFY(other.isReady());
+
+	auto variants = Variants();
+	variants.setProperty("delegate", QVariant::fromValue(&component));
+	variants.setReusePoolSize(2);
+	variants.reload();
+
+	variants.setModel(QVariantList {1, 2});
+	auto old = QPointer(instanceFor(variants, 1));
+	QVERIFY(!old.isNull());
+
+	// instances removed in the same update as the delegate change are not reused
+	variants.setProperty("delegate", QVariant::fromValue(&other));
+	variants.setModel(QVariantList {2, 3});
+
+	auto* created = instanceFor(variants, 3);
+	QVERIFY(created != nullptr);
+	QCOMPARE(created->property("kind").toString(), QString("b"));
+	QCOMPARE(variants.poolHits(), 0);
+	QCOMPARE(variants.pool.size(), 0);
+	QTRY_VERIFY(old.isNull());
+}
+
+void TestDelegatePool::variantsAsynchronous() {
+	// must outlive the engine, which detaches itself from it on destruction
+	auto controller = QQmlIncubationController();
+	auto engine = QQmlEngine();
+	engine.setIncubationController(&controller);
+
+	auto component = QQmlComponent(&engine);
+	component.setData(DELEGATE, QUrl());
+	QVERIFY(component.isReady());
+
+	auto variants = Variants();
+	variants.setProperty("delegate", QVariant::fromValue(&component));
+	variants.setAsynchronous(true);
+	variants.reload();
+
+	auto spy = QSignalSpy(&variants, &Variants::instancesChanged);
+	variants.setModel(QVariantList {1, 2});
+	QCOMPARE(spy.count(), 1);
+	QCOMPARE(variants.mInstances.values.size(), 0);
+	QCOMPARE(variants.mIncubating.values.size(), 2);
+	QCOMPARE(controller.incubatingObjectCount(), 2);
+
+	while (controller.incubatingObjectCount() != 0) controller.incubateFor(100);
+	QTRY_COMPARE(variants.mInstances.values.size(), 2);
+
+	QCOMPARE(variants.mIncubating.values.size(), 0);
+	QCOMPARE(spy.count(), 3);
+
+	for (auto value: {1, 2}) {
+		auto* instance = instanceFor(variants, value);
+		QVERIFY(instance != nullptr);
+		QVERIFY(instance->parent() == &variants);
+		QCOMPARE(instance->property("modelData").toInt(), value);
+	}
+
+	// values removed while incubating are never added
+	variants.setModel(QVariantList {1, 2, 3});
+	QCOMPARE(variants.mIncubating.values.size(), 1);
+	variants.setModel(QVariantList {1, 2});
+	QCOMPARE(variants.mIncubating.values.size(), 0);
+	QCOMPARE(controller.incubatingObjectCount(), 0);
+}
+
+QTEST_MAIN(TestDelegatePool);
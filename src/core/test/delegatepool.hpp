@@ -0,0 +1,16 @@
+#pragma once
+
+#include <qobject.h>
+#include <qtmetamacros.h>
+
+class TestDelegatePool: public QObject {
+	Q_OBJECT;
+
+private slots:
+	static void parkAndTake();
+	static void capacityEviction();
+	static void componentChange();
+	static void variantsReuse();
+	static void variantsDelegateChange();
+	static void variantsAsynchronous();
+};
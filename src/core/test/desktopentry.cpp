@@ -0,0 +1,165 @@
+#include "desktopentry.hpp"
+
+#include <qdatetime.h>
+#include <qdir.h>
+#include <qfile.h>
+#include <qfiledevice.h>
+#include <qfileinfo.h>
+#include <qlist.h>
+#include <qset.h>
+#include <qsignalspy.h>
+#include <qstring.h>
+#include <qtemporarydir.h>
+#include <qtest.h>
+#include <qtestcase.h>
+#include <qtypes.h>
+
+#include "../desktopentry.hpp"
+
+namespace {
+
+void writeEntry(const QString& path, const QString& name) {
+	auto file = QFile(path);
+	QVERIFY(file.open(QFile::WriteOnly | QFile::Truncate));
+	file.write(QString("[Desktop Entry]\nType=Application\nName=%1\nExec=true\n").arg(name).toUtf8());
+}
+
+DesktopEntryFile scannedFile(const QString& id, const QString& name, qint64 modified) {
+	auto file = DesktopEntryFile();
+	file.path = "/test/" + id + ".desktop";
+	file.modified = modified;
+	file.size = 100;
+	file.data = DesktopEntryData::parse(id, "[Desktop Entry]\nName=" + name + "\n");
+	return file;
+}
+
+} // namespace
+
+void TestDesktopEntryManager::cacheRoundTrip() {
+	auto dir = QTemporaryDir();
+	QVERIFY(dir.isValid());
+
+	auto root = dir.filePath("applications");
+	QVERIFY(QDir().mkpath(root + "/sub"));
+	writeEntry(root + "/a.desktop", "A");
+	writeEntry(root + "/sub/b.desktop", "B");
+
+	auto scan = DesktopEntryManager::scanDirs({root}, DesktopEntryScan(), false);
+	QCOMPARE(scan.files.size(), 2);
+
+	auto cachePath = dir.filePath("desktopentries.cache");
+	DesktopEntryManager::saveCache(cachePath, scan);
+	auto loaded = DesktopEntryManager::loadCache(cachePath);
+
+	QCOMPARE(loaded.roots, scan.roots);
+	QCOMPARE(loaded.dirs, scan.dirs);
+	QCOMPARE(loaded.files.size(), scan.files.size());
+
+	for (auto i = 0; i != scan.files.size(); i++) {
+		const auto& file = scan.files.at(i);
+		const auto& loadedFile = loaded.files.at(i);
+		QCOMPARE(loadedFile.path, file.path);
+		QCOMPARE(loadedFile.modified, file.modified);
+		QCOMPARE(loadedFile.size, file.size);
+		QCOMPARE(loadedFile.data.id, file.data.id);
+		QCOMPARE(loadedFile.data.name, file.data.name);
+		QCOMPARE(loadedFile.data.execString, file.data.execString);
+	}
+
+	QVERIFY(DesktopEntryManager::cacheValid(loaded, {root}));
+
+	// a corrupt cache is ignored
+	auto cacheFile = QFile(cachePath);
+	QVERIFY(cacheFile.open(QFile::ReadWrite));
+	QVERIFY(cacheFile.resize(cacheFile.size() / 2));
+	cacheFile.close();
+	QVERIFY(DesktopEntryManager::loadCache(cachePath).roots.isEmpty());
+}
+
+void TestDesktopEntryManager::cacheInvalidation() {
+	auto dir = QTemporaryDir();
+	QVERIFY(dir.isValid());
+
+	auto root = dir.filePath("applications");
+	QVERIFY(QDir().mkpath(root));
+	writeEntry(root + "/a.desktop", "A");
+
+	auto scan = DesktopEntryManager::scanDirs({root}, DesktopEntryScan(), false);
+	QVERIFY(DesktopEntryManager::cacheValid(scan, {root}));
+
+	// other roots are never valid
+	QVERIFY(!DesktopEntryManager::cacheValid(scan, {root, dir.filePath("other")}));
+
+	// editing a file in place does not change the directory mtime
+	auto dirModified = QFileInfo(root).lastModified();
+	writeEntry(root + "/a.desktop", "Renamed A");
+
+	auto file = QFile(root + "/a.desktop");
+	QVERIFY(file.open(QFile::ReadWrite));
+	QVERIFY(file.setFileTime(
+	    QDateTime::fromMSecsSinceEpoch(scan.files.first().modified + 5000),
+	    QFileDevice::FileModificationTime
+	));
+	file.close();
+
+	QCOMPARE(QFileInfo(root).lastModified(), dirModified);
+	QVERIFY(!DesktopEntryManager::cacheValid(scan, {root}));
+
+	// a rescan reparses only the changed file
+	auto rescan = DesktopEntryManager::scanDirs({root}, scan, false);
+	QCOMPARE(rescan.files.first().data.name, QString("Renamed A"));
+	QVERIFY(DesktopEntryManager::cacheValid(rescan, {root}));
+}
+
+void TestDesktopEntryManager::applyScanDiff() {
+	auto manager = DesktopEntryManager();
+	auto changedSpy = QSignalSpy(&manager, &DesktopEntryManager::entriesChanged);
+
+	auto scan = DesktopEntryScan();
+	scan.files = {scannedFile("a", "A", 1), scannedFile("b", "B", 1)};
+	manager.applyScan(scan);
+
+	QCOMPARE(changedSpy.count(), 1);
+	auto* a = manager.byId("a");
+	auto* b = manager.byId("b");
+	QVERIFY(a != nullptr);
+	QVERIFY(b != nullptr);
+	// new entries are appended in no particular order
+	auto applications = QSet<DesktopEntry*>(
+	    manager.applications()->valueList().begin(),
+	    manager.applications()->valueList().end()
+	);
+	QCOMPARE(applications, (QSet<DesktopEntry*> {a, b}));
+
+	// a is updated, b is removed and c is added
+	scan.files = {scannedFile("a", "New A", 2), scannedFile("c", "C", 1)};
+	manager.applyScan(scan);
+
+	QCOMPARE(changedSpy.count(), 2);
+	auto* newA = manager.byId("a");
+	auto* c = manager.byId("c");
+	QVERIFY(newA != nullptr && newA != a);
+	QCOMPARE(newA->mName, QString("New A"));
+	QCOMPARE(manager.byId("b"), nullptr);
+	QVERIFY(c != nullptr);
+	applications = QSet<DesktopEntry*>(
+	    manager.applications()->valueList().begin(),
+	    manager.applications()->valueList().end()
+	);
+	QCOMPARE(applications, (QSet<DesktopEntry*> {newA, c}));
+
+	// an identical scan keeps every entry
+	manager.applyScan(scan);
+	QCOMPARE(changedSpy.count(), 2);
+	QCOMPARE(manager.byId("a"), newA);
+	QCOMPARE(manager.byId("c"), c);
+
+	// later files with the same id take priority
+	scan.files.push_back(scannedFile("a", "Override A", 1));
+	scan.files.last().path = "/override/a.desktop";
+	manager.applyScan(scan);
+	QCOMPARE(changedSpy.count(), 3);
+	QCOMPARE(manager.byId("a")->mName, QString("Override A"));
+}
+
+QTEST_MAIN(TestDesktopEntryManager);
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <qobject.h>
+#include <qtmetamacros.h>
+
+class TestDesktopEntryManager: public QObject {
+	Q_OBJECT;
+
+private slots:
+	static void cacheRoundTrip();
+	static void cacheInvalidation();
+	static void applyScanDiff();
+};
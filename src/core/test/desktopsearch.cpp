@@ -0,0 +1,88 @@
+#include "desktopsearch.hpp"
+
+#include <qcontainerfwd.h>
+#include <qstring.h>
+#include <qtest.h>
+#include <qtestcase.h>
+#include <qtypes.h>
+
+#include "../desktopsearch.hpp"
+
+namespace {
+
+void addRecord(DesktopSearchIndexData& index, const QString& name, const QString& keywords = "") {
+	auto record = DesktopSearchRecord();
+	record.fields[DesktopSearchRecord::Name] = name;
+	record.fields[DesktopSearchRecord::Keywords] = keywords;
+	index.insert(record);
+}
+
+} // namespace
+
+void TestDesktopSearch::matchKindRanking() {
+	auto index = DesktopSearchIndexData();
+	addRecord(index, "campfire");            // substring
+	addRecord(index, "browser", "firewall"); // keyword prefix
+	addRecord(index, "terminal");            // no match
+	addRecord(index, "open fire");           // word start
+	addRecord(index, "firefox");             // name prefix
+
+	auto results = DesktopSearchOperation::search(index, "Fire", 0);
+	QCOMPARE(results, QVector<qint32>({4, 3, 1, 0}));
+
+	// a shorter field is a better match for the same prefix
+	addRecord(index, "fireplace");
+	addRecord(index, "fire");
+	results = DesktopSearchOperation::search(index, "fire", 3);
+	QCOMPARE(results, QVector<qint32>({6, 4, 5}));
+}
+
+void TestDesktopSearch::tieOrdering() {
+	auto index = DesktopSearchIndexData();
+	addRecord(index, "beta", "tool");
+	addRecord(index, "gamma", "tool");
+	addRecord(index, "alpha", "tool");
+	addRecord(index, "gamma", "tool");
+
+	// equal scores are ordered by name, then by record index
+	auto results = DesktopSearchOperation::search(index, "tool", 0);
+	QCOMPARE(results, QVector<qint32>({2, 0, 1, 3}));
+
+	results = DesktopSearchOperation::search(index, "tool", 2);
+	QCOMPARE(results, QVector<qint32>({2, 0}));
+}
+
+void TestDesktopSearch::emptyQuery() {
+	auto index = DesktopSearchIndexData();
+	addRecord(index, "gamma");
+	addRecord(index, "alpha");
+	addRecord(index, "beta");
+
+	auto results = DesktopSearchOperation::search(index, "", 0);
+	QCOMPARE(results, QVector<qint32>({1, 2, 0}));
+
+	results = DesktopSearchOperation::search(index, "   ", 2);
+	QCOMPARE(results, QVector<qint32>({1, 2}));
+
+	QVERIFY(DesktopSearchOperation::search(DesktopSearchIndexData(), "", 0).isEmpty());
+}
+
+void TestDesktopSearch::longTermOverlap() {
+	// every trigram of the name is distinct
+	auto name = QString();
+	for (auto i = 0; i != 600; i++) name.append(QChar(0x4e00 + i));
+
+	// one replaced character breaks 3 of the term's 598 trigrams and prevents any
+	// direct match, leaving more trigram overlap than fits in 8 bits
+	auto term = name;
+	term[300] = u'x';
+
+	auto index = DesktopSearchIndexData();
+	addRecord(index, name);
+	addRecord(index, "unrelated");
+
+	auto results = DesktopSearchOperation::search(index, term, 0);
+	QCOMPARE(results, QVector<qint32>({0}));
+}
+
+QTEST_MAIN(TestDesktopSearch);
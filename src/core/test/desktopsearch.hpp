@@ -0,0 +1,14 @@
+#pragma once
+
+#include <qobject.h>
+#include <qtmetamacros.h>
+
+class TestDesktopSearch: public QObject {
+	Q_OBJECT;
+
+private slots:
+	static void matchKindRanking();
+	static void tieOrdering();
+	static void emptyQuery();
+	static void longTermOverlap();
+};
@@ -0,0 +1,74 @@
+#include "incubator.hpp"
+
+#include <qtest.h>
+#include <qtestcase.h>
+#include <qtypes.h>
+
+#include "../incubator.hpp"
+
+namespace {
+
+constexpr qint64 MS = 1'000'000;
+constexpr qint64 INTERVAL = 16 * MS;
+constexpr qint64 BUDGET = 5 * MS;
+
+} // namespace
+
+void TestIncubationBudget::spendWithinInterval() {
+	auto budget = IncubationBudget();
+
+	QCOMPARE_EQ(budget.remaining(0, INTERVAL, BUDGET), BUDGET);
+	budget.spend(2 * MS);
+	QCOMPARE_EQ(budget.remaining(4 * MS, INTERVAL, BUDGET), 3 * MS);
+	budget.spend(3 * MS);
+	QCOMPARE_EQ(budget.remaining(8 * MS, INTERVAL, BUDGET), 0);
+
+	// a new interval starts with the full budget
+	QCOMPARE_EQ(budget.remaining(INTERVAL, INTERVAL, BUDGET), BUDGET);
+	QCOMPARE_EQ(budget.totalSpent(), 5 * MS);
+}
+
+void TestIncubationBudget::overspendCarried() {
+	auto budget = IncubationBudget();
+
+	// less than a millisecond left still runs for a whole one
+	QCOMPARE_EQ(budget.remaining(0, INTERVAL, MS / 2), MS / 2);
+	budget.spend(MS);
+	QCOMPARE_EQ(budget.remaining(MS, INTERVAL, MS / 2), -MS / 2);
+
+	// so the next interval has nothing left
+	QCOMPARE_EQ(budget.remaining(INTERVAL, INTERVAL, MS / 2), 0);
+	QCOMPARE_EQ(budget.remaining(2 * INTERVAL, INTERVAL, MS / 2), MS / 2);
+
+	// a long object runs past the budget of several intervals
+	budget.spend(12 * MS);
+	QCOMPARE_EQ(budget.remaining(3 * INTERVAL, INTERVAL, BUDGET), -2 * MS);
+	QCOMPARE_EQ(budget.remaining(4 * INTERVAL, INTERVAL, BUDGET), 3 * MS);
+	QCOMPARE_EQ(budget.totalSpent(), 13 * MS);
+}
+
+void TestIncubationBudget::overspendForgiven() {
+	auto budget = IncubationBudget();
+
+	QCOMPARE_EQ(budget.remaining(0, INTERVAL, BUDGET), BUDGET);
+	budget.spend(12 * MS);
+
+	// intervals without incubation pay off their budget
+	QCOMPARE_EQ(budget.remaining(2 * INTERVAL, INTERVAL, BUDGET), 3 * MS);
+	QCOMPARE_EQ(budget.remaining(3 * INTERVAL, INTERVAL, BUDGET), BUDGET);
+	QCOMPARE_EQ(budget.totalSpent(), 12 * MS);
+}
+
+void TestIncubationBudget::intervalAlignment() {
+	auto budget = IncubationBudget();
+
+	QCOMPARE_EQ(budget.remaining(0, INTERVAL, BUDGET), BUDGET);
+	budget.spend(BUDGET);
+
+	// late frames don't shift the interval, so the next frame is in a new one
+	QCOMPARE_EQ(budget.remaining(INTERVAL + 10 * MS, INTERVAL, BUDGET), BUDGET);
+	budget.spend(BUDGET);
+	QCOMPARE_EQ(budget.remaining(2 * INTERVAL + MS, INTERVAL, BUDGET), BUDGET);
+}
+
+QTEST_MAIN(TestIncubationBudget);
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <qobject.h>
+#include <qtmetamacros.h>
+
+class TestIncubationBudget: public QObject {
+	Q_OBJECT;
+
+private slots:
+	static void spendWithinInterval();
+	static void overspendCarried();
+	static void overspendForgiven();
+	static void intervalAlignment();
+};
@@ -0,0 +1,119 @@
+#include "lazyloader.hpp"
+#include <array>
+
+#include <qcoreapplication.h>
+#include <qlist.h>
+#include <qobject.h>
+#include <qqmlcomponent.h>
+#include <qqmlengine.h>
+#include <qquickitem.h>
+#include <qtest.h>
+#include <qtestcase.h>
+#include <qtimer.h>
+#include <qurl.h>
+
+#include "../lazyloader.hpp"
+#include "../lazyloader_p.hpp"
+
+void TestLazyLoader::initTestCase() {
+	// keep the scheduler from opening a PSI trigger, pressure is simulated instead
+	LazyLoaderScheduler::instance()->pressureMonitorStarted = true;
+}
+
+void TestLazyLoader::cleanup() {
+	auto* scheduler = LazyLoaderScheduler::instance();
+	scheduler->preloadTimer->stop();
+	QCOMPARE(scheduler->preloadQueue, {});
+	QCOMPARE(scheduler->unloadable, {});
+}
+
+void TestLazyLoader::preloadOrder() {
+	auto engine = QQmlEngine();
+	auto component = QQmlComponent(&engine);
+	component.setData("import QtQml\nQtObject {}", QUrl());
+	QVERIFY(component.isReady());
+
+	auto loaders = std::array<LazyLoader, 4>();
+	auto& [a, b, c, active] = loaders;
+	auto loaded = QList<LazyLoader*>();
+
+	for (auto& loader: loaders) {
+		loader.setComponent(&component);
+		loader.reload();
+
+		QObject::connect(&loader, &LazyLoader::itemChanged, &loader, [&loaded, &loader]() {
+			if (loader.isActive()) loaded.push_back(&loader);
+		});
+	}
+
+	active.setActive(true);
+	loaded.clear();
+
+	auto* scheduler = LazyLoaderScheduler::instance();
+	scheduler->queuePreload(&b);
+	scheduler->queuePreload(&active);
+	scheduler->queuePreload(&a);
+	scheduler->queuePreload(&b);
+	scheduler->queuePreload(&c);
+
+	QCOMPARE(scheduler->preloadQueue, (QList<LazyLoader*> {&b, &active, &a, &c}));
+	QVERIFY(scheduler->preloadTimer->isActive());
+
+	// already active loaders are skipped, the rest load in queue order
+	scheduler->preloadNext();
+	QTRY_COMPARE(loaded, (QList<LazyLoader*> {&b, &a, &c}));
+	QCOMPARE(scheduler->preloading, nullptr);
+}
+
+void TestLazyLoader::unloadAfterShown() {
+	auto loader = LazyLoader();
+	auto* item = new QQuickItem();
+	item->setVisible(false);
+	loader.setItem(item);
+	loader.setUnloadTimeout(0);
+
+	// a preloaded item that was never shown is kept
+	QVERIFY(loader.unloadTimer == nullptr || !loader.unloadTimer->isActive());
+	QCoreApplication::processEvents();
+	QVERIFY(loader.isActive());
+
+	item->setVisible(true);
+	QVERIFY(!loader.unloadTimer->isActive());
+
+	item->setVisible(false);
+	QVERIFY(loader.unloadTimer->isActive());
+	QTRY_VERIFY(!loader.isActive());
+
+	loader.setUnloadTimeout(-1);
+}
+
+void TestLazyLoader::unloadUnderPressure() {
+	auto hidden = LazyLoader();
+	auto* hiddenItem = new QQuickItem();
+	hiddenItem->setVisible(false);
+	hidden.setItem(hiddenItem);
+	hidden.setUnloadTimeout(60000);
+
+	auto shown = LazyLoader();
+	shown.setItem(new QQuickItem());
+	shown.setUnloadTimeout(60000);
+
+	auto queued = LazyLoader();
+
+	auto* scheduler = LazyLoaderScheduler::instance();
+	scheduler->queuePreload(&queued);
+	QCOMPARE(scheduler->unloadable, (QList<LazyLoader*> {&hidden, &shown}));
+
+	// hidden items are dropped under pressure even if they were never shown
+	scheduler->onMemoryPressure();
+	QVERIFY(!hidden.isActive());
+	QVERIFY(shown.isActive());
+	QCOMPARE(scheduler->preloadQueue, {});
+	QCOMPARE_EQ(scheduler->counts.pressureEvents, 1);
+	QCOMPARE_EQ(scheduler->counts.pressureUnloads, 1);
+
+	hidden.setUnloadTimeout(-1);
+	shown.setUnloadTimeout(-1);
+}
+
+QTEST_MAIN(TestLazyLoader);
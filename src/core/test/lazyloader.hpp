@@ -0,0 +1,15 @@
+#pragma once
+
+#include <qobject.h>
+#include <qtmetamacros.h>
+
+class TestLazyLoader: public QObject {
+	Q_OBJECT;
+
+private slots:
+	static void initTestCase();
+	static void cleanup();
+	static void preloadOrder();
+	static void unloadAfterShown();
+	static void unloadUnderPressure();
+};
@@ -0,0 +1,203 @@
+#include "objectmodel.hpp"
+#include <array>
+#include <memory>
+
+#include <qabstractitemmodel.h>
+#include <qabstractitemmodeltester.h>
+#include <qcontainerfwd.h>
+#include <qlist.h>
+#include <qobject.h>
+#include <qsignalspy.h>
+#include <qstring.h>
+#include <qtest.h>
+#include <qtestcase.h>
+#include <qtypes.h>
+
+#include "../model.hpp"
+
+namespace {
+
+class TestModel: public ObjectModel<QObject> {
+public:
+	TestModel(): ObjectModel(nullptr) {}
+
+	using UntypedObjectModel::removeRange;
+};
+
+// One object per letter, so lists can be written as strings.
+class ObjectPool {
+public:
+	QVector<QObject*> list(const QString& str) {
+		auto list = QVector<QObject*>();
+
+		for (auto c: str) {
+			auto& object = this->objects[c.unicode()];
+			if (!object) object = std::make_unique<QObject>();
+			list.push_back(object.get());
+		}
+
+		return list;
+	}
+
+private:
+	std::array<std::unique_ptr<QObject>, 128> objects;
+};
+
+} // namespace
+
+void TestObjectModel::diffUpdate_data() {
+	QTest::addColumn<QString>("oldstr");
+	QTest::addColumn<QString>("newstr");
+	QTest::addColumn<qint32>("rowSignals");
+
+	QTest::addRow("unchanged") << "ABCD" << "ABCD" << 0;
+	QTest::addRow("append") << "ABC" << "ABCDEF" << 1;
+	QTest::addRow("prepend") << "DEF" << "ABCDEF" << 1;
+	QTest::addRow("remove_ranges") << "ABCDEFG" << "ADG" << 2;
+	QTest::addRow("clear") << "ABCD" << "" << 1;
+	QTest::addRow("move_range") << "ABCDEF" << "DEFABC" << 1;
+	QTest::addRow("move_back") << "ABCDEF" << "BCDEFA" << 1;
+	QTest::addRow("swap") << "ABCD" << "ADCB" << 2;
+	QTest::addRow("mixed") << "ABCDEFG" << "XGBCYZA" << 5;
+	QTest::addRow("reverse") << "ABCDE" << "EDCBA" << 4;
+}
+
+void TestObjectModel::diffUpdate() {
+	QFETCH(const QString, oldstr);
+	QFETCH(const QString, newstr);
+	QFETCH(const qint32, rowSignals);
+
+	auto pool = ObjectPool();
+	auto model = TestModel();
+	auto modelTester = QAbstractItemModelTester(&model);
+
+	model.diffUpdate(pool.list(oldstr));
+	QCOMPARE_EQ(model.valueList(), pool.list(oldstr));
+
+	auto insertSpy = QSignalSpy(&model, &QAbstractItemModel::rowsInserted);
+	auto removeSpy = QSignalSpy(&model, &QAbstractItemModel::rowsRemoved);
+	auto moveSpy = QSignalSpy(&model, &QAbstractItemModel::rowsMoved);
+	auto changedSpy = QSignalSpy(&model, &UntypedObjectModel::valuesChanged);
+
+	model.diffUpdate(pool.list(newstr));
+	QCOMPARE_EQ(model.valueList(), pool.list(newstr));
+	QCOMPARE_EQ(insertSpy.count() + removeSpy.count() + moveSpy.count(), rowSignals);
+	QCOMPARE_EQ(changedSpy.count(), rowSignals == 0 ? 0 : 1);
+
+	for (auto i = 0; i != newstr.length(); i++) {
+		QCOMPARE_EQ(model.indexOf(model.valueList().at(i)), i);
+	}
+}
+
+void TestObjectModel::diffUpdateReorder() {
+	auto pool = ObjectPool();
+	auto model = TestModel();
+
+	model.diffUpdate(pool.list("ABCDEF"));
+
+	auto insertedSpy = QSignalSpy(&model, &UntypedObjectModel::objectInsertedPost);
+	auto removedSpy = QSignalSpy(&model, &UntypedObjectModel::objectRemovedPost);
+
+	// ranked results reorder kept objects, which must not be duplicated or reinserted
+	model.diffUpdate(pool.list("FXBDA"));
+	QCOMPARE_EQ(model.valueList(), pool.list("FXBDA"));
+
+	QCOMPARE_EQ(insertedSpy.count(), 1);
+	QCOMPARE_EQ(insertedSpy.at(0).at(0).value<QObject*>(), pool.list("X").first());
+	QCOMPARE_EQ(removedSpy.count(), 2);
+}
+
+void TestObjectModel::batchedSignals() {
+	auto pool = ObjectPool();
+	auto model = TestModel();
+	auto changedSpy = QSignalSpy(&model, &UntypedObjectModel::valuesChanged);
+
+	{
+		auto batch = UntypedObjectModel::UpdateBatch(&model);
+
+		for (auto* object: pool.list("ABCD")) {
+			model.insertObject(object);
+		}
+
+		{
+			auto inner = UntypedObjectModel::UpdateBatch(&model);
+			model.removeObject(pool.list("B").first());
+		}
+
+		QCOMPARE_EQ(changedSpy.count(), 0);
+	}
+
+	QCOMPARE_EQ(changedSpy.count(), 1);
+	QCOMPARE_EQ(model.valueList(), pool.list("ACD"));
+
+	{
+		// batches without changes do not emit
+		auto batch = UntypedObjectModel::UpdateBatch(&model);
+	}
+
+	QCOMPARE_EQ(changedSpy.count(), 1);
+
+	auto insertSpy = QSignalSpy(&model, &QAbstractItemModel::rowsInserted);
+	model.insertObjects(pool.list("XYZ"), 1);
+	QCOMPARE_EQ(insertSpy.count(), 1);
+	QCOMPARE_EQ(changedSpy.count(), 2);
+
+	auto removeSpy = QSignalSpy(&model, &QAbstractItemModel::rowsRemoved);
+	model.removeRange(0, 3);
+	QCOMPARE_EQ(removeSpy.count(), 1);
+	QCOMPARE_EQ(changedSpy.count(), 3);
+	QCOMPARE_EQ(model.valueList(), pool.list("ZCD"));
+}
+
+void TestObjectModel::indexOf() {
+	auto pool = ObjectPool();
+	auto model = TestModel();
+
+	model.insertObjects(pool.list("ABCDE"));
+	QCOMPARE_EQ(model.indexOf(pool.list("D").first()), 3);
+
+	model.removeObject(pool.list("B").first());
+	QCOMPARE_EQ(model.indexOf(pool.list("B").first()), -1);
+	QCOMPARE_EQ(model.indexOf(pool.list("D").first()), 2);
+
+	model.insertObject(pool.list("B").first());
+	QCOMPARE_EQ(model.indexOf(pool.list("B").first()), 4);
+
+	model.insertObject(pool.list("X").first(), 0);
+	QCOMPARE_EQ(model.indexOf(pool.list("A").first()), 1);
+	QCOMPARE_EQ(model.indexOf(pool.list("B").first()), 5);
+
+	// direct modification of the list is picked up
+	model.mutableValueList().swapItemsAt(0, 5);
+	QCOMPARE_EQ(model.indexOf(pool.list("X").first()), 5);
+	QCOMPARE_EQ(model.indexOf(pool.list("B").first()), 0);
+}
+
+void TestObjectModel::indexOfCached() {
+	auto pool = ObjectPool();
+	auto model = TestModel();
+
+	model.insertObjects(pool.list("ABCDE"));
+	QCOMPARE_EQ(model.indexOf(pool.list("E").first()), 4);
+	QCOMPARE_EQ(model.indexedCount, 5);
+
+	// reading the list does not invalidate the index map
+	for (auto i = 0; i != 3; i++) {
+		for (auto j = 0; j != model.valueList().length(); j++) {
+			QCOMPARE_EQ(model.indexOf(model.valueList().at(j)), j);
+			QCOMPARE_EQ(model.indexedCount, 5);
+		}
+	}
+
+	// appending keeps the indexed range
+	model.insertObject(pool.list("F").first());
+	QCOMPARE_EQ(model.indexedCount, 5);
+	QCOMPARE_EQ(model.indexOf(pool.list("F").first()), 5);
+	QCOMPARE_EQ(model.indexedCount, 6);
+
+	model.mutableValueList().removeFirst();
+	QCOMPARE_EQ(model.indexedCount, 0);
+	QCOMPARE_EQ(model.indexOf(pool.list("F").first()), 4);
+}
+
+QTEST_MAIN(TestObjectModel);
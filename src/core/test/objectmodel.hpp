@@ -0,0 +1,16 @@
+#pragma once
+
+#include <qobject.h>
+#include <qtmetamacros.h>
+
+class TestObjectModel: public QObject {
+	Q_OBJECT;
+
+private slots:
+	static void diffUpdate_data(); // NOLINT
+	static void diffUpdate();
+	static void diffUpdateReorder();
+	static void batchedSignals();
+	static void indexOf();
+	static void indexOfCached();
+};
@@ -0,0 +1,75 @@
+#include "qoi.hpp"
+
+#include <qbytearray.h>
+#include <qcolor.h>
+#include <qimage.h>
+#include <qlist.h>
+#include <qtest.h>
+#include <qtestcase.h>
+#include <qtypes.h>
+
+#include "../qoi.hpp"
+
+namespace {
+
+QImage makeImage(const QList<QRgb>& pixels, QImage::Format format = QImage::Format_RGB32) {
+	auto image = QImage(static_cast<qint32>(pixels.size()), 1, format);
+
+	for (qint32 x = 0; x != pixels.size(); x++) {
+		image.setPixel(x, 0, pixels.at(x));
+	}
+
+	return image;
+}
+
+const QByteArray END_MARKER = QByteArray::fromHex("0000000000000001");
+
+} // namespace
+
+void TestQoi::header() {
+	auto image = QImage(300, 2, QImage::Format_ARGB32);
+	image.fill(Qt::transparent);
+
+	auto data = QoiEncoder::encode(image);
+
+	QCOMPARE_EQ(data.first(14), QByteArray::fromHex("716f69660000012c000000020400"));
+	QVERIFY(data.endsWith(END_MARKER));
+}
+
+void TestQoi::encode_data() {
+	QTest::addColumn<QImage>("image");
+	QTest::addColumn<QByteArray>("ops");
+
+	auto a = qRgb(10, 20, 30);
+
+	// red - black wraps around to a diff of -1
+	QTest::addRow("diff") << makeImage({qRgb(255, 0, 0)}) << QByteArray::fromHex("5a");
+	QTest::addRow("run") << makeImage({a, a, a, a}) << QByteArray::fromHex("fe0a141ec2");
+
+	QTest::addRow("index") << makeImage({a, qRgb(200, 100, 50), a})
+	                       << QByteArray::fromHex("fe0a141efec8643209");
+
+	QTest::addRow("luma") << makeImage({a, qRgb(15, 25, 35)}) << QByteArray::fromHex("fe0a141ea588");
+
+	QTest::addRow("rgba") << makeImage({qRgba(1, 2, 3, 128)}, QImage::Format_ARGB32)
+	                      << QByteArray::fromHex("ff01020380");
+
+	// the initial pixel is opaque black, and runs are split at 62 pixels
+	QTest::addRow("long_run") << makeImage(QList<QRgb>(64, qRgb(0, 0, 0)))
+	                          << QByteArray::fromHex("fdc1");
+}
+
+void TestQoi::encode() {
+	QFETCH(QImage, image);
+	QFETCH(QByteArray, ops);
+
+	auto data = QoiEncoder::encode(image);
+
+	QCOMPARE_EQ(data.at(12), image.hasAlphaChannel() ? 4 : 3);
+	QCOMPARE_EQ(data.sliced(14, data.size() - 14 - END_MARKER.size()), ops);
+	QVERIFY(data.endsWith(END_MARKER));
+}
+
+void TestQoi::nullImage() { QVERIFY(QoiEncoder::encode(QImage()).isEmpty()); }
+
+QTEST_MAIN(TestQoi);
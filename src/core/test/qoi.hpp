@@ -0,0 +1,14 @@
+#pragma once
+
+#include <qobject.h>
+#include <qtmetamacros.h>
+
+class TestQoi: public QObject {
+	Q_OBJECT;
+
+private slots:
+	static void header();
+	static void encode_data();
+	static void encode();
+	static void nullImage();
+};
@@ -0,0 +1,158 @@
+#include "relaunchstate.hpp"
+#include <memory>
+
+#include <qcontainerfwd.h>
+#include <qdatastream.h>
+#include <qfile.h>
+#include <qhash.h>
+#include <qobject.h>
+#include <qqml.h>
+#include <qqmlcomponent.h>
+#include <qqmlengine.h>
+#include <qqmllist.h>
+#include <qsignalspy.h>
+#include <qstringlist.h>
+#include <qtest.h>
+#include <qtestcase.h>
+#include <qtypes.h>
+#include <qurl.h>
+#include <qvariant.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "../instanceinfo.hpp"
+#include "../persistentprops.hpp"
+#include "../relaunchstate.hpp"
+#include "../variants.hpp"
+
+namespace {
+
+constexpr auto PROPERTIES = "import QtQml\n"
+                            "import QsTest\n"
+                            "PersistentProperties {\n"
+                            "  reloadableId: \"persist\"\n"
+                            "  property int count: 3\n"
+                            "  property string text: \"default\"\n"
+                            "  property var list: [1, \"two\"]\n"
+                            "  property QtObject object: QtObject {}\n"
+                            "}";
+
+// Hands the current snapshot to loadSnapshot as the crash handler would.
+void reloadSnapshot() {
+	auto fd = qs::crash::CrashInfo::INSTANCE.stateFd;
+	QVERIFY(fd != -1);
+	RelaunchState::loadSnapshot(dup(fd));
+}
+
+} // namespace
+
+void TestRelaunchState::initTestCase() {
+	qmlRegisterType<PersistentProperties>("QsTest", 1, 0, "PersistentProperties");
+	qmlRegisterType<Variants>("QsTest", 1, 0, "Variants");
+}
+
+void TestRelaunchState::cleanup() {
+	auto& fd = qs::crash::CrashInfo::INSTANCE.stateFd;
+	if (fd != -1) close(fd);
+	fd = -1;
+}
+
+void TestRelaunchState::snapshotRoundTrip() {
+	auto engine = QQmlEngine();
+	auto component = QQmlComponent(&engine);
+	component.setData(PROPERTIES, QUrl());
+	QVERIFY2(component.isReady(), qPrintable(component.errorString()));
+
+	auto original = std::unique_ptr<PersistentProperties>(
+	    qobject_cast<PersistentProperties*>(component.create())
+	);
+	QVERIFY(original);
+	original->reload();
+	QCOMPARE(original->relaunchKey(), QString("persist"));
+
+	original->setProperty("count", 7);
+	original->setProperty("text", "changed");
+	RelaunchState::instance()->writeSnapshot();
+	reloadSnapshot();
+
+	auto restored = RelaunchState::takeRestored("persist");
+	QCOMPARE(restored.value("count").toInt(), 7);
+	QCOMPARE(restored.value("text").toString(), QString("changed"));
+	QCOMPARE(restored.value("list").toList(), (QVariantList {1, "two"}));
+	// object references are not serializable
+	QVERIFY(!restored.contains("object"));
+	QVERIFY(RelaunchState::takeRestored("persist").isEmpty());
+
+	// a new instance with the same key picks up the restored values
+	reloadSnapshot();
+	auto relaunched = std::unique_ptr<PersistentProperties>(
+	    qobject_cast<PersistentProperties*>(component.create())
+	);
+	QVERIFY(relaunched);
+	auto reloadedSpy = QSignalSpy(relaunched.get(), &PersistentProperties::reloaded);
+	relaunched->reload();
+
+	QCOMPARE(reloadedSpy.count(), 1);
+	QCOMPARE(relaunched->property("count").toInt(), 7);
+	QCOMPARE(relaunched->property("text").toString(), QString("changed"));
+	QVERIFY(RelaunchState::takeRestored("persist").isEmpty());
+}
+
+void TestRelaunchState::unknownVersion() {
+	auto fd = memfd_create("test:relaunch_state", MFD_CLOEXEC);
+	QVERIFY(fd != -1);
+
+	{
+		auto file = QFile();
+		QVERIFY(file.open(fd, QFile::WriteOnly, QFile::DontCloseHandle));
+		auto ds = QDataStream(&file);
+		ds << quint32(0) << QHash<QString, QVariantMap> {{"persist", {{"count", 1}}}};
+	}
+
+	RelaunchState::loadSnapshot(fd);
+	QVERIFY(RelaunchState::takeRestored("persist").isEmpty());
+}
+
+void TestRelaunchState::variantsKeys() {
+	auto engine = QQmlEngine();
+	auto component = QQmlComponent(&engine);
+	component.setData(
+	    "import QtQml\n"
+	    "import QsTest\n"
+	    "PersistentProperties {\n"
+	    "  reloadableId: \"persist\"\n"
+	    "  required property var modelData\n"
+	    "  property var value: modelData\n"
+	    "}",
+	    QUrl()
+	);
+	QVERIFY2(component.isReady(), qPrintable(component.errorString()));
+
+	// must outlive the instance holding it as model data
+	auto object = QObject();
+
+	auto variants = Variants();
+	variants.setProperty("reloadableId", "bars");
+	variants.setProperty("delegate", QVariant::fromValue(&component));
+	variants.reload();
+
+	variants.setModel(QVariantList {"a", "b", QVariant::fromValue(&object)});
+
+	auto instances = variants.instances();
+	auto keys = QStringList();
+	for (auto i = 0; i != instances.count(&instances); i++) {
+		keys.push_back(qobject_cast<PersistentProperties*>(instances.at(&instances, i))->relaunchKey());
+	}
+
+	QCOMPARE(keys, (QStringList {"bars/[a]/persist", "bars/[b]/persist", "bars/[#2]/persist"}));
+
+	RelaunchState::instance()->writeSnapshot();
+	reloadSnapshot();
+
+	QCOMPARE(RelaunchState::takeRestored("bars/[a]/persist").value("value"), QVariant("a"));
+	QCOMPARE(RelaunchState::takeRestored("bars/[b]/persist").value("value"), QVariant("b"));
+	// object values are not serializable, but the instance is still kept apart
+	QVERIFY(!RelaunchState::takeRestored("bars/[#2]/persist").contains("value"));
+}
+
+QTEST_MAIN(TestRelaunchState);
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <qobject.h>
+#include <qtmetamacros.h>
+
+class TestRelaunchState: public QObject {
+	Q_OBJECT;
+
+private slots:
+	static void initTestCase();
+	static void cleanup();
+	static void snapshotRoundTrip();
+	static void unknownVersion();
+	static void variantsKeys();
+};
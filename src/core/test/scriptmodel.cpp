@@ -1,13 +1,16 @@
 #include "scriptmodel.hpp"
+#include <algorithm>
 
 #include <qabstractitemmodel.h>
 #include <qabstractitemmodeltester.h>
+#include <qcolor.h>
 #include <qcontainerfwd.h>
 #include <qdebug.h>
 #include <qlist.h>
 #include <qlogging.h>
 #include <qobject.h>
-#include <qsignalspy.h>
+#include <qrandom.h>
+#include <qrgb.h>
 #include <qstring.h>
 #include <qtest.h>
 #include <qtestcase.h>
@@ -80,29 +83,30 @@ void TestScriptModel::unique_data() {
 	QTest::addRow("move_single") << "ABCDEFG" << "AFBCDEG"
 	                             << OpList({{ModelOperation::Move, 5, 1, 1}});
 
+	// only the shorter side of a move is moved
 	QTest::addRow("move_range") << "ABCDEFG" << "ADEFBCG"
-	                            << OpList({{ModelOperation::Move, 3, 3, 1}});
+	                            << OpList({{ModelOperation::Move, 1, 2, 6}});
 
 	// beginning to end is the same operation
 	QTest::addRow("move_end_to_beginning")
 	    << "ABCDEFG" << "EFGABCD" << OpList({{ModelOperation::Move, 4, 3, 0}});
 
 	QTest::addRow("move_overlapping")
-	    << "ABCDEFG" << "ABDEFCG" << OpList({{ModelOperation::Move, 3, 3, 2}});
+	    << "ABCDEFG" << "ABDEFCG" << OpList({{ModelOperation::Move, 2, 1, 6}});
 
 	// Ensure iterators arent skipping anything at the end of operations by performing
 	// multiple back to back.
 
 	QTest::addRow("insert_state_ok") << "ABCDEFG" << "ABXXEFG"
 	                                 << OpList({
-	                                        {ModelOperation::Insert, 2, 2}, // ABXXCDEFG
-	                                        {ModelOperation::Remove, 4, 2}, // ABXXEFG
+	                                        {ModelOperation::Remove, 2, 2}, // ABEFG
+	                                        {ModelOperation::Insert, 2, 2}, // ABXXEFG
 	                                    });
 
 	QTest::addRow("remove_state_ok") << "ABCDEFG" << "ABFGE"
 	                                 << OpList({
 	                                        {ModelOperation::Remove, 2, 2},  // ABEFG
-	                                        {ModelOperation::Move, 3, 2, 2}, // ABFGE
+	                                        {ModelOperation::Move, 2, 1, 5}, // ABFGE
 	                                    });
 
 	QTest::addRow("move_state_ok") << "ABCDEFG" << "ABEFXYCDG"
@@ -112,20 +116,87 @@ void TestScriptModel::unique_data() {
 	                                  });
 }
 
-void TestScriptModel::unique() {
-	QFETCH(const QString, oldstr);
-	QFETCH(const QString, newstr);
-	QFETCH(OpList, operations);
+namespace {
 
-	auto strToVariantList = [](const QString& str) -> QVariantList {
-		QVariantList list;
+QVariantList strToVariantList(const QString& str) {
+	QVariantList list;
 
-		for (auto c: str) {
-			list.emplace_back(c);
-		}
+	for (auto c: str) {
+		list.emplace_back(c);
+	}
+
+	return list;
+}
+
+// Records model operations, and replays them on a copy of the model's values to check
+// they are consistent with the resulting list.
+class OperationRecorder {
+public:
+	explicit OperationRecorder(ScriptModel* model): model(model) {
+		auto onInsert = [this](const QModelIndex& parent, int first, int last) {
+			QCOMPARE(parent, QModelIndex());
+			this->operations << ModelOperation(ModelOperation::Insert, first, last - first + 1);
+
+			for (auto i = first; i <= last; i++) {
+				this->replayed.insert(i, this->model->values().at(i));
+			}
+		};
+
+		auto onRemove = [this](const QModelIndex& parent, int first, int last) {
+			QCOMPARE(parent, QModelIndex());
+			this->operations << ModelOperation(ModelOperation::Remove, first, last - first + 1);
+			this->replayed.remove(first, last - first + 1);
+		};
+
+		auto onMove = [this](
+		                  const QModelIndex& sourceParent,
+		                  int sourceStart,
+		                  int sourceEnd,
+		                  const QModelIndex& destParent,
+		                  int destStart
+		              ) {
+			QCOMPARE(sourceParent, QModelIndex());
+			QCOMPARE(destParent, QModelIndex());
+			auto len = sourceEnd - sourceStart + 1;
+			this->operations << ModelOperation(ModelOperation::Move, sourceStart, len, destStart);
+
+			auto moved = this->replayed.sliced(sourceStart, len);
+			this->replayed.remove(sourceStart, len);
+			auto dest = destStart > sourceStart ? destStart - len : destStart;
+
+			for (auto i = 0; i != len; i++) {
+				this->replayed.insert(dest + i, moved.at(i));
+			}
+		};
+
+		auto onDataChanged = [this](const QModelIndex& topLeft, const QModelIndex& bottomRight) {
+			for (auto i = topLeft.row(); i <= bottomRight.row(); i++) {
+				this->replayed[i] = this->model->values().at(i);
+				this->changedRows << i;
+			}
+		};
+
+		QObject::connect(model, &QAbstractItemModel::rowsInserted, model, onInsert);
+		QObject::connect(model, &QAbstractItemModel::rowsRemoved, model, onRemove);
+		QObject::connect(model, &QAbstractItemModel::rowsMoved, model, onMove);
+		QObject::connect(model, &QAbstractItemModel::dataChanged, model, onDataChanged);
+	}
+
+	void clear() {
+		this->operations.clear();
+		this->changedRows.clear();
+	}
 
-		return list;
-	};
+	ScriptModel* model;
+	OpList operations;
+	QList<qint32> changedRows;
+	QVariantList replayed;
+};
+
+void checkOperations() {
+	QFETCH(const QString, oldstr);
+	QFETCH(const QString, newstr);
+	QFETCH(OpList, operations);
 
 	auto oldlist = strToVariantList(oldstr);
 	auto newlist = strToVariantList(newstr);
@@ -133,49 +204,207 @@ void TestScriptModel::unique() {
 	auto model = ScriptModel();
 	auto modelTester = QAbstractItemModelTester(&model);
 
-	OpList actualOperations;
-
-	auto onInsert = [&](const QModelIndex& parent, int first, int last) {
-		QCOMPARE(parent, QModelIndex());
-		actualOperations << ModelOperation(ModelOperation::Insert, first, last - first + 1);
-	};
-
-	auto onRemove = [&](const QModelIndex& parent, int first, int last) {
-		QCOMPARE(parent, QModelIndex());
-		actualOperations << ModelOperation(ModelOperation::Remove, first, last - first + 1);
-	};
-
-	auto onMove = [&](const QModelIndex& sourceParent,
-	                  int sourceStart,
-	                  int sourceEnd,
-	                  const QModelIndex& destParent,
-	                  int destStart) {
-		QCOMPARE(sourceParent, QModelIndex());
-		QCOMPARE(destParent, QModelIndex());
-		actualOperations << ModelOperation(
-		    ModelOperation::Move,
-		    sourceStart,
-		    sourceEnd - sourceStart + 1,
-		    destStart
-		);
-	};
-
-	QObject::connect(&model, &QAbstractItemModel::rowsInserted, &model, onInsert);
-	QObject::connect(&model, &QAbstractItemModel::rowsRemoved, &model, onRemove);
-	QObject::connect(&model, &QAbstractItemModel::rowsMoved, &model, onMove);
+	auto recorder = OperationRecorder(&model);
 
 	model.setValues(oldlist);
 	QCOMPARE_EQ(model.values(), oldlist);
 	QCOMPARE_EQ(
-	    actualOperations,
+	    recorder.operations,
 	    OpList({{ModelOperation::Insert, 0, static_cast<qint32>(oldlist.length())}})
 	);
 
-	actualOperations.clear();
+	recorder.clear();
 
 	model.setValues(newlist);
 	QCOMPARE_EQ(model.values(), newlist);
-	QCOMPARE_EQ(actualOperations, operations);
+	QCOMPARE_EQ(recorder.replayed, newlist);
+	QCOMPARE_EQ(recorder.operations, operations);
+}
+
+QVariantMap keyedEntry(qint32 id, const QString& name) {
+	return {{"id", id}, {"name", name}};
+}
+
+// Values hashed by their structure or string form rather than their type.
+QVariantList structuredList(qsizetype size) {
+	auto list = QVariantList();
+	list.reserve(size);
+
+	for (auto i = 0; i != size; i++) {
+		switch (i % 3) {
+		case 0: list.push_back(keyedEntry(i, QString::number(i))); break;
+		case 1: list.push_back(QVariantList({i, QString::number(i)})); break;
+		case 2: list.push_back(QColor::fromRgb(static_cast<QRgb>(i))); break;
+		}
+	}
+
+	return list;
+}
+
+QVariantList randomList(qsizetype size, qint32 range) {
+	auto list = QVariantList();
+	list.reserve(size);
+
+	for (auto i = 0; i != size; i++) {
+		list.push_back(QRandomGenerator::global()->bounded(range));
+	}
+
+	return list;
+}
+
+} // namespace
+
+void TestScriptModel::unique() { checkOperations(); }
+
+void TestScriptModel::duplicates_data() {
+	QTest::addColumn<QString>("oldstr");
+	QTest::addColumn<QString>("newstr");
+	QTest::addColumn<OpList>("operations");
+
+	QTest::addRow("append_duplicate") << "AB" << "ABA" << OpList({{ModelOperation::Insert, 2, 1}});
+
+	QTest::addRow("insert_duplicate") << "AB" << "AAB" << OpList({{ModelOperation::Insert, 1, 1}});
+
+	QTest::addRow("remove_duplicate") << "AAA" << "AA" << OpList({{ModelOperation::Remove, 2, 1}});
+
+	// duplicates are matched in order of appearance
+	QTest::addRow("move_duplicate") << "AAB" << "ABA"
+	                                << OpList({{ModelOperation::Move, 2, 1, 1}});
+
+	QTest::addRow("move_between_duplicates")
+	    << "ABCA" << "ACBA" << OpList({{ModelOperation::Move, 2, 1, 1}});
+}
+
+void TestScriptModel::duplicates() { checkOperations(); }
+
+void TestScriptModel::keyed() {
+	auto model = ScriptModel();
+	auto modelTester = QAbstractItemModelTester(&model);
+	auto recorder = OperationRecorder(&model);
+
+	model.setKey("id");
+	model.setValues({keyedEntry(1, "a"), keyedEntry(2, "b"), keyedEntry(3, "c")});
+	recorder.clear();
+
+	// changed values with the same key are updated in place
+	auto changed = QVariantList({keyedEntry(1, "a"), keyedEntry(2, "x"), keyedEntry(3, "y")});
+	model.setValues(changed);
+	QCOMPARE_EQ(model.values(), changed);
+	QCOMPARE_EQ(recorder.replayed, changed);
+	QCOMPARE_EQ(recorder.operations, OpList());
+	QCOMPARE_EQ(recorder.changedRows, QList<qint32>({1, 2}));
+	recorder.clear();
+
+	auto moved = QVariantList({keyedEntry(3, "y"), keyedEntry(1, "z"), keyedEntry(2, "x")});
+	model.setValues(moved);
+	QCOMPARE_EQ(model.values(), moved);
+	QCOMPARE_EQ(recorder.replayed, moved);
+	QCOMPARE_EQ(recorder.operations, OpList({{ModelOperation::Move, 2, 1, 0}}));
+	QCOMPARE_EQ(recorder.changedRows, QList<qint32>({1}));
+	recorder.clear();
+
+	// without a key the same change replaces entries
+	model.setKey("");
+	auto replaced = QVariantList({keyedEntry(3, "y"), keyedEntry(1, "a"), keyedEntry(2, "x")});
+	model.setValues(replaced);
+	QCOMPARE_EQ(model.values(), replaced);
+	QCOMPARE_EQ(recorder.replayed, replaced);
+
+	QCOMPARE_EQ(
+	    recorder.operations,
+	    OpList({{ModelOperation::Remove, 1, 1}, {ModelOperation::Insert, 1, 1}})
+	);
+}
+
+void TestScriptModel::randomized() {
+	auto model = ScriptModel();
+	auto modelTester = QAbstractItemModelTester(&model);
+	auto recorder = OperationRecorder(&model);
+
+	for (auto i = 0; i != 200; i++) {
+		auto list = randomList(QRandomGenerator::global()->bounded(40), 30);
+		model.setValues(list);
+		QCOMPARE_EQ(model.values(), list);
+		QCOMPARE_EQ(recorder.replayed, list);
+	}
+}
+
+void TestScriptModel::structured() {
+	auto model = ScriptModel();
+	auto recorder = OperationRecorder(&model);
+
+	auto list = structuredList(3000);
+	model.setValues(list);
+	recorder.clear();
+
+	auto shuffled = list;
+	std::shuffle(shuffled.begin(), shuffled.end(), *QRandomGenerator::global());
+
+	// equal maps, lists and colors are matched and moved instead of replaced
+	model.setValues(shuffled);
+	QCOMPARE_EQ(model.values(), shuffled);
+	QCOMPARE_EQ(recorder.replayed, shuffled);
+
+	for (const auto& op: recorder.operations) {
+		QCOMPARE_EQ(op.operation, ModelOperation::Move);
+	}
+}
+
+void TestScriptModel::benchmark_data() {
+	QTest::addColumn<QVariantList>("oldlist");
+	QTest::addColumn<QVariantList>("newlist");
+
+	constexpr qsizetype size = 10000;
+
+	auto base = QVariantList();
+	base.reserve(size);
+	for (auto i = 0; i != size; i++) {
+		base.push_back(i);
+	}
+
+	auto shuffled = base;
+	std::shuffle(shuffled.begin(), shuffled.end(), *QRandomGenerator::global());
+
+	auto reversed = base;
+	std::ranges::reverse(reversed);
+
+	// every tenth value removed, and as many new values inserted elsewhere
+	auto edited = QVariantList();
+	edited.reserve(size);
+	for (auto i = 0; i != size; i++) {
+		if (i % 10 == 0) continue;
+		edited.push_back(i);
+		if (i % 10 == 5) edited.push_back(size + i);
+	}
+
+	auto appended = base;
+	appended.append(randomList(size / 10, 1000000));
+
+	QTest::addRow("shuffle") << base << shuffled;
+	QTest::addRow("reverse") << base << reversed;
+	QTest::addRow("edit") << base << edited;
+	QTest::addRow("append") << base << appended;
+	QTest::addRow("replace") << base << randomList(size, 1000000);
+
+	auto structured = structuredList(size);
+	auto structuredShuffled = structured;
+	std::shuffle(structuredShuffled.begin(), structuredShuffled.end(), *QRandomGenerator::global());
+
+	QTest::addRow("shuffle_structured") << structured << structuredShuffled;
+}
+
+void TestScriptModel::benchmark() {
+	QFETCH(const QVariantList, oldlist);
+	QFETCH(const QVariantList, newlist);
+
+	auto model = ScriptModel();
+
+	QBENCHMARK {
+		model.setValues(oldlist);
+		model.setValues(newlist);
+	}
+
+	QCOMPARE_EQ(model.values(), newlist);
 }
 
 QTEST_MAIN(TestScriptModel);
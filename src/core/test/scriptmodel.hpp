@@ -34,4 +34,11 @@ class TestScriptModel: public QObject {
 private slots:
 	static void unique_data(); // NOLINT
 	static void unique();
+	static void duplicates_data(); // NOLINT
+	static void duplicates();
+	static void keyed();
+	static void randomized();
+	static void structured();
+	static void benchmark_data(); // NOLINT
+	static void benchmark();
 };
@@ -0,0 +1,119 @@
+#include "spawn.hpp"
+#include <cerrno>
+#include <csignal>
+
+#include <qbytearray.h>
+#include <qcoreapplication.h>
+#include <qdir.h>
+#include <qlist.h>
+#include <qprocess.h>
+#include <qsignalspy.h>
+#include <qstring.h>
+#include <qtest.h>
+#include <qtestcase.h>
+#include <qtypes.h>
+#include <sys/types.h>
+
+#include "../spawn.hpp"
+
+void TestSpawnedProcess::startAndExit() {
+	auto process = SpawnedProcess();
+	process.setProgram("/bin/sh");
+	process.setArguments({"-c", "echo out; echo err >&2; exit 3"});
+	process.setStdoutEnabled(true);
+	process.setStderrEnabled(true);
+
+	auto startedSpy = QSignalSpy(&process, &SpawnedProcess::started);
+	auto finishedSpy = QSignalSpy(&process, &SpawnedProcess::finished);
+
+	auto out = QByteArray();
+	auto err = QByteArray();
+	QObject::connect(&process, &SpawnedProcess::stdoutRead, &process, [&](const QByteArray& data) {
+		out.append(data);
+	});
+	QObject::connect(&process, &SpawnedProcess::stderrRead, &process, [&](const QByteArray& data) {
+		err.append(data);
+	});
+
+	QVERIFY(process.start());
+	QVERIFY(process.isRunning());
+	QVERIFY(process.processId() > 0);
+
+	QVERIFY(finishedSpy.wait());
+	QCOMPARE(startedSpy.count(), 1);
+	QCOMPARE(finishedSpy.first().at(0).toInt(), 3);
+	QCOMPARE(finishedSpy.first().at(1).value<QProcess::ExitStatus>(), QProcess::NormalExit);
+	QCOMPARE(out, QByteArray("out\n"));
+	QCOMPARE(err, QByteArray("err\n"));
+	QVERIFY(!process.isRunning());
+}
+
+void TestSpawnedProcess::exitThroughPidFd() {
+	auto process = SpawnedProcess();
+	process.setProgram("/bin/sh");
+	process.setArguments({"-c", "exec sleep 10"});
+
+	QVERIFY(process.start());
+
+	if (process.exitNotifier == nullptr) {
+		QSKIP("pidfds are not supported by this kernel");
+	}
+
+	QVERIFY(process.exitPollTimer == nullptr);
+
+	auto finishedSpy = QSignalSpy(&process, &SpawnedProcess::finished);
+	process.terminate();
+
+	QVERIFY(finishedSpy.wait());
+	QCOMPARE(finishedSpy.first().at(0).toInt(), SIGTERM);
+	QCOMPARE(finishedSpy.first().at(1).value<QProcess::ExitStatus>(), QProcess::CrashExit);
+	QVERIFY(process.exitNotifier == nullptr);
+	QCOMPARE(process.pidFd, -1);
+}
+
+void TestSpawnedProcess::workingDirectory() {
+	auto directory = QDir::temp().canonicalPath();
+
+	auto process = SpawnedProcess();
+	process.setProgram("pwd");
+	process.setWorkingDirectory(directory);
+	process.setStdoutEnabled(true);
+
+	auto out = QByteArray();
+	QObject::connect(&process, &SpawnedProcess::stdoutRead, &process, [&](const QByteArray& data) {
+		out.append(data);
+	});
+
+	auto finishedSpy = QSignalSpy(&process, &SpawnedProcess::finished);
+	QVERIFY(process.start());
+	QVERIFY(finishedSpy.wait());
+
+	QCOMPARE(finishedSpy.first().at(0).toInt(), 0);
+	QCOMPARE(QString::fromLocal8Bit(out).trimmed(), directory);
+}
+
+void TestSpawnedProcess::execFailure() {
+	auto process = SpawnedProcess();
+	process.setProgram("/nonexistent/quickshell-spawn-test");
+
+	auto startedSpy = QSignalSpy(&process, &SpawnedProcess::started);
+
+	QVERIFY(!process.start());
+	QVERIFY(!process.isRunning());
+
+	QCoreApplication::processEvents();
+	QCOMPARE(startedSpy.count(), 0);
+
+	QVERIFY(!SpawnedProcess::startDetached("/nonexistent/quickshell-spawn-test", {}));
+}
+
+void TestSpawnedProcess::detachedReaped() {
+	auto pid = qint64(-1);
+	QVERIFY(SpawnedProcess::startDetached("/bin/sh", {"-c", "exit 0"}, QString(), &pid));
+	QVERIFY(pid > 0);
+
+	// an unreaped child stays a zombie, which can still be signalled
+	QTRY_VERIFY(::kill(static_cast<pid_t>(pid), 0) == -1 && errno == ESRCH);
+}
+
+QTEST_MAIN(TestSpawnedProcess);
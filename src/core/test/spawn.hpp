@@ -0,0 +1,15 @@
+#pragma once
+
+#include <qobject.h>
+#include <qtmetamacros.h>
+
+class TestSpawnedProcess: public QObject {
+	Q_OBJECT;
+
+private slots:
+	static void startAndExit();
+	static void exitThroughPidFd();
+	static void workingDirectory();
+	static void execFailure();
+	static void detachedReaped();
+};
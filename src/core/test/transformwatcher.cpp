@@ -1,8 +1,10 @@
 #include "transformwatcher.hpp"
 
+#include <qcoreapplication.h>
 #include <qlist.h>
 #include <qquickitem.h>
 #include <qquickwindow.h>
+#include <qsignalspy.h>
 #include <qtest.h>
 #include <qtestcase.h>
 
@@ -102,4 +104,95 @@ void TestTransformWatcher::multiWindow() { // NOLINT
 	QCOMPARE(watcher.childWindow, &bW);
 }
 
+void TestTransformWatcher::batchedChanges() { // NOLINT
+	auto a = QQuickItem();
+	auto b = QQuickItem();
+	b.setParentItem(&a);
+
+	auto watcher = TransformWatcher();
+	watcher.setA(&a);
+	watcher.setB(&b);
+
+	auto spy = QSignalSpy(&watcher, &TransformWatcher::transformChanged);
+
+	a.setX(10);
+	a.setY(20);
+	b.setWidth(30);
+	b.setRotation(45);
+	b.setScale(2);
+	QCOMPARE(spy.count(), 0);
+
+	QCoreApplication::processEvents();
+	QCOMPARE(spy.count(), 1);
+
+	QCoreApplication::processEvents();
+	QCOMPARE(spy.count(), 1);
+}
+
+void TestTransformWatcher::sharedItems() { // NOLINT
+	auto p = QQuickItem();
+	auto a = QQuickItem();
+	auto b = QQuickItem();
+	a.setParentItem(&p);
+	b.setParentItem(&p);
+
+	auto watcher1 = TransformWatcher();
+	watcher1.setA(&a);
+	watcher1.setB(&b);
+
+	auto watcher2 = TransformWatcher();
+	watcher2.setA(&b);
+	watcher2.setB(&a);
+
+	auto spy1 = QSignalSpy(&watcher1, &TransformWatcher::transformChanged);
+	auto spy2 = QSignalSpy(&watcher2, &TransformWatcher::transformChanged);
+
+	p.setX(10);
+	a.setX(10);
+	b.setX(10);
+
+	QCoreApplication::processEvents();
+	QCOMPARE(spy1.count(), 1);
+	QCOMPARE(spy2.count(), 1);
+}
+
+// a
+//  p1    b
+//   p2 c1
+//
+// c1 is then moved under p2.
+void TestTransformWatcher::reparent() { // NOLINT
+	auto a = QQuickItem();
+	a.setObjectName("a");
+	auto b = QQuickItem();
+	b.setObjectName("b");
+
+	auto p1 = QQuickItem();
+	p1.setObjectName("p1");
+	auto p2 = QQuickItem();
+	p2.setObjectName("p2");
+	auto c1 = QQuickItem();
+	c1.setObjectName("c1");
+
+	a.setParentItem(&p1);
+	p1.setParentItem(&p2);
+	b.setParentItem(&c1);
+	c1.setParentItem(&p2);
+
+	auto watcher = TransformWatcher();
+	watcher.setA(&a);
+	watcher.setB(&b);
+
+	QCOMPARE(watcher.parentChain, (QList {&a, &p1, &p2}));
+	QCOMPARE(watcher.childChain, (QList {&b, &c1}));
+
+	auto spy = QSignalSpy(&watcher, &TransformWatcher::transformChanged);
+	c1.setParentItem(&p1);
+
+	QCoreApplication::processEvents();
+	QCOMPARE(spy.count(), 1);
+	QCOMPARE(watcher.parentChain, (QList {&a, &p1}));
+	QCOMPARE(watcher.childChain, (QList {&b, &c1}));
+}
+
 QTEST_MAIN(TestTransformWatcher);
@@ -11,4 +11,7 @@ private slots:
 	void bParentOfA();
 	void aParentChainB();
 	void multiWindow();
+	void batchedChanges();
+	void sharedItems();
+	void reparent();
 };
@@ -1,14 +1,22 @@
 #include "transformwatcher.hpp"
 
+#include <utility>
+
+#include <private/qquickitem_p.h>
+#include <private/qquickitemchangelistener_p.h>
 #include <qcontainerfwd.h>
 #include <qdebug.h>
 #include <qlist.h>
 #include <qlogging.h>
+#include <qnamespace.h>
 #include <qobject.h>
+#include <qpointer.h>
 #include <qquickitem.h>
 #include <qquickwindow.h>
 #include <qtmetamacros.h>
 
+#include "transformwatcher_p.hpp"
+
 void TransformWatcher::resolveChains(QQuickItem* a, QQuickItem* b, QQuickItem* commonParent) {
 	if (a == nullptr || b == nullptr) return;
 
@@ -73,48 +81,29 @@ void TransformWatcher::resolveChains() {
 	this->resolveChains(this->mA, this->mB, this->mCommonParent);
 }
 
-void TransformWatcher::linkItem(QQuickItem* item) const {
-	QObject::connect(item, &QQuickItem::xChanged, this, &TransformWatcher::transformChanged);
-	QObject::connect(item, &QQuickItem::yChanged, this, &TransformWatcher::transformChanged);
-	QObject::connect(item, &QQuickItem::widthChanged, this, &TransformWatcher::transformChanged);
-	QObject::connect(item, &QQuickItem::heightChanged, this, &TransformWatcher::transformChanged);
-	QObject::connect(item, &QQuickItem::scaleChanged, this, &TransformWatcher::transformChanged);
-	QObject::connect(item, &QQuickItem::rotationChanged, this, &TransformWatcher::transformChanged);
-
-	QObject::connect(item, &QQuickItem::parentChanged, this, &TransformWatcher::recalcChains);
-	QObject::connect(item, &QQuickItem::windowChanged, this, &TransformWatcher::recalcChains);
-
-	if (item != this->mA && item != this->mB) {
-		QObject::connect(item, &QObject::destroyed, this, &TransformWatcher::itemDestroyed);
-	}
-}
+TransformWatcher::~TransformWatcher() { this->unlinkChains(); }
 
 void TransformWatcher::linkChains() {
+	auto* tracker = TransformTracker::instance();
+
 	for (auto* item: this->parentChain) {
-		this->linkItem(item);
+		tracker->watch(item, this);
 	}
 
 	for (auto* item: this->childChain) {
-		this->linkItem(item);
+		tracker->watch(item, this);
 	}
 }
 
 void TransformWatcher::unlinkChains() {
+	auto* tracker = TransformTracker::instance();
+
 	for (auto* item: this->parentChain) {
-		QObject::disconnect(item, nullptr, this, nullptr);
+		tracker->unwatch(item, this);
 	}
 
 	for (auto* item: this->childChain) {
-		QObject::disconnect(item, nullptr, this, nullptr);
-	}
-
-	// relink a and b destruction notifications
-	if (this->mA != nullptr) {
-		QObject::connect(this->mA, &QObject::destroyed, this, &TransformWatcher::aDestroyed);
-	}
-
-	if (this->mB != nullptr) {
-		QObject::connect(this->mB, &QObject::destroyed, this, &TransformWatcher::bDestroyed);
+		tracker->unwatch(item, this);
 	}
 
 	this->parentChain.clear();
@@ -122,16 +111,17 @@ void TransformWatcher::unlinkChains() {
 }
 
 void TransformWatcher::recalcChains() {
+	this->chainsDirty = false;
 	this->unlinkChains();
 	this->resolveChains();
 	this->linkChains();
 }
 
-void TransformWatcher::itemDestroyed() {
-	auto destroyed =
-	    this->parentChain.removeOne(this->sender()) || this->childChain.removeOne(this->sender());
-
-	if (destroyed) this->recalcChains();
+void TransformWatcher::chainItemDestroyed(QQuickItem* item) {
+	// the tracker has already dropped the item, so it must not be unwatched again
+	this->parentChain.removeOne(item);
+	this->childChain.removeOne(item);
+	this->chainsDirty = true;
 }
 
 QQuickItem* TransformWatcher::a() const { return this->mA; }
@@ -181,3 +171,134 @@ void TransformWatcher::setCommonParent(QQuickItem* commonParent) {
 	this->mCommonParent = commonParent;
 	this->recalcChains();
 }
+
+namespace {
+
+constexpr auto TRACKED_CHANGES = QQuickItemPrivate::Geometry | QQuickItemPrivate::Rotation
+                               | QQuickItemPrivate::Parent | QQuickItemPrivate::Destroyed;
+
+} // namespace
+
+TransformTracker* TransformTracker::instance() {
+	static auto* instance = new TransformTracker(); // NOLINT
+	return instance;
+}
+
+void TransformTracker::watch(QQuickItem* item, TransformWatcher* watcher) {
+	auto iter = this->items.find(item);
+
+	if (iter == this->items.end()) {
+		iter = this->items.insert(item, {});
+		QQuickItemPrivate::get(item)->addItemChangeListener(this, TRACKED_CHANGES);
+
+		// no change listener callbacks exist for these
+		// clang-format off
+		QObject::connect(item, &QQuickItem::scaleChanged, this, &TransformTracker::onItemScaleChanged);
+		QObject::connect(item, &QQuickItem::windowChanged, this, &TransformTracker::onItemWindowChanged);
+		// clang-format on
+	}
+
+	iter->push_back(watcher);
+}
+
+void TransformTracker::unwatch(QQuickItem* item, TransformWatcher* watcher) {
+	auto iter = this->items.find(item);
+	if (iter == this->items.end()) return;
+
+	iter->removeOne(watcher);
+	if (!iter->isEmpty()) return;
+
+	this->items.erase(iter);
+	QQuickItemPrivate::get(item)->removeItemChangeListener(this, TRACKED_CHANGES);
+	QObject::disconnect(item, nullptr, this, nullptr);
+}
+
+void TransformTracker::itemGeometryChanged(
+    QQuickItem* item,
+    QQuickGeometryChange change,
+    const QRectF& /*oldGeometry*/
+) {
+	if (change.positionChange() || change.sizeChange()) this->markDirty(item, false);
+}
+
+void TransformTracker::itemRotationChanged(QQuickItem* item) { this->markDirty(item, false); }
+
+void TransformTracker::itemParentChanged(QQuickItem* item, QQuickItem* /*parent*/) {
+	this->markDirty(item, true);
+}
+
+void TransformTracker::onItemScaleChanged() {
+	this->markDirty(static_cast<QQuickItem*>(this->sender()), false); // NOLINT
+}
+
+void TransformTracker::onItemWindowChanged() {
+	this->markDirty(static_cast<QQuickItem*>(this->sender()), true); // NOLINT
+}
+
+void TransformTracker::itemDestroyed(QQuickItem* item) {
+	// Called from the item's destructor, which removes its own listeners.
+	auto watchers = this->items.take(item);
+	if (watchers.isEmpty()) return;
+
+	QObject::disconnect(item, nullptr, this, nullptr);
+
+	for (auto* watcher: watchers) {
+		watcher->chainItemDestroyed(item);
+
+		if (!watcher->dirty) {
+			watcher->dirty = true;
+			this->dirty.push_back(watcher);
+		}
+	}
+
+	this->scheduleFlush(nullptr);
+}
+
+void TransformTracker::markDirty(QQuickItem* item, bool chainsChanged) {
+	auto iter = this->items.constFind(item);
+	if (iter == this->items.constEnd()) return;
+
+	for (auto* watcher: *iter) {
+		if (chainsChanged) watcher->chainsDirty = true;
+		if (watcher->dirty) continue;
+
+		watcher->dirty = true;
+		this->dirty.push_back(watcher);
+	}
+
+	this->scheduleFlush(item->window());
+}
+
+void TransformTracker::scheduleFlush(QQuickWindow* window) {
+	// Changes made while animating are flushed before the window polishes its items, which
+	// is where popups are repositioned. Everything else is flushed from the event loop.
+	if (window != nullptr && !this->windows.contains(window)) {
+		this->windows.insert(window);
+		QObject::connect(window, &QQuickWindow::afterAnimating, this, &TransformTracker::flush);
+		QObject::connect(window, &QObject::destroyed, this, &TransformTracker::onWindowDestroyed);
+	}
+
+	if (!this->flushQueued) {
+		this->flushQueued = true;
+		QMetaObject::invokeMethod(this, &TransformTracker::flush, Qt::QueuedConnection);
+	}
+}
+
+void TransformTracker::onWindowDestroyed() {
+	this->windows.remove(static_cast<QQuickWindow*>(this->sender())); // NOLINT
+}
+
+void TransformTracker::flush() {
+	this->flushQueued = false;
+
+	// watchers may be marked dirty again while being notified
+	auto dirty = std::exchange(this->dirty, {});
+
+	for (auto& watcher: dirty) {
+		if (!watcher) continue;
+		watcher->dirty = false;
+
+		if (watcher->chainsDirty) watcher->recalcChains();
+		emit watcher->transformChanged();
+	}
+}
@@ -5,6 +5,7 @@
 #include <qqmlintegration.h>
 #include <qquickitem.h>
 #include <qquickwindow.h>
+#include <qtclasshelpermacros.h>
 #include <qtmetamacros.h>
 
 #ifdef QS_TEST
@@ -18,6 +19,9 @@ class TestTransformWatcher;
 /// > [!INFO] The algorithm responsible for determining the relationship
 /// > between `a` and `b` is biased towards `a` being a parent of `b`,
 /// > or `a` being closer to the common parent of `a` and `b` than `b`.
+///
+/// Changes are batched, and @@transform is updated at most once per frame,
+/// before popups are positioned.
 class TransformWatcher: public QObject {
 	Q_OBJECT;
 	// clang-format off
@@ -39,6 +43,8 @@ class TransformWatcher: public QObject {
 
 public:
 	explicit TransformWatcher(QObject* parent = nullptr): QObject(parent) {}
+	~TransformWatcher() override;
+	Q_DISABLE_COPY_MOVE(TransformWatcher);
 
 	[[nodiscard]] QQuickItem* a() const;
 	void setA(QQuickItem* a);
@@ -60,16 +66,15 @@ signals:
 
 private slots:
 	void recalcChains();
-	void itemDestroyed();
 	void aDestroyed();
 	void bDestroyed();
 
 private:
 	void resolveChains(QQuickItem* a, QQuickItem* b, QQuickItem* commonParent);
 	void resolveChains();
-	void linkItem(QQuickItem* item) const;
 	void linkChains();
 	void unlinkChains();
+	void chainItemDestroyed(QQuickItem* item);
 
 	QQuickItem* mA = nullptr;
 	QQuickItem* mB = nullptr;
@@ -81,6 +86,12 @@ private:
 	QQuickWindow* parentWindow = nullptr;
 	QQuickWindow* childWindow = nullptr;
 
+	// set by TransformTracker
+	bool dirty = false;
+	bool chainsDirty = false;
+
+	friend class TransformTracker;
+
 #ifdef QS_TEST
 	friend class TestTransformWatcher;
 #endif
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <private/qquickitemchangelistener_p.h>
+#include <qhash.h>
+#include <qlist.h>
+#include <qobject.h>
+#include <qpointer.h>
+#include <qquickitem.h>
+#include <qquickwindow.h>
+#include <qrect.h>
+#include <qset.h>
+#include <qtmetamacros.h>
+
+class TransformWatcher;
+
+// Shared geometry tracker for all TransformWatchers.
+//
+// Each item is observed once through an item change listener, no matter how many watchers
+// include it in their chains. Changes only mark watchers as dirty, and dirty watchers are
+// notified once, right after animations are advanced for the next frame (before polish,
+// where popups are repositioned) or from the event loop if no frame follows.
+class TransformTracker
+    : public QObject
+    , public QQuickItemChangeListener {
+	Q_OBJECT;
+
+public:
+	static TransformTracker* instance();
+
+	void watch(QQuickItem* item, TransformWatcher* watcher);
+	void unwatch(QQuickItem* item, TransformWatcher* watcher);
+
+	void itemGeometryChanged(QQuickItem* item, QQuickGeometryChange change, const QRectF& oldGeometry)
+	    override;
+	void itemRotationChanged(QQuickItem* item) override;
+	void itemParentChanged(QQuickItem* item, QQuickItem* parent) override;
+	void itemDestroyed(QQuickItem* item) override;
+
+public slots:
+	// Notifies all dirty watchers.
+	void flush();
+
+private slots:
+	void onItemScaleChanged();
+	void onItemWindowChanged();
+	void onWindowDestroyed();
+
+private:
+	explicit TransformTracker() = default;
+
+	void markDirty(QQuickItem* item, bool chainsChanged);
+	void scheduleFlush(QQuickWindow* window);
+
+	QHash<QQuickItem*, QList<TransformWatcher*>> items;
+	QList<QPointer<TransformWatcher>> dirty;
+	QSet<QQuickWindow*> windows;
+	bool flushQueued = false;
+};
@@ -6,11 +6,14 @@
 #include <qlogging.h>
 #include <qobject.h>
 #include <qqmlengine.h>
+#include <qqmlincubator.h>
 #include <qqmllist.h>
+#include <qstring.h>
 #include <qtmetamacros.h>
 #include <qtypes.h>
 #include <qvariant.h>
 
+#include "incubator.hpp"
 #include "reload.hpp"
 
 void Variants::onReload(QObject* oldInstance) {
@@ -123,16 +126,31 @@ void Variants::updateVariants() {
 		return;
 	}
 
+	auto hits = this->pool.hits();
+	auto misses = this->pool.misses();
+
 	// clean up removed entries
 	for (auto iter = this->mInstances.values.begin(); iter < this->mInstances.values.end();) {
 		if (this->mModel.contains(iter->first)) {
 			iter++;
 		} else {
-			iter->second->deleteLater();
+			this->releaseInstance(iter->second);
 			iter = this->mInstances.values.erase(iter);
 		}
 	}
 
+	for (auto iter = this->mIncubating.values.begin(); iter < this->mIncubating.values.end();) {
+		if (this->mModel.contains(iter->first)) {
+			iter++;
+		} else {
+			delete iter->second;
+			iter = this->mIncubating.values.erase(iter);
+		}
+	}
+
+	// after removed instances are parked, so instances of a replaced delegate are discarded
+	this->pool.setComponent(this->mDelegate);
+
 	for (auto iter = this->mModel.begin(); iter < this->mModel.end(); iter++) {
 		auto& variant = *iter;
 		for (auto iter2 = this->mModel.begin(); iter2 < iter; iter2++) {
@@ -144,13 +162,37 @@ void Variants::updateVariants() {
 		}
 
 		{
-			if (this->mInstances.contains(variant)) {
+			if (this->mInstances.contains(variant) || this->mIncubating.contains(variant)) {
 				continue; // we dont need to recreate this one
 			}
 
 			auto variantMap = QVariantMap();
 			variantMap.insert("modelData", variant);
 
+			// reused instances were already reloaded when they were first created
+			if (auto* instance = this->pool.take(variantMap)) {
+				this->mInstances.insert(variant, instance);
+				continue;
+			}
+
+			// Instances created before the reload must exist to be matched against the old generation.
+			if (this->mAsynchronous && this->loaded) {
+				auto* incubator = new QsQmlIncubator(QQmlIncubator::Asynchronous, this);
+				incubator->setInitialProperties(variantMap);
+				this->mIncubating.insert(variant, incubator);
+
+				QObject::connect(incubator, &QsQmlIncubator::completed, this, [=, this]() {
+					this->onIncubationCompleted(variant, incubator);
+				});
+
+				QObject::connect(incubator, &QsQmlIncubator::failed, this, [=, this]() {
+					this->onIncubationFailed(variant, incubator);
+				});
+
+				this->mDelegate->create(*incubator, QQmlEngine::contextForObject(this->mDelegate));
+				continue;
+			}
+
 			auto* instance = this->mDelegate->createWithInitialProperties(
 			    variantMap,
 			    QQmlEngine::contextForObject(this->mDelegate)
@@ -162,19 +204,79 @@ void Variants::updateVariants() {
 				continue;
 			}
 
-			QQmlEngine::setObjectOwnership(instance, QQmlEngine::CppOwnership);
+			this->addInstance(variant, instance);
+		}
+
+	outer:;
+	}
+
+	if (this->pool.hits() != hits || this->pool.misses() != misses) emit this->poolStatsChanged();
+}
 
-			instance->setParent(this);
-			this->mInstances.insert(variant, instance);
+void Variants::addInstance(const QVariant& variant, QObject* instance) {
+	QQmlEngine::setObjectOwnership(instance, QQmlEngine::CppOwnership);
 
-			if (this->loaded) {
-				if (auto* reloadable = qobject_cast<Reloadable*>(instance)) reloadable->reload(nullptr);
-				else Reloadable::reloadChildrenRecursive(instance, nullptr);
-			}
+	instance->setParent(this);
+	this->mInstances.insert(variant, instance);
+
+	if (this->loaded) {
+		if (auto* reloadable = qobject_cast<Reloadable*>(instance)) reloadable->reload(nullptr);
+		else Reloadable::reloadChildrenRecursive(instance, nullptr);
+	}
+}
+
+void Variants::releaseInstance(QObject* instance) {
+	if (!this->pool.park(instance)) instance->deleteLater();
+}
+
+void Variants::onIncubationCompleted(const QVariant& variant, QsQmlIncubator* incubator) {
+	this->mIncubating.remove(variant);
+	this->addInstance(variant, incubator->object());
+
+	// The incubator is not necessarily inert at the time of this callback,
+	// so deleteLater is required.
+	incubator->deleteLater();
+	emit this->instancesChanged();
+}
+
+void Variants::onIncubationFailed(const QVariant& variant, QsQmlIncubator* incubator) {
+	qWarning() << "failed to create variant with object" << variant;
+
+	for (auto& error: incubator->errors()) {
+		qWarning() << error;
+	}
+
+	this->mIncubating.remove(variant);
+	incubator->deleteLater();
+}
+
+void Variants::setReusePoolSize(qsizetype size) {
+	if (size < 0) size = 0;
+	if (size == this->pool.capacity()) return;
+
+	this->pool.setCapacity(size);
+	emit this->reusePoolSizeChanged();
+}
+
+void Variants::setAsynchronous(bool asynchronous) {
+	if (asynchronous == this->mAsynchronous) return;
+	this->mAsynchronous = asynchronous;
+	emit this->asynchronousChanged();
+}
+
+QString Variants::instanceKey(const QObject* instance) const {
+	for (const auto& [variant, object]: this->mInstances.values) {
+		if (object != instance) continue;
+
+		if (variant.canConvert<QString>()) {
+			auto string = variant.toString();
+			if (!string.isEmpty()) return string;
 		}
 
-	outer:;
+		return u'#' + QString::number(this->mModel.indexOf(variant));
 	}
+
+	return QString();
 }
 
 template <typename K, typename V>
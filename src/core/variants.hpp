@@ -11,7 +11,9 @@
 #include <qtmetamacros.h>
 #include <qvariant.h>
 
+#include "delegatepool.hpp"
 #include "doc.hpp"
+#include "incubator.hpp"
 #include "reload.hpp"
 
 // extremely inefficient map
@@ -52,6 +54,42 @@ class Variants: public Reloadable {
 	QSDOC_HIDE Q_PROPERTY(QVariant model READ model WRITE setModel NOTIFY modelChanged);
 	/// Current instances of the delegate.
 	Q_PROPERTY(QQmlListProperty<QObject> instances READ instances NOTIFY instancesChanged);
+	/// The maximum number of removed instances to keep for reuse. Defaults to 0, which
+	/// destroys instances as soon as their value is removed from the @@model.
+	///
+	/// When a value is removed, its instance is parked instead of being destroyed, and the
+	/// next added value reuses a parked instance by setting its `modelData`, instead of
+	/// creating a new one. This avoids constantly recreating delegates for models that change
+	/// often, such as lists of notifications or toplevels.
+	///
+	/// Parked instances stay alive, and are not part of @@instances. If the delegate defines
+	/// a `pooled()` function, it is called when the instance is parked, and `reused()` is
+	/// called after it is reused. Windows should usually hide themselves in `pooled()`.
+	///
+	/// ```qml
+	/// Variants {
+	///   model: Notifications.trackedNotifications
+	///   reusePoolSize: 5
+	///
+	///   NotificationPopup {
+	///     required property Notification modelData
+	///     function pooled() { visible = false }
+	///     function reused() { visible = true }
+	///   }
+	/// }
+	/// ```
+	Q_PROPERTY(qsizetype reusePoolSize READ reusePoolSize WRITE setReusePoolSize NOTIFY reusePoolSizeChanged);
+	/// The number of instances reused from the pool since the Variants was created.
+	Q_PROPERTY(qsizetype poolHits READ poolHits NOTIFY poolStatsChanged);
+	/// The number of instances created while @@reusePoolSize was non zero, because no
+	/// parked instance was available.
+	Q_PROPERTY(qsizetype poolMisses READ poolMisses NOTIFY poolStatsChanged);
+	/// If true, new instances are created asynchronously in the gaps between frames,
+	/// and are added to @@instances once complete. Defaults to false.
+	///
+	/// Instances are always created synchronously when the shell is reloaded,
+	/// so existing windows can be reused.
+	Q_PROPERTY(bool asynchronous READ asynchronous WRITE setAsynchronous NOTIFY asynchronousChanged);
 	Q_CLASSINFO("DefaultProperty", "delegate");
 	QML_ELEMENT;
 
@@ -66,18 +104,43 @@ public:
 
 	QQmlListProperty<QObject> instances();
 
+	[[nodiscard]] qsizetype reusePoolSize() const { return this->pool.capacity(); }
+	void setReusePoolSize(qsizetype size);
+
+	[[nodiscard]] qsizetype poolHits() const { return this->pool.hits(); }
+	[[nodiscard]] qsizetype poolMisses() const { return this->pool.misses(); }
+
+	[[nodiscard]] bool asynchronous() const { return this->mAsynchronous; }
+	void setAsynchronous(bool asynchronous);
+
+	// Identifies an instance by its model value, or by its position in the model if the value
+	// has no string form. Empty if the object is not a current instance.
+	[[nodiscard]] QString instanceKey(const QObject* instance) const;
+
 signals:
 	void modelChanged();
 	void instancesChanged();
+	void reusePoolSizeChanged();
+	void poolStatsChanged();
+	void asynchronousChanged();
 
 private:
 	static qsizetype instanceCount(QQmlListProperty<QObject>* prop);
 	static QObject* instanceAt(QQmlListProperty<QObject>* prop, qsizetype i);
 
 	void updateVariants();
+	void addInstance(const QVariant& variant, QObject* instance);
+	void releaseInstance(QObject* instance);
+	void onIncubationCompleted(const QVariant& variant, QsQmlIncubator* incubator);
+	void onIncubationFailed(const QVariant& variant, QsQmlIncubator* incubator);
 
 	QQmlComponent* mDelegate = nullptr;
 	QVariantList mModel;
 	AwfulMap<QVariant, QObject*> mInstances;
+	AwfulMap<QVariant, QsQmlIncubator*> mIncubating;
+	DelegatePool pool;
+	bool mAsynchronous = false;
 	bool loaded = false;
+
+	friend class TestDelegatePool;
 };
@@ -121,6 +121,12 @@ bool CrashHandlerPrivate::minidumpCallback(
 	if (infoFd != -1) my_uitos(&infoFdStr[27], infoFd, 10);
 	env[envi++] = infoFdStr.data();
 
+	auto stateFd = dup(CrashInfo::INSTANCE.stateFd);
+	auto stateFdStr = std::array<char, 39>();
+	memcpy(stateFdStr.data(), "__QUICKSHELL_CRASH_STATE_FD=-1" /*\0*/, 31);
+	if (stateFd != -1) my_uitos(&stateFdStr[28], stateFd, 10);
+	env[envi++] = stateFdStr.data();
+
 	auto corePidStr = std::array<char, 39>();
 	memcpy(corePidStr.data(), "__QUICKSHELL_CRASH_DUMP_PID=-1" /*\0*/, 31);
 	if (coredumpPid != -1) my_uitos(&corePidStr[28], coredumpPid, 10);
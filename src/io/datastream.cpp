@@ -1,12 +1,28 @@
 #include "datastream.hpp"
 #include <algorithm>
+#include <cctype>
+#include <cstring>
 #include <utility>
 
+#include <qbytearray.h>
+#include <qcontainerfwd.h>
+#include <qendian.h>
+#include <qjsonarray.h>
+#include <qjsondocument.h>
+#include <qjsonvalue.h>
 #include <qlocalsocket.h>
+#include <qlogging.h>
+#include <qloggingcategory.h>
+#include <qnamespace.h>
 #include <qobject.h>
+#include <qthreadpool.h>
 #include <qtmetamacros.h>
 #include <qtypes.h>
 
+namespace {
+Q_LOGGING_CATEGORY(logDataStream, "quickshell.io.datastream", QtWarningMsg);
+}
+
 DataStreamParser* DataStream::reader() const { return this->mReader; }
 
 void DataStream::setReader(DataStreamParser* reader) {
@@ -41,60 +57,91 @@ void DataStream::onBytesAvailable() {
 }
 
 void SplitParser::parseBytes(QByteArray& incoming, QByteArray& buffer) {
+	auto chunks = QList<QString>();
+
 	if (this->mSplitMarker.isEmpty()) {
 		if (!buffer.isEmpty()) {
-			emit this->read(QString(buffer));
+			chunks.push_back(QString(buffer));
 			buffer.clear();
 		}
 
-		emit this->read(QString(incoming));
+		if (&incoming != &buffer) chunks.push_back(QString(incoming));
+		this->deliver(chunks);
 		return;
 	}
 
 	// make sure we dont miss any delimiters in the buffer if the delimiter changes
+	qsizetype scanStart = 0;
 	if (this->mSplitMarkerChanged) {
 		this->mSplitMarkerChanged = false;
-		this->parseBytes(buffer, buffer);
+	} else if (&incoming != &buffer) {
+		// the buffer is leftover data which cannot contain a complete marker
+		auto leftover = buffer.size() - this->markerBytes.size() + 1;
+		scanStart = std::max(static_cast<qsizetype>(0), leftover);
 	}
 
-	auto marker = this->mSplitMarker.toUtf8();
-	auto mlen = marker.length();
+	if (&incoming != &buffer) buffer.append(incoming);
 
-	auto blen = buffer.size();
-	auto ilen = incoming.size();
+	const auto* data = buffer.constData();
+	auto size = buffer.size();
+	const auto* marker = this->markerBytes.constData();
+	auto mlen = this->markerBytes.size();
 
-	qsizetype start = &incoming == &buffer ? 0 : -blen;
-	for (auto readi = -std::min(blen, mlen - 1); readi <= ilen - mlen; readi++) {
-		for (auto marki = 0; marki < mlen; marki++) {
-			qint8 byte; // NOLINT
-			if (readi + marki < 0) byte = buffer[blen + readi + marki];
-			else byte = incoming[readi + marki];
+	qsizetype start = 0;
+	auto readi = scanStart;
 
-			if (byte != marker[marki]) goto fail;
-		}
+	while (readi <= size - mlen) {
+		const void* found = nullptr;
 
-		{
-			QByteArray slice;
-			if (start < 0) slice = buffer.sliced(0, std::min(blen, blen + readi));
-			if (readi > 0) {
-				auto sstart = std::max(static_cast<qsizetype>(0), start);
-				slice.append(incoming.sliced(sstart, readi - sstart));
-			}
-			readi += mlen;
-			start = readi;
-			emit this->read(QString(slice));
+		// both use vectorized implementations in common libcs
+		if (mlen == 1) {
+			found = memchr(data + readi, marker[0], size - readi);
+		} else {
+			found = memmem(data + readi, size - readi, marker, mlen);
 		}
 
-	fail:;
+		if (found == nullptr) break;
+
+		auto pos = static_cast<const char*>(found) - data;
+		chunks.push_back(QString::fromUtf8(data + start, pos - start));
+		readi = pos + mlen;
+		start = readi;
 	}
 
-	if (start < 0) {
-		buffer.append(incoming);
+	if (start != 0) buffer.remove(0, start);
+	this->deliver(chunks);
+}
+
+void SplitParser::deliver(QList<QString>& chunks) {
+	if (chunks.isEmpty()) return;
+
+	if (this->mThrottleInterval <= 0) {
+		this->emitChunks(chunks);
+		return;
+	}
+
+	this->pending.append(chunks);
+
+	// Deliver immediately if nothing was delivered during the last interval, otherwise
+	// wait until it ends.
+	if (!this->throttleTimer.isActive()) this->onThrottleTimeout();
+}
+
+void SplitParser::onThrottleTimeout() {
+	if (this->pending.isEmpty()) return;
+
+	auto chunks = std::exchange(this->pending, QList<QString>());
+	this->throttleTimer.start(this->mThrottleInterval);
+	this->emitChunks(chunks);
+}
+
+void SplitParser::emitChunks(const QList<QString>& chunks) {
+	if (this->mBatched) {
+		emit this->readBatch(chunks);
 	} else {
-		// Will break the init case if inlined. Must be before clear.
-		auto slice = incoming.sliced(start);
-		buffer.clear();
-		buffer.insert(0, slice);
+		for (const auto& chunk: chunks) {
+			emit this->read(chunk);
+		}
 	}
 }
 
@@ -104,6 +151,289 @@ void SplitParser::setSplitMarker(QString marker) {
 	if (marker == this->mSplitMarker) return;
 
 	this->mSplitMarker = std::move(marker);
+	this->markerBytes = this->mSplitMarker.toUtf8();
 	this->mSplitMarkerChanged = true;
 	emit this->splitMarkerChanged();
 }
+
+bool SplitParser::batched() const { return this->mBatched; }
+
+void SplitParser::setBatched(bool batched) {
+	if (batched == this->mBatched) return;
+	this->mBatched = batched;
+	emit this->batchedChanged();
+}
+
+qint32 SplitParser::throttleInterval() const { return this->mThrottleInterval; }
+
+void SplitParser::setThrottleInterval(qint32 interval) {
+	if (interval == this->mThrottleInterval) return;
+	this->mThrottleInterval = interval;
+
+	if (interval <= 0) {
+		this->throttleTimer.stop();
+		auto chunks = std::exchange(this->pending, QList<QString>());
+		if (!chunks.isEmpty()) this->emitChunks(chunks);
+	}
+
+	emit this->throttleIntervalChanged();
+}
+
+JsonLinesOperation::JsonLinesOperation(QByteArray data): data(std::move(data)) {
+	this->setAutoDelete(false);
+}
+
+void JsonLinesOperation::run() {
+	if (!this->shouldCancel.loadAcquire()) {
+		this->results = JsonLinesOperation::parseLines(this->data);
+	}
+
+	QMetaObject::invokeMethod(this, &JsonLinesOperation::finished, Qt::QueuedConnection);
+}
+
+void JsonLinesOperation::tryCancel() { this->shouldCancel.storeRelease(true); }
+
+void JsonLinesOperation::finished() {
+	if (!this->shouldCancel.loadAcquire()) emit this->done(this->results);
+	this->deleteLater();
+}
+
+QList<JsonLineResult> JsonLinesOperation::parseLines(const QByteArray& data) {
+	auto results = QList<JsonLineResult>();
+
+	const auto* begin = data.constData();
+	const auto* end = begin + data.size();
+
+	while (begin < end) {
+		const auto* newline = static_cast<const char*>(memchr(begin, '\n', end - begin));
+		if (newline == nullptr) newline = end;
+
+		const auto* first = begin;
+		while (first != newline && std::isspace(static_cast<unsigned char>(*first))) first++;
+
+		if (first != newline) {
+			// parsed in place, QJsonDocument copies what it keeps
+			auto line = QByteArray::fromRawData(first, newline - first);
+			auto result = JsonLineResult();
+			auto error = QJsonParseError();
+			auto document = QJsonDocument::fromJson(line, &error);
+
+			if (error.error == QJsonParseError::NoError) {
+				result.value = document.toVariant();
+			} else if (*first != '{' && *first != '[') {
+				// QJsonDocument only accepts objects and arrays at the top level
+				auto wrapped = QByteArray();
+				wrapped.reserve(line.size() + 2);
+				wrapped.append('[').append(line).append(']');
+
+				document = QJsonDocument::fromJson(wrapped, &error);
+				if (error.error == QJsonParseError::NoError) {
+					result.value = document.array().at(0).toVariant();
+				}
+			}
+
+			if (error.error != QJsonParseError::NoError) {
+				result.error = error.errorString();
+				result.line = QByteArray(first, newline - first);
+			}
+
+			results.push_back(std::move(result));
+		}
+
+		begin = newline + 1;
+	}
+
+	return results;
+}
+
+JsonLinesParser::~JsonLinesParser() {
+	if (this->liveOperation) {
+		// the operation deletes itself once the worker finishes
+		this->liveOperation->tryCancel();
+		QObject::disconnect(this->liveOperation, nullptr, this, nullptr);
+	}
+}
+
+void JsonLinesParser::parseBytes(QByteArray& incoming, QByteArray& buffer) {
+	auto* data = &incoming;
+	if (&incoming != &buffer && !buffer.isEmpty()) {
+		buffer.append(incoming);
+		data = &buffer;
+	}
+
+	const auto* lastNewline = static_cast<const char*>(memrchr(data->constData(), '\n', data->size()));
+
+	if (lastNewline == nullptr) {
+		if (data != &buffer) buffer = std::move(*data);
+		return;
+	}
+
+	// Only the partial last line is copied, complete lines are handed to the worker as is.
+	auto completeLength = lastNewline - data->constData() + 1;
+	auto remainder = QByteArray();
+
+	if (completeLength != data->size()) {
+		remainder = data->sliced(completeLength);
+		data->truncate(completeLength);
+	}
+
+	this->queued.push_back(std::move(*data));
+	buffer = std::move(remainder);
+
+	if (!this->liveOperation) this->startOperation();
+}
+
+void JsonLinesParser::startOperation() {
+	auto data = QByteArray();
+
+	if (this->queued.size() == 1) {
+		data = std::move(this->queued.first());
+	} else {
+		for (const auto& chunk: this->queued) {
+			data.append(chunk);
+		}
+	}
+
+	this->queued.clear();
+
+	// Only one operation runs at a time so values are delivered in order.
+	this->liveOperation = new JsonLinesOperation(std::move(data));
+
+	QObject::connect(
+	    this->liveOperation,
+	    &JsonLinesOperation::done,
+	    this,
+	    &JsonLinesParser::operationFinished
+	);
+
+	QThreadPool::globalInstance()->start(this->liveOperation);
+}
+
+void JsonLinesParser::operationFinished(const QList<JsonLineResult>& results) {
+	this->liveOperation = nullptr;
+	if (!this->queued.isEmpty()) this->startOperation();
+
+	for (const auto& result: results) {
+		if (result.error.isEmpty()) {
+			emit this->readValue(result.value);
+		} else {
+			qCWarning(logDataStream) << "Failed to parse JSON line" << result.line << result.error;
+			emit this->parseError(QString::fromUtf8(result.line), result.error);
+		}
+	}
+}
+
+void LengthPrefixedParser::parseBytes(QByteArray& incoming, QByteArray& buffer) {
+	auto* data = &incoming;
+	if (&incoming != &buffer && !buffer.isEmpty()) {
+		buffer.append(incoming);
+		data = &buffer;
+	}
+
+	// frames are read straight out of the stream buffer
+	const auto* begin = data->constData();
+	auto size = data->size();
+	auto prefixSize = this->mPrefixSize;
+
+	auto strings = QList<QString>();
+	auto frames = QList<QByteArray>();
+	qsizetype offset = 0;
+	auto corrupted = false;
+
+	while (size - offset >= prefixSize) {
+		auto length = this->readPrefix(begin + offset);
+
+		if (length > static_cast<quint64>(this->mMaxFrameSize)) {
+			qCWarning(logDataStream) << "Discarding stream data after frame of length" << length
+			                         << "exceeding maxFrameSize" << this->mMaxFrameSize;
+			corrupted = true;
+			break;
+		}
+
+		if (static_cast<quint64>(size - offset - prefixSize) < length) break;
+
+		const auto* frame = begin + offset + prefixSize;
+		auto frameSize = static_cast<qsizetype>(length);
+
+		if (this->mBinary) frames.push_back(QByteArray(frame, frameSize));
+		else strings.push_back(QString::fromUtf8(frame, frameSize));
+
+		offset += prefixSize + frameSize;
+	}
+
+	if (corrupted) {
+		buffer.clear();
+	} else if (data == &buffer) {
+		if (offset != 0) buffer.remove(0, offset);
+	} else if (offset == 0) {
+		buffer = std::move(*data);
+	} else {
+		buffer = data->sliced(offset);
+	}
+
+	for (const auto& frame: frames) {
+		emit this->readBytes(frame);
+	}
+
+	for (const auto& string: strings) {
+		emit this->read(string);
+	}
+}
+
+quint64 LengthPrefixedParser::readPrefix(const char* data) const {
+	switch (this->mPrefixSize) {
+	case 1: return static_cast<quint8>(*data);
+	case 2:
+		return this->mLittleEndian ? qFromLittleEndian<quint16>(data) : qFromBigEndian<quint16>(data);
+	case 4:
+		return this->mLittleEndian ? qFromLittleEndian<quint32>(data) : qFromBigEndian<quint32>(data);
+	default:
+		return this->mLittleEndian ? qFromLittleEndian<quint64>(data) : qFromBigEndian<quint64>(data);
+	}
+}
+
+qint32 LengthPrefixedParser::prefixSize() const { return this->mPrefixSize; }
+
+void LengthPrefixedParser::setPrefixSize(qint32 prefixSize) {
+	if (prefixSize == this->mPrefixSize) return;
+
+	if (prefixSize != 1 && prefixSize != 2 && prefixSize != 4 && prefixSize != 8) {
+		qCWarning(logDataStream) << "Ignoring invalid prefixSize" << prefixSize
+		                         << "for LengthPrefixedParser. Must be 1, 2, 4 or 8.";
+		return;
+	}
+
+	this->mPrefixSize = prefixSize;
+	emit this->prefixSizeChanged();
+}
+
+bool LengthPrefixedParser::littleEndian() const { return this->mLittleEndian; }
+
+void LengthPrefixedParser::setLittleEndian(bool littleEndian) {
+	if (littleEndian == this->mLittleEndian) return;
+	this->mLittleEndian = littleEndian;
+	emit this->littleEndianChanged();
+}
+
+bool LengthPrefixedParser::binary() const { return this->mBinary; }
+
+void LengthPrefixedParser::setBinary(bool binary) {
+	if (binary == this->mBinary) return;
+	this->mBinary = binary;
+	emit this->binaryChanged();
+}
+
+qint64 LengthPrefixedParser::maxFrameSize() const { return this->mMaxFrameSize; }
+
+void LengthPrefixedParser::setMaxFrameSize(qint64 maxFrameSize) {
+	if (maxFrameSize == this->mMaxFrameSize) return;
+
+	if (maxFrameSize < 0) {
+		qCWarning(logDataStream) << "Ignoring negative maxFrameSize" << maxFrameSize
+		                         << "for LengthPrefixedParser.";
+		return;
+	}
+
+	this->mMaxFrameSize = maxFrameSize;
+	emit this->maxFrameSizeChanged();
+}
@@ -1,10 +1,16 @@
 #pragma once
 
+#include <qatomic.h>
 #include <qbytearray.h>
+#include <qcontainerfwd.h>
 #include <qlocalsocket.h>
 #include <qobject.h>
 #include <qqmlintegration.h>
+#include <qrunnable.h>
+#include <qtclasshelpermacros.h>
+#include <qtimer.h>
 #include <qtmetamacros.h>
+#include <qtypes.h>
 #include <qvariant.h>
 
 class DataStreamParser;
@@ -62,6 +68,9 @@ signals:
 
 ///! Parser for delimited data streams.
 /// Parser for delimited data streams. @@read() is emitted once per delimited chunk of the stream.
+///
+/// For chatty sources, @@batched and @@throttleInterval can be used to reduce the number
+/// of signals delivered to QML.
 class SplitParser: public DataStreamParser {
 	Q_OBJECT;
 	/// The delimiter for parsed data. May be multiple characters. Defaults to `\n`.
@@ -69,20 +78,189 @@ class SplitParser: public DataStreamParser {
 	/// If the delimiter is empty read lengths may be arbitrary (whatever is returned by the
 	/// underlying read call.)
 	Q_PROPERTY(QString splitMarker READ splitMarker WRITE setSplitMarker NOTIFY splitMarkerChanged);
+	/// If true, all chunks completed by a single read are delivered together through
+	/// @@readBatch() instead of one @@DataStreamParser.read() per chunk. Defaults to false.
+	Q_PROPERTY(bool batched READ batched WRITE setBatched NOTIFY batchedChanged);
+	/// Minimum time in milliseconds between deliveries. Defaults to 0, which delivers chunks
+	/// as soon as they are read.
+	///
+	/// Chunks completed while waiting are held and delivered together once the interval
+	/// has passed. No data is dropped.
+	Q_PROPERTY(qint32 throttleInterval READ throttleInterval WRITE setThrottleInterval NOTIFY throttleIntervalChanged);
 	QML_ELEMENT;
 
 public:
-	explicit SplitParser(QObject* parent = nullptr): DataStreamParser(parent) {}
+	explicit SplitParser(QObject* parent = nullptr): DataStreamParser(parent) {
+		this->throttleTimer.setSingleShot(true);
+		QObject::connect(
+		    &this->throttleTimer,
+		    &QTimer::timeout,
+		    this,
+		    &SplitParser::onThrottleTimeout
+		);
+	}
 
 	void parseBytes(QByteArray& incoming, QByteArray& buffer) override;
 
 	[[nodiscard]] QString splitMarker() const;
 	void setSplitMarker(QString marker);
 
+	[[nodiscard]] bool batched() const;
+	void setBatched(bool batched);
+
+	[[nodiscard]] qint32 throttleInterval() const;
+	void setThrottleInterval(qint32 interval);
+
 signals:
+	/// Emitted instead of @@DataStreamParser.read() if @@batched is true.
+	void readBatch(QList<QString> data);
+
 	void splitMarkerChanged();
+	void batchedChanged();
+	void throttleIntervalChanged();
+
+private slots:
+	void onThrottleTimeout();
 
 private:
+	void deliver(QList<QString>& chunks);
+	void emitChunks(const QList<QString>& chunks);
+
 	QString mSplitMarker = "\n";
+	QByteArray markerBytes = "\n";
 	bool mSplitMarkerChanged = false;
+	bool mBatched = false;
+	qint32 mThrottleInterval = 0;
+	QList<QString> pending;
+	QTimer throttleTimer;
+};
+
+struct JsonLineResult {
+	QVariant value;
+	// empty if the line was parsed successfully
+	QString error;
+	QByteArray line;
+};
+
+class JsonLinesOperation
+    : public QObject
+    , public QRunnable {
+	Q_OBJECT;
+
+public:
+	explicit JsonLinesOperation(QByteArray data);
+
+	void run() override;
+	void tryCancel();
+
+	// Parses each non empty line of data as a JSON value.
+	static QList<JsonLineResult> parseLines(const QByteArray& data);
+
+signals:
+	void done(QList<JsonLineResult> results);
+
+private slots:
+	void finished();
+
+private:
+	QAtomicInteger<bool> shouldCancel = false;
+	QByteArray data;
+	QList<JsonLineResult> results;
+};
+
+///! Parser for newline delimited JSON.
+/// Parser for streams of newline delimited JSON values, such as the output of
+/// `swaymsg -m -t subscribe` or most JSON-lines logs.
+///
+/// Lines are decoded on a background thread and delivered as JS values through
+/// @@readValue(), in the order they were read. This is considerably cheaper than
+/// calling `JSON.parse` on the output of a @@SplitParser.
+///
+/// ```qml
+/// Process {
+///   command: ["some-command", "--json"]
+///   stdout: JsonLinesParser {
+///     onReadValue: value => console.log(value.name)
+///   }
+/// }
+/// ```
+class JsonLinesParser: public DataStreamParser {
+	Q_OBJECT;
+	QML_ELEMENT;
+
+public:
+	explicit JsonLinesParser(QObject* parent = nullptr): DataStreamParser(parent) {}
+	~JsonLinesParser() override;
+	Q_DISABLE_COPY_MOVE(JsonLinesParser);
+
+	void parseBytes(QByteArray& incoming, QByteArray& buffer) override;
+
+signals:
+	/// Emitted for each JSON value read from the stream.
+	void readValue(QVariant value);
+	/// Emitted for each line that could not be parsed as JSON.
+	void parseError(QString data, QString error);
+
+private slots:
+	void operationFinished(const QList<JsonLineResult>& results);
+
+private:
+	void startOperation();
+
+	// complete lines waiting for the running operation to finish
+	QList<QByteArray> queued;
+	JsonLinesOperation* liveOperation = nullptr;
+};
+
+///! Parser for length prefixed data streams.
+/// Parser for streams of frames, each preceded by its length as an unsigned integer.
+/// @@DataStreamParser.read() is emitted with the UTF-8 decoded content of each frame,
+/// or @@readBytes() if @@binary is true.
+class LengthPrefixedParser: public DataStreamParser {
+	Q_OBJECT;
+	/// Size of the length prefix in bytes. Must be 1, 2, 4 or 8. Defaults to 4.
+	Q_PROPERTY(qint32 prefixSize READ prefixSize WRITE setPrefixSize NOTIFY prefixSizeChanged);
+	/// If the length prefix is little endian. Defaults to false (network byte order).
+	Q_PROPERTY(bool littleEndian READ littleEndian WRITE setLittleEndian NOTIFY littleEndianChanged);
+	/// If frames should be delivered as raw bytes through @@readBytes() instead of
+	/// strings through @@DataStreamParser.read(). Defaults to false.
+	Q_PROPERTY(bool binary READ binary WRITE setBinary NOTIFY binaryChanged);
+	/// Frames larger than this many bytes are treated as stream corruption, and all
+	/// buffered data is discarded. Defaults to 64MiB. Negative values are ignored.
+	Q_PROPERTY(qint64 maxFrameSize READ maxFrameSize WRITE setMaxFrameSize NOTIFY maxFrameSizeChanged);
+	QML_ELEMENT;
+
+public:
+	explicit LengthPrefixedParser(QObject* parent = nullptr): DataStreamParser(parent) {}
+
+	void parseBytes(QByteArray& incoming, QByteArray& buffer) override;
+
+	[[nodiscard]] qint32 prefixSize() const;
+	void setPrefixSize(qint32 prefixSize);
+
+	[[nodiscard]] bool littleEndian() const;
+	void setLittleEndian(bool littleEndian);
+
+	[[nodiscard]] bool binary() const;
+	void setBinary(bool binary);
+
+	[[nodiscard]] qint64 maxFrameSize() const;
+	void setMaxFrameSize(qint64 maxFrameSize);
+
+signals:
+	/// Emitted with the content of each frame if @@binary is true.
+	void readBytes(QByteArray data);
+
+	void prefixSizeChanged();
+	void littleEndianChanged();
+	void binaryChanged();
+	void maxFrameSizeChanged();
+
+private:
+	[[nodiscard]] quint64 readPrefix(const char* data) const;
+
+	qint32 mPrefixSize = 4;
+	bool mLittleEndian = false;
+	bool mBinary = false;
+	qint64 mMaxFrameSize = 64ll * 1024 * 1024;
 };
@@ -1,12 +1,26 @@
 #include "ipccomm.hpp"
+#include <array>
+#include <cerrno>
 #include <cstdio>
+#include <utility>
 #include <variant>
 
+#include <private/qobject_p.h>
+#include <qbytearray.h>
 #include <qcontainerfwd.h>
+#include <qeventloop.h>
+#include <qlocalsocket.h>
 #include <qlogging.h>
 #include <qloggingcategory.h>
+#include <qmetaobject.h>
+#include <qobject.h>
+#include <qobjectdefs.h>
+#include <qobjectdefs_impl.h>
+#include <qqueue.h>
+#include <qsocketnotifier.h>
 #include <qtextstream.h>
 #include <qtypes.h>
+#include <unistd.h>
 
 #include "../core/generation.hpp"
 #include "../core/logging.hpp"
@@ -184,36 +198,22 @@ void StringCallCommand::exec(qs::ipc::IpcServerConnection* conn) const {
 	}
 }
 
-int callFunction(
-    IpcClient* client,
-    const QString& target,
-    const QString& function,
-    const QVector<QString>& arguments
-) {
-	if (target.isEmpty()) {
-		qCCritical(logBare) << "Target required to send message.";
-		return -1;
-	} else if (function.isEmpty()) {
-		qCCritical(logBare) << "Function required to send message.";
-		return -1;
-	}
-
-	client->sendMessage(
-	    IpcCommand(StringCallCommand {.target = target, .function = function, .arguments = arguments})
-	);
-
-	StringCallResponse slot;
-	if (!client->waitForResponse(slot)) return -1;
+namespace {
 
+int handleCallResponse(
+    const StringCallResponse& slot,
+    const QVector<QString>& arguments,
+    IpcClient* client
+) {
 	if (std::holds_alternative<Completed>(slot)) {
-		auto& result = std::get<Completed>(slot);
+		const auto& result = std::get<Completed>(slot);
 		if (!result.isVoid) {
 			QTextStream(stdout) << result.returnValue << Qt::endl;
 		}
 
 		return 0;
 	} else if (std::holds_alternative<ArgParseFailed>(slot)) {
-		auto& error = std::get<ArgParseFailed>(slot);
+		const auto& error = std::get<ArgParseFailed>(slot);
 
 		if (error.isCountMismatch) {
 			auto correctCount = error.definition.arguments.length();
@@ -245,6 +245,61 @@ int callFunction(
 	return -1;
 }
 
+} // namespace
+
+int callFunction(
+    IpcClient* client,
+    const QString& target,
+    const QString& function,
+    const QVector<QString>& arguments
+) {
+	if (target.isEmpty()) {
+		qCCritical(logBare) << "Target required to send message.";
+		return -1;
+	} else if (function.isEmpty()) {
+		qCCritical(logBare) << "Function required to send message.";
+		return -1;
+	}
+
+	client->sendMessage(
+	    IpcCommand(StringCallCommand {.target = target, .function = function, .arguments = arguments})
+	);
+
+	StringCallResponse slot;
+	if (!client->waitForResponse(slot)) return -1;
+
+	return handleCallResponse(slot, arguments, client);
+}
+
+RawCallResult tryCallFunction(
+    RawIpcClient* client,
+    const QString& target,
+    const QString& function,
+    const QVector<QString>& arguments
+) {
+	if (target.isEmpty() || function.isEmpty()) return RawCallResult::Rejected;
+
+	auto command = StringCallCommand {.target = target, .function = function, .arguments = arguments};
+
+	// a partially sent command is never executed
+	if (!client->sendMessage(IpcCommand(command))) return RawCallResult::Rejected;
+
+	StringCallResponse slot;
+	if (!client->waitForResponse(slot)) {
+		qCCritical(logIpc) << "Error occurred while waiting for response.";
+		return RawCallResult::ConnectionLost;
+	}
+
+	if (!std::holds_alternative<Completed>(slot)) return RawCallResult::Rejected;
+
+	auto& result = std::get<Completed>(slot);
+	if (!result.isVoid) {
+		QTextStream(stdout) << result.returnValue << Qt::endl;
+	}
+
+	return RawCallResult::Completed;
+}
+
 struct PropertyValue {
 	QString value;
 };
@@ -283,6 +338,27 @@ void StringPropReadCommand::exec(qs::ipc::IpcServerConnection* conn) const {
 	}
 }
 
+namespace {
+
+int handlePropReadResponse(const StringPropReadResponse& slot, IpcClient* client) {
+	if (std::holds_alternative<PropertyValue>(slot)) {
+		QTextStream(stdout) << std::get<PropertyValue>(slot).value << Qt::endl;
+		return 0;
+	} else if (std::holds_alternative<TargetNotFound>(slot)) {
+		qCCritical(logBare) << "Target not found.";
+	} else if (std::holds_alternative<EntryNotFound>(slot)) {
+		qCCritical(logBare) << "Property not found.";
+	} else if (std::holds_alternative<NoCurrentGeneration>(slot)) {
+		qCCritical(logBare) << "Not ready to accept queries yet.";
+	} else {
+		qCCritical(logIpc) << "Received invalid IPC response from" << client;
+	}
+
+	return -1;
+}
+
+} // namespace
+
 int getProperty(IpcClient* client, const QString& target, const QString& property) {
 	if (target.isEmpty()) {
 		qCCritical(logBare) << "Target required to send message.";
@@ -297,21 +373,386 @@ int getProperty(IpcClient* client, const QString& target, const QString& propert
 	StringPropReadResponse slot;
 	if (!client->waitForResponse(slot)) return -1;
 
-	if (std::holds_alternative<PropertyValue>(slot)) {
-		auto& result = std::get<PropertyValue>(slot);
-		QTextStream(stdout) << result.value << Qt::endl;
-		return 0;
-	} else if (std::holds_alternative<TargetNotFound>(slot)) {
-		qCCritical(logBare) << "Target not found.";
-	} else if (std::holds_alternative<EntryNotFound>(slot)) {
-		qCCritical(logBare) << "Property not found.";
-	} else if (std::holds_alternative<NoCurrentGeneration>(slot)) {
-		qCCritical(logBare) << "Not ready to accept queries yet.";
+	return handlePropReadResponse(slot, client);
+}
+
+RawCallResult
+tryGetProperty(RawIpcClient* client, const QString& target, const QString& property) {
+	if (target.isEmpty() || property.isEmpty()) return RawCallResult::Rejected;
+
+	auto command = StringPropReadCommand {.target = target, .property = property};
+	if (!client->sendMessage(IpcCommand(command))) return RawCallResult::Rejected;
+
+	StringPropReadResponse slot;
+	if (!client->waitForResponse(slot)) {
+		qCCritical(logIpc) << "Error occurred while waiting for response.";
+		return RawCallResult::ConnectionLost;
+	}
+
+	if (!std::holds_alternative<PropertyValue>(slot)) return RawCallResult::Rejected;
+
+	QTextStream(stdout) << std::get<PropertyValue>(slot).value << Qt::endl;
+	return RawCallResult::Completed;
+}
+
+struct SubscriptionUpdate {
+	QString name;
+	// the value of a property, or the arguments of a signal
+	QVector<QString> values;
+};
+
+DEFINE_SIMPLE_DATASTREAM_OPS(SubscriptionUpdate, data.name, data.values);
+
+struct TargetDestroyed: std::monostate {};
+
+using SubscriptionEvent = std::variant<
+    std::monostate,
+    NoCurrentGeneration,
+    TargetNotFound,
+    EntryNotFound,
+    SubscriptionUpdate,
+    TargetDestroyed>;
+
+namespace {
+
+// Forwards property changes and signal emissions of an IpcHandler to a connection.
+class IpcSubscription: public QObject {
+public:
+	using Member = std::variant<IpcProperty, IpcSignal>;
+
+	explicit IpcSubscription(IpcHandler* handler, IpcServerConnection* conn)
+	    : QObject(conn)
+	    , handler(handler)
+	    , conn(conn) {
+		QObject::connect(handler, &QObject::destroyed, this, [this]() {
+			this->conn->respond(SubscriptionEvent(TargetDestroyed()));
+			this->conn->socket->disconnectFromServer();
+			this->deleteLater();
+		});
+	}
+
+	void addMember(Member member) {
+		auto signal = std::holds_alternative<IpcProperty>(member)
+		                ? std::get<IpcProperty>(member).property.notifySignal()
+		                : std::get<IpcSignal>(member).method;
+
+		// Handler signals are declared in QML and may have any signature. A slot object
+		// receives the raw arguments of an emission regardless of the signal's signature.
+		QObjectPrivate::connect(
+		    this->handler,
+		    signal.methodIndex(),
+		    this,
+		    new MemberSlot(this, this->members.length()),
+		    Qt::DirectConnection
+		);
+
+		this->members.push_back(std::move(member));
+	}
+
+	// Sends the current value of all subscribed properties.
+	void sendProperties() {
+		for (const auto& member: this->members) {
+			if (std::holds_alternative<IpcProperty>(member)) {
+				this->sendProperty(std::get<IpcProperty>(member));
+			}
+		}
+	}
+
+private:
+	class MemberSlot: public QtPrivate::QSlotObjectBase {
+	public:
+		explicit MemberSlot(IpcSubscription* subscription, qsizetype index)
+		    : QSlotObjectBase(&MemberSlot::impl)
+		    , subscription(subscription)
+		    , index(index) {}
+
+		static void
+		impl(int which, QSlotObjectBase* base, QObject* /*receiver*/, void** args, bool* /*ret*/) {
+			auto* self = static_cast<MemberSlot*>(base); // NOLINT
+
+			if (which == QSlotObjectBase::Destroy) {
+				delete self;
+			} else if (which == QSlotObjectBase::Call) {
+				self->subscription->onMemberEmitted(self->index, args);
+			}
+		}
+
+	private:
+		IpcSubscription* subscription;
+		qsizetype index;
+	};
+
+	void onMemberEmitted(qsizetype index, void** args) {
+		const auto& member = this->members.at(index);
+
+		if (std::holds_alternative<IpcProperty>(member)) {
+			this->sendProperty(std::get<IpcProperty>(member));
+		} else {
+			const auto& signal = std::get<IpcSignal>(member);
+
+			this->conn->respond(SubscriptionEvent(SubscriptionUpdate {
+			    .name = signal.method.name(),
+			    .values = signal.argumentStrings(args),
+			}));
+		}
+	}
+
+	void sendProperty(const IpcProperty& property) {
+		auto slot = IpcTypeSlot(property.type);
+		property.read(this->handler, slot);
+
+		this->conn->respond(SubscriptionEvent(SubscriptionUpdate {
+		    .name = property.property.name(),
+		    .values = {slot.type()->toString(slot.get())},
+		}));
+	}
+
+	IpcHandler* handler;
+	IpcServerConnection* conn;
+	QVector<Member> members;
+};
+
+} // namespace
+
+void SubscribeCommand::exec(qs::ipc::IpcServerConnection* conn) const {
+	auto resp = conn->responseStream<SubscriptionEvent>();
+
+	auto* generation = EngineGeneration::currentGeneration();
+	if (!generation) {
+		resp << NoCurrentGeneration();
+		return;
+	}
+
+	auto* handler = IpcHandlerRegistry::forGeneration(generation)->findHandler(this->target);
+	if (!handler) {
+		resp << TargetNotFound();
+		return;
+	}
+
+	auto members = QVector<IpcSubscription::Member>();
+
+	if (this->name.isEmpty()) {
+		for (const auto& name: handler->propertyNames()) {
+			members.push_back(*handler->findProperty(name));
+		}
+
+		for (const auto& name: handler->signalNames()) {
+			members.push_back(*handler->findSignal(name));
+		}
+	} else if (auto* prop = handler->findProperty(this->name)) {
+		members.push_back(*prop);
+	} else if (auto* signal = handler->findSignal(this->name)) {
+		members.push_back(*signal);
 	} else {
-		qCCritical(logIpc) << "Received invalid IPC response from" << client;
+		resp << EntryNotFound();
+		return;
 	}
 
-	return -1;
+	auto* subscription = new IpcSubscription(handler, conn);
+
+	for (auto& member: members) {
+		subscription->addMember(std::move(member));
+	}
+
+	subscription->sendProperties();
+}
+
+int subscribe(IpcClient* client, const QString& target, const QString& name) {
+	if (target.isEmpty()) {
+		qCCritical(logBare) << "Target required to subscribe.";
+		return -1;
+	}
+
+	client->sendMessage(IpcCommand(SubscribeCommand {.target = target, .name = name}));
+
+	auto out = QTextStream(stdout);
+
+	while (true) {
+		SubscriptionEvent slot;
+		if (!client->waitForResponse(slot)) return -1;
+
+		if (std::holds_alternative<SubscriptionUpdate>(slot)) {
+			const auto& update = std::get<SubscriptionUpdate>(slot);
+			if (name.isEmpty()) out << update.name << '\t';
+			out << update.values.join('\t') << Qt::endl;
+			continue;
+		} else if (std::holds_alternative<TargetDestroyed>(slot)) {
+			qCInfo(logBare) << "Target was destroyed.";
+			return 0;
+		} else if (std::holds_alternative<TargetNotFound>(slot)) {
+			qCCritical(logBare) << "Target not found.";
+		} else if (std::holds_alternative<EntryNotFound>(slot)) {
+			qCCritical(logBare) << "Property or signal not found.";
+		} else if (std::holds_alternative<NoCurrentGeneration>(slot)) {
+			qCCritical(logBare) << "Not ready to accept queries yet.";
+		} else {
+			qCCritical(logIpc) << "Received invalid IPC response from" << client;
+		}
+
+		return -1;
+	}
+}
+
+namespace {
+
+// Splits a batch line into words. Words may be quoted with single or double quotes, and
+// backslashes escape the next character outside of single quotes.
+bool splitBatchLine(const QString& line, QVector<QString>& words) {
+	auto word = QString();
+	auto inWord = false;
+	auto quote = QChar();
+
+	for (qsizetype i = 0; i < line.length(); i++) {
+		auto c = line.at(i);
+
+		if (!quote.isNull()) {
+			if (c == quote) quote = QChar();
+			else if (c == u'\\' && quote == u'"' && i + 1 < line.length()) word += line.at(++i);
+			else word += c;
+		} else if (c.isSpace()) {
+			if (inWord) words += word;
+			word.clear();
+			inWord = false;
+		} else {
+			inWord = true;
+			if (c == u'\'' || c == u'"') quote = c;
+			else if (c == u'\\' && i + 1 < line.length()) word += line.at(++i);
+			else word += c;
+		}
+	}
+
+	if (!quote.isNull()) return false;
+	if (inWord) words += word;
+	return true;
+}
+
+struct PendingBatchCommand {
+	qsizetype line = 0;
+	bool isProperty = false;
+	QVector<QString> arguments;
+};
+
+} // namespace
+
+int runBatch(IpcClient* client) {
+	auto loop = QEventLoop();
+	auto pending = QQueue<PendingBatchCommand>();
+	auto input = QByteArray();
+	qsizetype lineNumber = 0;
+	auto inputClosed = false;
+	auto failed = false;
+
+	auto runLine = [&](const QString& line) {
+		lineNumber++;
+
+		auto words = QVector<QString>();
+		if (!splitBatchLine(line, words)) {
+			qCCritical(logBare).nospace() << "Line " << lineNumber << ": Unterminated quote.";
+			failed = true;
+			return;
+		}
+
+		if (words.isEmpty() || words.first().startsWith(u'#')) return;
+
+		if (words.length() >= 3 && words.at(0) == "call") {
+			auto command = PendingBatchCommand {.line = lineNumber, .arguments = words.mid(3)};
+
+			client->sendMessage(IpcCommand(StringCallCommand {
+			    .target = words.at(1),
+			    .function = words.at(2),
+			    .arguments = command.arguments,
+			}));
+
+			pending.enqueue(std::move(command));
+		} else if (words.length() == 4 && words.at(0) == "prop" && words.at(1) == "get") {
+			client->sendMessage(
+			    IpcCommand(StringPropReadCommand {.target = words.at(2), .property = words.at(3)})
+			);
+
+			pending.enqueue(PendingBatchCommand {.line = lineNumber, .isProperty = true});
+		} else {
+			qCCritical(logBare).nospace()
+			    << "Line " << lineNumber
+			    << ": Expected `call <target> <function> [arguments...]` or `prop get <target> "
+			       "<property>`.";
+			failed = true;
+		}
+	};
+
+	auto readResponses = [&]() {
+		// responses arrive in the order commands were sent
+		while (!pending.isEmpty()) {
+			const auto& command = pending.head();
+			auto r = 0;
+
+			client->stream.startTransaction();
+
+			if (command.isProperty) {
+				StringPropReadResponse slot;
+				client->stream >> slot;
+				if (!client->stream.commitTransaction()) break;
+				r = handlePropReadResponse(slot, client);
+			} else {
+				StringCallResponse slot;
+				client->stream >> slot;
+				if (!client->stream.commitTransaction()) break;
+				r = handleCallResponse(slot, command.arguments, client);
+			}
+
+			if (r != 0) {
+				qCCritical(logBare).nospace() << "(from line " << command.line << ')';
+				failed = true;
+			}
+
+			pending.dequeue();
+		}
+
+		if (inputClosed && pending.isEmpty()) loop.quit();
+	};
+
+	auto notifier = QSocketNotifier(STDIN_FILENO, QSocketNotifier::Read);
+
+	QObject::connect(&notifier, &QSocketNotifier::activated, &loop, [&]() {
+		auto buf = std::array<char, 4096>();
+		auto r = read(STDIN_FILENO, buf.data(), buf.size());
+
+		if (r == -1 && (errno == EINTR || errno == EAGAIN)) return;
+
+		if (r <= 0) {
+			notifier.setEnabled(false);
+			if (!input.isEmpty()) runLine(QString::fromUtf8(input));
+			input.clear();
+
+			inputClosed = true;
+			readResponses();
+			return;
+		}
+
+		input.append(buf.data(), r);
+
+		qsizetype start = 0;
+		for (auto end = input.indexOf('\n'); end != -1; end = input.indexOf('\n', start)) {
+			runLine(QString::fromUtf8(input.sliced(start, end - start)));
+			start = end + 1;
+		}
+
+		input.remove(0, start);
+	});
+
+	QObject::connect(&client->socket, &QLocalSocket::readyRead, &loop, readResponses);
+
+	QObject::connect(&client->socket, &QLocalSocket::disconnected, &loop, [&]() {
+		readResponses();
+
+		if (!inputClosed || !pending.isEmpty()) {
+			qCCritical(logBare) << "The instance closed the connection.";
+			failed = true;
+			loop.quit();
+		}
+	});
+
+	loop.exec();
+	return failed ? -1 : 0;
 }
 
 } // namespace qs::io::ipc::comm
@@ -37,6 +37,23 @@ int callFunction(
     const QVector<QString>& arguments
 );
 
+enum class RawCallResult : quint8 {
+	Completed,
+	// The server refused the request without executing it, e.g. because the target was not
+	// found. The request can be retried through an IpcClient to report the error.
+	Rejected,
+	// The connection failed after the request was sent. It may or may not have been executed.
+	ConnectionLost,
+};
+
+// Calls a function, printing the return value if it completes. Rejections are not reported.
+RawCallResult tryCallFunction(
+    qs::ipc::RawIpcClient* client,
+    const QString& target,
+    const QString& function,
+    const QVector<QString>& arguments
+);
+
 struct StringPropReadCommand {
 	QString target;
 	QString property;
@@ -48,4 +65,24 @@ DEFINE_SIMPLE_DATASTREAM_OPS(StringPropReadCommand, data.target, data.property);
 
 int getProperty(qs::ipc::IpcClient* client, const QString& target, const QString& property);
 
+// Reads a property, printing the value if it completes. Rejections are not reported.
+RawCallResult
+tryGetProperty(qs::ipc::RawIpcClient* client, const QString& target, const QString& property);
+
+struct SubscribeCommand {
+	QString target;
+	// property or signal to subscribe to, or empty for all of them
+	QString name;
+
+	void exec(qs::ipc::IpcServerConnection* conn) const;
+};
+
+DEFINE_SIMPLE_DATASTREAM_OPS(SubscribeCommand, data.target, data.name);
+
+int subscribe(qs::ipc::IpcClient* client, const QString& target, const QString& name);
+
+// Runs `call` and `prop get` commands read from stdin, one per line, over a single connection.
+// Commands are sent as they are read, without waiting for responses to earlier commands.
+int runBatch(qs::ipc::IpcClient* client);
+
 } // namespace qs::io::ipc::comm
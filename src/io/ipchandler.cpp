@@ -9,6 +9,7 @@
 #include <qobjectdefs.h>
 #include <qpair.h>
 #include <qqmlinfo.h>
+#include <qset.h>
 #include <qstringbuilder.h>
 #include <qtmetamacros.h>
 #include <qtypes.h>
@@ -133,6 +134,51 @@ WirePropertyDefinition IpcProperty::wireDef() const {
 	return wire;
 }
 
+bool IpcSignal::resolve(QString& error) {
+	for (auto i = 0; i < this->method.parameterCount(); i++) {
+		const auto& metaType = this->method.parameterMetaType(i);
+		const auto* type = IpcType::ipcType(metaType);
+
+		if (type == nullptr || type == &VoidIpcType::INSTANCE) {
+			error = QString("Type of argument %1 (%2: %3) cannot be used across IPC.")
+			            .arg(i + 1)
+			            .arg(this->method.parameterNames().value(i))
+			            .arg(metaType.name());
+
+			return false;
+		}
+
+		this->argumentTypes.append(type);
+	}
+
+	return true;
+}
+
+QString IpcSignal::toString() const {
+	QString paramString;
+	auto paramNames = this->method.parameterNames();
+	for (auto i = 0; i < this->argumentTypes.length(); i++) {
+		paramString += paramNames.value(i) % ": " % this->argumentTypes.value(i)->name();
+
+		if (i + 1 != this->argumentTypes.length()) {
+			paramString += ", ";
+		}
+	}
+
+	return "signal " % this->method.name() % '(' % paramString % ')';
+}
+
+QVector<QString> IpcSignal::argumentStrings(void** args) const {
+	QVector<QString> strings;
+
+	// args[0] holds the (unused) return value
+	for (auto i = 0; i < this->argumentTypes.length(); i++) {
+		strings += this->argumentTypes.value(i)->toString(args[i + 1]); // NOLINT
+	}
+
+	return strings;
+}
+
 IpcCallStorage::IpcCallStorage(const IpcFunction& function): returnSlot(function.returnType) {
 	for (const auto& arg: function.argumentTypes) {
 		this->argumentSlots.emplace_back(arg);
@@ -179,8 +225,11 @@ void IpcHandler::onPostReload() {
 		}
 	}
 
+	auto notifySignals = QSet<int>();
+
 	for (auto i = smeta.propertyCount(); i != meta->propertyCount(); i++) {
 		const auto& property = meta->property(i);
+		if (property.hasNotifySignal()) notifySignals.insert(property.notifySignalIndex());
 		if (!property.isReadable() || !property.hasNotifySignal()) continue;
 
 		auto ipcProp = IpcProperty(property);
@@ -194,6 +243,22 @@ void IpcHandler::onPostReload() {
 		}
 	}
 
+	// Signals declared on the handler, excluding the change signals of its properties.
+	for (auto i = smeta.methodCount(); i != meta->methodCount(); i++) {
+		const auto& method = meta->method(i);
+		if (method.methodType() != QMetaMethod::Signal || notifySignals.contains(i)) continue;
+
+		auto ipcSignal = IpcSignal(method);
+		QString error;
+
+		if (!ipcSignal.resolve(error)) {
+			qmlWarning(this).nospace().noquote()
+			    << "Error parsing signal \"" << method.name() << "\": " << error;
+		} else {
+			this->signalMap.insert(method.name(), ipcSignal);
+		}
+	}
+
 	this->complete = true;
 	this->updateRegistration();
 
@@ -359,6 +424,13 @@ IpcProperty* IpcHandler::findProperty(const QString& name) {
 	else return &*itr;
 }
 
+IpcSignal* IpcHandler::findSignal(const QString& name) {
+	auto itr = this->signalMap.find(name);
+
+	if (itr == this->signalMap.end()) return nullptr;
+	else return &*itr;
+}
+
 IpcHandler* IpcHandlerRegistry::findHandler(const QString& target) {
 	return this->handlers.value(target);
 }
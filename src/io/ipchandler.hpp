@@ -67,6 +67,20 @@ public:
 	const IpcType* type = nullptr;
 };
 
+class IpcSignal {
+public:
+	explicit IpcSignal(QMetaMethod method): method(method) {}
+
+	bool resolve(QString& error);
+
+	[[nodiscard]] QString toString() const;
+	// Converts the arguments of an emission of the signal, as passed to a slot object.
+	[[nodiscard]] QVector<QString> argumentStrings(void** args) const;
+
+	QMetaMethod method;
+	QVector<const IpcType*> argumentTypes;
+};
+
 class IpcHandlerRegistry;
 
 ///! Handler for IPC message calls.
@@ -154,6 +168,44 @@ class IpcHandlerRegistry;
 /// #### Properties
 /// Properties of an IpcHanlder can be read using `qs ipc prop get` as long as they are
 /// of an IPC compatible type. See the table above for compatible types.
+///
+/// #### Subscriptions
+/// Changes to properties and emissions of signals declared on an IpcHandler can be
+/// streamed using `qs ipc subscribe`, which prints one line per change until the handler
+/// is destroyed. Signal parameters must be of an IPC compatible type.
+///
+/// ```qml
+/// IpcHandler {
+///   target: "player"
+///   property real volume: 0.5
+///   signal trackChanged(title: string)
+/// }
+/// ```
+///
+/// ```sh
+/// $ qs ipc subscribe player volume
+/// 0.5
+/// 0.6
+/// $ qs ipc subscribe player
+/// volume	0.5
+/// trackChanged	Some Song
+/// ```
+///
+/// Property subscriptions print the current value when started. If no name is given,
+/// all properties and signals are subscribed to, and each line is prefixed with the name
+/// of the member and a tab. Signal arguments are separated by tabs.
+///
+/// #### Batching
+/// `qs ipc --batch` reads commands from stdin, one per line, and runs them over a single
+/// connection without waiting for each response before sending the next command.
+/// Commands use the same syntax as the command line, with quoting for arguments
+/// containing spaces.
+///
+/// ```sh
+/// $ printf '%s\n' 'call rect setColor orange' 'call rect setAngle 40.5' 'prop get rect color' \
+///   | qs ipc --batch
+/// #ffffa500
+/// ```
 class IpcHandler
     : public QObject
     , public PostReloadHook {
@@ -181,6 +233,9 @@ public:
 	QString listMembers(qsizetype indent);
 	[[nodiscard]] IpcFunction* findFunction(const QString& name);
 	[[nodiscard]] IpcProperty* findProperty(const QString& name);
+	[[nodiscard]] IpcSignal* findSignal(const QString& name);
+	[[nodiscard]] QList<QString> propertyNames() const { return this->propertyMap.keys(); }
+	[[nodiscard]] QList<QString> signalNames() const { return this->signalMap.keys(); }
 	[[nodiscard]] WireTargetDefinition wireDef() const;
 
 signals:
@@ -206,6 +261,7 @@ private:
 
 	QHash<QString, IpcFunction> functionMap;
 	QHash<QString, IpcProperty> propertyMap;
+	QHash<QString, IpcSignal> signalMap;
 
 	friend class IpcHandlerRegistry;
 };
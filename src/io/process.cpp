@@ -1,7 +1,7 @@
 #include "process.hpp"
-#include <csignal> // NOLINT
 #include <utility>
 
+#include <qbytearray.h>
 #include <qdir.h>
 #include <qlist.h>
 #include <qlogging.h>
@@ -14,6 +14,7 @@
 
 #include "../core/generation.hpp"
 #include "../core/qmlglobal.hpp"
+#include "../core/spawn.hpp"
 #include "datastream.hpp"
 
 // When the process ends this have no parent and is just leaked,
@@ -113,8 +114,7 @@ void Process::setStdoutParser(DataStreamParser* parser) {
 		QObject::disconnect(this->mStdoutParser, nullptr, this, nullptr);
 
 		if (this->process != nullptr) {
-			this->process->closeReadChannel(QProcess::StandardOutput);
-			this->process->readAllStandardOutput(); // discard
+			this->process->closeStdout();
 			this->stdoutBuffer.clear();
 		}
 	}
@@ -146,8 +146,7 @@ void Process::setStderrParser(DataStreamParser* parser) {
 		QObject::disconnect(this->mStderrParser, nullptr, this, nullptr);
 
 		if (this->process != nullptr) {
-			this->process->closeReadChannel(QProcess::StandardError);
-			this->process->readAllStandardError(); // discard
+			this->process->closeStderr();
 			this->stderrBuffer.clear();
 		}
 	}
@@ -198,22 +197,21 @@ void Process::startProcessIfReady() {
 	auto& cmd = this->mCommand.first();
 	auto args = this->mCommand.sliced(1);
 
-	this->process = new QProcess(this);
+	this->process = new SpawnedProcess(this);
 
 	// clang-format off
-	QObject::connect(this->process, &QProcess::started, this, &Process::onStarted);
-	QObject::connect(this->process, &QProcess::finished, this, &Process::onFinished);
-	QObject::connect(this->process, &QProcess::errorOccurred, this, &Process::onErrorOccurred);
-	QObject::connect(this->process, &QProcess::readyReadStandardOutput, this, &Process::onStdoutReadyRead);
-	QObject::connect(this->process, &QProcess::readyReadStandardError, this, &Process::onStderrReadyRead);
+	QObject::connect(this->process, &SpawnedProcess::started, this, &Process::onStarted);
+	QObject::connect(this->process, &SpawnedProcess::finished, this, &Process::onFinished);
+	QObject::connect(this->process, &SpawnedProcess::stdoutRead, this, &Process::onStdoutRead);
+	QObject::connect(this->process, &SpawnedProcess::stderrRead, this, &Process::onStderrRead);
 	// clang-format on
 
 	this->stdoutBuffer.clear();
 	this->stderrBuffer.clear();
 
-	if (this->mStdoutParser == nullptr) this->process->closeReadChannel(QProcess::StandardOutput);
-	if (this->mStderrParser == nullptr) this->process->closeReadChannel(QProcess::StandardError);
-	if (!this->mStdinEnabled) this->process->closeWriteChannel();
+	this->process->setStdoutEnabled(this->mStdoutParser != nullptr);
+	this->process->setStderrEnabled(this->mStderrParser != nullptr);
+	this->process->setStdinEnabled(this->mStdinEnabled);
 
 	if (!this->mWorkingDirectory.isEmpty()) {
 		this->process->setWorkingDirectory(this->mWorkingDirectory);
@@ -240,7 +238,16 @@ void Process::startProcessIfReady() {
 		this->process->setProcessEnvironment(env);
 	}
 
-	this->process->start(cmd, args);
+	this->process->setProgram(cmd);
+	this->process->setArguments(args);
+
+	if (!this->process->start()) {
+		qWarning() << "Process failed to start, likely because the binary could not be found. Command:"
+		           << this->mCommand;
+		delete this->process;
+		this->process = nullptr;
+		emit this->runningChanged();
+	}
 }
 
 void Process::onStarted() {
@@ -260,31 +267,21 @@ void Process::onFinished(qint32 exitCode, QProcess::ExitStatus exitStatus) {
 	emit this->processIdChanged();
 }
 
-void Process::onErrorOccurred(QProcess::ProcessError error) {
-	if (error == QProcess::FailedToStart) { // other cases should be covered by other events
-		qWarning() << "Process failed to start, likely because the binary could not be found. Command:"
-		           << this->mCommand;
-		this->process->deleteLater();
-		this->process = nullptr;
-		emit this->runningChanged();
-	}
-}
-
-void Process::onStdoutReadyRead() {
+void Process::onStdoutRead(const QByteArray& data) {
 	if (this->mStdoutParser == nullptr) return;
-	auto buf = this->process->readAllStandardOutput();
+	auto buf = data;
 	this->mStdoutParser->parseBytes(buf, this->stdoutBuffer);
 }
 
-void Process::onStderrReadyRead() {
+void Process::onStderrRead(const QByteArray& data) {
 	if (this->mStderrParser == nullptr) return;
-	auto buf = this->process->readAllStandardError();
+	auto buf = data;
 	this->mStderrParser->parseBytes(buf, this->stderrBuffer);
 }
 
 void Process::signal(qint32 signal) {
 	if (this->process == nullptr) return;
-	kill(static_cast<qint32>(this->process->processId()), signal); // NOLINT
+	this->process->signal(signal);
 }
 
 void Process::write(const QString& data) {
@@ -292,9 +289,9 @@ void Process::write(const QString& data) {
 	this->process->write(data.toUtf8());
 }
 
-void DisownedProcessContext::reparent(QProcess* process) {
+void DisownedProcessContext::reparent(SpawnedProcess* process) {
 	process->setParent(this);
-	QObject::connect(process, &QProcess::finished, this, [process]() { process->deleteLater(); });
+	QObject::connect(process, &SpawnedProcess::finished, process, &QObject::deleteLater);
 }
 
 void DisownedProcessContext::destroyInstance() {
@@ -9,6 +9,7 @@
 #include <qtypes.h>
 #include <qvariant.h>
 
+#include "../core/spawn.hpp"
 #include "datastream.hpp"
 
 // Needed when compiling with clang musl-libc++.
@@ -194,9 +195,8 @@ signals:
 private slots:
 	void onStarted();
 	void onFinished(qint32 exitCode, QProcess::ExitStatus exitStatus);
-	void onErrorOccurred(QProcess::ProcessError error);
-	void onStdoutReadyRead();
-	void onStderrReadyRead();
+	void onStdoutRead(const QByteArray& data);
+	void onStderrRead(const QByteArray& data);
 	void onStdoutParserDestroyed();
 	void onStderrParserDestroyed();
 	void onGlobalWorkingDirectoryChanged();
@@ -204,7 +204,7 @@ private slots:
 private:
 	void startProcessIfReady();
 
-	QProcess* process = nullptr;
+	SpawnedProcess* process = nullptr;
 	QList<QString> mCommand;
 	QString mWorkingDirectory;
 	QMap<QString, QVariant> mEnvironment;
@@ -222,7 +222,7 @@ private:
 class DisownedProcessContext: public QObject {
 	Q_OBJECT;
 
-	void reparent(QProcess* process);
+	void reparent(SpawnedProcess* process);
 	friend class Process;
 
 public:
@@ -103,4 +103,50 @@ void TestSplitParser::initBuffer() { // NOLINT
 	QCOMPARE(buf, "baz");
 }
 
+void TestSplitParser::batched() { // NOLINT
+	auto parser = SplitParser();
+	auto spy = QSignalSpy(&parser, &DataStreamParser::read);
+	auto batchSpy = QSignalSpy(&parser, &SplitParser::readBatch);
+
+	parser.setBatched(true);
+
+	auto buffer = QByteArray("fo");
+	auto incoming = QByteArray("o\nbar\nbaz");
+	parser.parseBytes(incoming, buffer);
+
+	QCOMPARE(spy.count(), 0);
+	QCOMPARE(batchSpy.count(), 1);
+	QCOMPARE(batchSpy.at(0).at(0).value<QList<QString>>(), QList<QString>({"foo", "bar"}));
+	QCOMPARE(buffer, "baz");
+}
+
+void TestSplitParser::throttled() { // NOLINT
+	auto parser = SplitParser();
+	auto spy = QSignalSpy(&parser, &DataStreamParser::read);
+
+	parser.setThrottleInterval(50);
+
+	auto buffer = QByteArray();
+	auto incoming = QByteArray("foo\n");
+	parser.parseBytes(incoming, buffer);
+
+	// the first chunk is delivered immediately
+	QCOMPARE(spy.count(), 1);
+
+	incoming = "bar\n";
+	parser.parseBytes(incoming, buffer);
+	incoming = "baz\n";
+	parser.parseBytes(incoming, buffer);
+
+	QCOMPARE(spy.count(), 1);
+	QTRY_COMPARE(spy.count(), 3);
+
+	auto actualResults = QList<QString>();
+	for (auto& read: spy) {
+		actualResults.push_back(read[0].toString());
+	}
+
+	QCOMPARE(actualResults, QList<QString>({"foo", "bar", "baz"}));
+}
+
 QTEST_MAIN(TestSplitParser);
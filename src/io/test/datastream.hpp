@@ -10,4 +10,6 @@ private slots:
 	void splits_data(); // NOLINT
 	void splits();
 	void initBuffer();
+	void batched();
+	void throttled();
 };
@@ -0,0 +1,43 @@
+#include "jsonlinesparser.hpp"
+
+#include <qbytearray.h>
+#include <qobject.h>
+#include <qsignalspy.h>
+#include <qtest.h>
+#include <qtestcase.h>
+#include <qvariant.h>
+
+#include "../datastream.hpp"
+
+void TestJsonLinesParser::parsesValues() { // NOLINT
+	auto parser = JsonLinesParser();
+	auto spy = QSignalSpy(&parser, &JsonLinesParser::readValue);
+
+	auto buffer = QByteArray("{\"a\": ");
+	auto incoming = QByteArray("1}\n[1, 2]\n\n\"str\"\n42\n{\"b\"");
+	parser.parseBytes(incoming, buffer);
+
+	QCOMPARE(buffer, "{\"b\"");
+	QTRY_COMPARE(spy.count(), 4);
+
+	QCOMPARE(spy.at(0).at(0).toMap().value("a").toInt(), 1);
+	QCOMPARE(spy.at(1).at(0).toList().size(), 2);
+	QCOMPARE(spy.at(2).at(0).toString(), "str");
+	QCOMPARE(spy.at(3).at(0).toInt(), 42);
+}
+
+void TestJsonLinesParser::reportsErrors() { // NOLINT
+	auto parser = JsonLinesParser();
+	auto spy = QSignalSpy(&parser, &JsonLinesParser::readValue);
+	auto errorSpy = QSignalSpy(&parser, &JsonLinesParser::parseError);
+
+	auto buffer = QByteArray();
+	auto incoming = QByteArray("{broken\n{}\n");
+	parser.parseBytes(incoming, buffer);
+
+	QTRY_COMPARE(spy.count(), 1);
+	QCOMPARE(errorSpy.count(), 1);
+	QCOMPARE(errorSpy.at(0).at(0).toString(), "{broken");
+}
+
+QTEST_MAIN(TestJsonLinesParser);
@@ -0,0 +1,12 @@
+#pragma once
+
+#include <qobject.h>
+#include <qtmetamacros.h>
+
+class TestJsonLinesParser: public QObject {
+	Q_OBJECT;
+
+private slots:
+	void parsesValues();
+	void reportsErrors();
+};
@@ -0,0 +1,86 @@
+#include "lengthprefixedparser.hpp"
+
+#include <qbytearray.h>
+#include <qendian.h>
+#include <qlist.h>
+#include <qobject.h>
+#include <qsignalspy.h>
+#include <qtest.h>
+#include <qtestcase.h>
+#include <qtypes.h>
+
+#include "../datastream.hpp"
+
+namespace {
+
+QByteArray frame(const QByteArray& data) {
+	auto length = qToBigEndian(static_cast<quint32>(data.size()));
+	auto result = QByteArray(reinterpret_cast<const char*>(&length), sizeof(length)); // NOLINT
+	result.append(data);
+	return result;
+}
+
+} // namespace
+
+void TestLengthPrefixedParser::frames() { // NOLINT
+	auto stream = frame("foo") + frame("") + frame("barbaz") + frame("qux");
+
+	// split the stream at every offset to cover frames crossing read boundaries
+	for (auto i = 0; i <= stream.size() - 2; i++) {
+		auto parser = LengthPrefixedParser();
+		auto spy = QSignalSpy(&parser, &DataStreamParser::read);
+
+		auto buffer = QByteArray();
+		auto first = stream.sliced(0, i);
+		auto second = stream.sliced(i, stream.size() - i - 2);
+		parser.parseBytes(first, buffer);
+		parser.parseBytes(second, buffer);
+
+		auto actualResults = QList<QString>();
+		for (auto& read: spy) {
+			actualResults.push_back(read[0].toString());
+		}
+
+		QCOMPARE(actualResults, QList<QString>({"foo", "", "barbaz"}));
+		QCOMPARE(buffer, stream.sliced(stream.size() - 7, 5));
+	}
+}
+
+void TestLengthPrefixedParser::binaryFrames() { // NOLINT
+	auto parser = LengthPrefixedParser();
+	auto spy = QSignalSpy(&parser, &LengthPrefixedParser::readBytes);
+	auto stringSpy = QSignalSpy(&parser, &DataStreamParser::read);
+
+	parser.setBinary(true);
+	parser.setPrefixSize(2);
+	parser.setLittleEndian(true);
+
+	auto buffer = QByteArray();
+	auto incoming = QByteArray("\x03\x00\x01\x02\x03", 5);
+	parser.parseBytes(incoming, buffer);
+
+	QCOMPARE(stringSpy.count(), 0);
+	QCOMPARE(spy.count(), 1);
+	QCOMPARE(spy.at(0).at(0).toByteArray(), QByteArray("\x01\x02\x03", 3));
+	QCOMPARE(buffer, "");
+}
+
+void TestLengthPrefixedParser::oversizedFrame() { // NOLINT
+	auto parser = LengthPrefixedParser();
+	auto spy = QSignalSpy(&parser, &DataStreamParser::read);
+
+	parser.setMaxFrameSize(4);
+
+	// negative sizes would wrap around when compared against frame lengths
+	parser.setMaxFrameSize(-1);
+	QCOMPARE(parser.maxFrameSize(), 4);
+
+	auto buffer = QByteArray();
+	auto incoming = frame("foo") + frame("toolong") + frame("bar");
+	parser.parseBytes(incoming, buffer);
+
+	QCOMPARE(spy.count(), 1);
+	QCOMPARE(buffer, "");
+}
+
+QTEST_MAIN(TestLengthPrefixedParser);
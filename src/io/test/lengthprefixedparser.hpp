@@ -0,0 +1,13 @@
+#pragma once
+
+#include <qobject.h>
+#include <qtmetamacros.h>
+
+class TestLengthPrefixedParser: public QObject {
+	Q_OBJECT;
+
+private slots:
+	void frames();
+	void binaryFrames();
+	void oversizedFrame();
+};
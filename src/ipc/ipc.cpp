@@ -1,4 +1,7 @@
 #include "ipc.hpp"
+#include <array>
+#include <cerrno>
+#include <cstring>
 #include <functional>
 #include <variant>
 
@@ -8,6 +11,9 @@
 #include <qlogging.h>
 #include <qloggingcategory.h>
 #include <qobject.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
 
 #include "../core/generation.hpp"
 #include "../core/paths.hpp"
@@ -59,29 +65,29 @@ IpcServerConnection::IpcServerConnection(QLocalSocket* socket, IpcServer* server
 
 void IpcServerConnection::onDisconnected() {
 	qCInfo(logIpc) << "IPC connection disconnected" << this;
+	this->deleteLater();
 }
 
 void IpcServerConnection::onReadyRead() {
-	this->stream.startTransaction();
-
-	this->stream.startTransaction();
-	IpcCommand command;
-	this->stream >> command;
-	if (!this->stream.commitTransaction()) return;
-
-	std::visit(
-	    [this]<typename Command>(Command& command) {
-		    if constexpr (std::is_same_v<std::monostate, Command>) {
-			    qCCritical(logIpc) << "Received invalid IPC command from" << this;
-			    this->socket->disconnectFromServer();
-		    } else {
-			    command.exec(this);
-		    }
-	    },
-	    command
-	);
-
-	if (!this->stream.commitTransaction()) return;
+	// Clients may pipeline several commands, which can arrive in a single read.
+	while (this->socket->state() == QLocalSocket::ConnectedState) {
+		this->stream.startTransaction();
+		IpcCommand command;
+		this->stream >> command;
+		if (!this->stream.commitTransaction()) return;
+
+		std::visit(
+		    [this]<typename Command>(Command& command) {
+			    if constexpr (std::is_same_v<std::monostate, Command>) {
+				    qCCritical(logIpc) << "Received invalid IPC command from" << this;
+				    this->socket->disconnectFromServer();
+			    } else {
+				    command.exec(this);
+			    }
+		    },
+		    command
+		);
+	}
 }
 
 IpcClient::IpcClient(const QString& path) {
@@ -117,6 +123,66 @@ int IpcClient::connect(const QString& id, const std::function<void(IpcClient& cl
 	return 0;
 }
 
+RawIpcClient::RawIpcClient(const QString& path) {
+	auto address = sockaddr_un {.sun_family = AF_UNIX, .sun_path = {}};
+	auto encodedPath = path.toLocal8Bit();
+
+	if (encodedPath.size() >= static_cast<qsizetype>(sizeof(address.sun_path))) return;
+	memcpy(address.sun_path, encodedPath.constData(), encodedPath.size()); // NOLINT
+
+	this->fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+	if (this->fd == -1) return;
+
+	// NOLINTNEXTLINE
+	if (::connect(this->fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == -1) {
+		close(this->fd);
+		this->fd = -1;
+	}
+}
+
+RawIpcClient::~RawIpcClient() {
+	if (this->fd != -1) close(this->fd);
+}
+
+bool RawIpcClient::writeAll(const QByteArray& data) {
+	if (this->fd == -1) return false;
+
+	qsizetype written = 0;
+	while (written != data.size()) {
+		// MSG_NOSIGNAL avoids SIGPIPE if the server went away
+		auto r = send(this->fd, data.constData() + written, data.size() - written, MSG_NOSIGNAL);
+
+		if (r == -1) {
+			if (errno == EINTR) continue;
+			return false;
+		}
+
+		written += r;
+	}
+
+	return true;
+}
+
+bool RawIpcClient::readMore() {
+	if (this->fd == -1) return false;
+
+	auto chunk = std::array<char, 4096>();
+
+	while (true) {
+		auto r = read(this->fd, chunk.data(), chunk.size());
+
+		if (r == -1) {
+			if (errno == EINTR) continue;
+			return false;
+		} else if (r == 0) {
+			return false;
+		}
+
+		this->buffer.append(chunk.data(), r);
+		return true;
+	}
+}
+
 void IpcKillCommand::exec(IpcServerConnection* /*unused*/) {
 	qInfo() << "Exiting due to IPC request.";
 	EngineGeneration::currentGeneration()->quit();
@@ -6,12 +6,16 @@
 #include <utility>
 #include <variant>
 
+#include <qbytearray.h>
+#include <qdatastream.h>
 #include <qflags.h>
+#include <qiodevice.h>
 #include <qlocalserver.h>
 #include <qlocalsocket.h>
 #include <qlogging.h>
 #include <qloggingcategory.h>
 #include <qobject.h>
+#include <qtclasshelpermacros.h>
 #include <qtmetamacros.h>
 #include <qtypes.h>
 
@@ -191,11 +195,12 @@ public:
 
 	template <typename T>
 	bool waitForResponse(T& slot) {
-		while (this->socket.waitForReadyRead(-1)) {
+		// responses may already be buffered when several were received at once
+		while (this->socket.bytesAvailable() != 0 || this->socket.waitForReadyRead(-1)) {
 			this->stream.startTransaction();
 			this->stream >> slot;
-			if (!this->stream.commitTransaction()) continue;
-			return true;
+			if (this->stream.commitTransaction()) return true;
+			if (!this->socket.waitForReadyRead(-1)) break;
 		}
 
 		qCCritical(logIpc) << "Error occurred while waiting for response.";
@@ -217,4 +222,56 @@ private slots:
 	static void onError(QLocalSocket::LocalSocketError error);
 };
 
+// Blocking IPC client over a raw unix socket.
+//
+// Unlike IpcClient this does not depend on QLocalSocket or an event dispatcher, and can be
+// used before a QCoreApplication exists. Used by the command line for one-shot calls, where
+// process startup dominates the cost of the call.
+class RawIpcClient {
+public:
+	explicit RawIpcClient(const QString& path);
+	~RawIpcClient();
+	Q_DISABLE_COPY_MOVE(RawIpcClient);
+
+	[[nodiscard]] bool isConnected() const { return this->fd != -1; }
+
+	template <typename T>
+	bool sendMessage(const T& message) {
+		auto data = QByteArray();
+
+		{
+			auto stream = QDataStream(&data, QIODevice::WriteOnly);
+			stream << message;
+		}
+
+		return this->writeAll(data);
+	}
+
+	template <typename T>
+	bool waitForResponse(T& slot) {
+		while (true) {
+			if (!this->buffer.isEmpty()) {
+				auto stream = QDataStream(this->buffer);
+				stream >> slot;
+
+				if (stream.status() == QDataStream::Ok) {
+					this->buffer.remove(0, stream.device()->pos());
+					return true;
+				}
+			}
+
+			if (!this->readMore()) return false;
+		}
+	}
+
+private:
+	bool writeAll(const QByteArray& data);
+	// Reads available data into the buffer, blocking until some arrives.
+	// Returns false on error or if the server closed the connection.
+	bool readMore();
+
+	int fd = -1;
+	QByteArray buffer;
+};
+
 } // namespace qs::ipc
@@ -3,6 +3,8 @@
 #include <cerrno>
 #include <cstdio>
 #include <cstring>
+#include <string>
+#include <string_view>
 
 #include <qconfig.h>
 #include <qcontainerfwd.h>
@@ -19,6 +21,7 @@
 #include <qloggingcategory.h>
 #include <qnamespace.h>
 #include <qstandardpaths.h>
+#include <qtenvironmentvariables.h>
 #include <qtversion.h>
 #include <unistd.h>
 
@@ -33,6 +36,7 @@
 namespace qs::launch {
 
 using qs::ipc::IpcClient;
+using qs::ipc::RawIpcClient;
 
 namespace {
 
@@ -102,6 +106,64 @@ int locateConfigFile(CommandState& cmd, QString& path) {
 	return 0;
 }
 
+void discardMessage(
+    QtMsgType /*type*/,
+    const QMessageLogContext& /*context*/,
+    const QString& /*message*/
+) {}
+
+// Parses an instance or config selection option at argv[i], advancing i past its value.
+// Returns false if the argument is not a selection option this parser understands.
+bool parseFastSelectionOption(
+    int argc,
+    char** argv,
+    int& i,
+    CommandState& state,
+    bool& selectsInstance
+) {
+	auto arg = std::string_view(argv[i]); // NOLINT
+	auto name = arg;
+	auto value = std::string_view();
+	auto hasValue = false;
+
+	if (arg == "-n" || arg == "--newest") {
+		state.config.newest = true;
+		return true;
+	}
+
+	if (arg.starts_with("--")) {
+		if (auto eq = arg.find('='); eq != std::string_view::npos) {
+			name = arg.substr(0, eq);
+			value = arg.substr(eq + 1);
+			hasValue = true;
+		}
+	}
+
+	QStringOption* option = nullptr;
+	if (name == "-i" || name == "--id") option = &state.instance.id;
+	else if (name == "-p" || name == "--path") option = &state.config.path;
+	else if (name == "-m" || name == "--manifest") option = &state.config.manifest;
+	else if (name == "-c" || name == "--config") option = &state.config.name;
+	else if (name != "--pid") return false;
+
+	if (!hasValue) {
+		if (i + 1 == argc) return false;
+		value = argv[++i]; // NOLINT
+	}
+
+	if (option) {
+		*option = std::string(value);
+		if (option == &state.instance.id) selectsInstance = true;
+		return true;
+	}
+
+	auto ok = false;
+	auto pid = QString::fromUtf8(value.data(), static_cast<qsizetype>(value.size()));
+	state.instance.pid = pid.toInt(&ok);
+	selectsInstance = true;
+	return ok;
+}
+
 void sortInstances(QVector<InstanceLockInfo>& list, bool newestFirst) {
 	std::ranges::sort(list, [=](const InstanceLockInfo& a, const InstanceLockInfo& b) {
 		auto r = a.instance.launchTime < b.instance.launchTime;
@@ -109,6 +171,8 @@ void sortInstances(QVector<InstanceLockInfo>& list, bool newestFirst) {
 	});
 };
 
+} // namespace
+
 int selectInstance(CommandState& cmd, InstanceLockInfo* instance) {
 	auto* basePath = QsPaths::instance()->baseRunDir();
 	if (!basePath) return -1;
@@ -167,6 +231,8 @@ int selectInstance(CommandState& cmd, InstanceLockInfo* instance) {
 	return 0;
 }
 
+namespace {
+
 int readLogFile(CommandState& cmd) {
 	auto path = *cmd.log.file;
 
@@ -291,10 +357,14 @@ int ipcCommand(CommandState& cmd) {
 	if (r != 0) return r;
 
 	return IpcClient::connect(instance.instance.instanceId, [&](IpcClient& client) {
-		if (*cmd.ipc.show || cmd.ipc.showOld) {
+		if (cmd.ipc.batch) {
+			return qs::io::ipc::comm::runBatch(&client);
+		} else if (*cmd.ipc.show || cmd.ipc.showOld) {
 			return qs::io::ipc::comm::queryMetadata(&client, *cmd.ipc.target, *cmd.ipc.name);
 		} else if (*cmd.ipc.getprop) {
 			return qs::io::ipc::comm::getProperty(&client, *cmd.ipc.target, *cmd.ipc.name);
+		} else if (*cmd.ipc.subscribe) {
+			return qs::io::ipc::comm::subscribe(&client, *cmd.ipc.target, *cmd.ipc.name);
 		} else {
 			QVector<QString> arguments;
 			for (auto& arg: cmd.ipc.arguments) {
@@ -335,6 +405,91 @@ int launchFromCommand(CommandState& cmd, QCoreApplication* coreApplication) {
 
 } // namespace
 
+int fastIpcCommand(int argc, char** argv) {
+	if (argc < 2 || qEnvironmentVariableIsSet("QS_DISABLE_FAST_IPC")) return 65535;
+
+	auto command = std::string_view(argv[1]); // NOLINT
+	auto isMsg = command == "msg";
+	auto isGetProp = false;
+	if (!isMsg && command != "ipc") return 65535;
+
+	auto state = CommandState();
+	auto selectsInstance = false;
+
+	// mirror the environment fallbacks of the config selection options
+	*state.config.path = qEnvironmentVariable("QS_CONFIG_PATH");
+	*state.config.manifest = qEnvironmentVariable("QS_MANIFEST");
+	*state.config.name = qEnvironmentVariable("QS_CONFIG_NAME");
+
+	auto i = 2;
+
+	if (!isMsg) {
+		for (; i < argc && argv[i][0] == '-'; i++) { // NOLINT
+			if (!parseFastSelectionOption(argc, argv, i, state, selectsInstance)) return 65535;
+		}
+
+		if (i >= argc) return 65535;
+		auto subcommand = std::string_view(argv[i++]); // NOLINT
+
+		if (subcommand == "prop" && i < argc && std::string_view(argv[i]) == "get") { // NOLINT
+			isGetProp = true;
+			i++;
+		} else if (subcommand != "call") {
+			return 65535;
+		}
+	}
+
+	auto positionals = QVector<QString>();
+
+	for (; i < argc; i++) {
+		if (argv[i][0] == '-') { // NOLINT
+			// msg accepts options between its positionals
+			if (isMsg && parseFastSelectionOption(argc, argv, i, state, selectsInstance)) continue;
+			return 65535;
+		}
+
+		positionals.push_back(QString::fromUtf8(argv[i])); // NOLINT
+	}
+
+	if (positionals.length() < 2 || (isGetProp && positionals.length() != 2)) return 65535;
+
+	if (selectsInstance
+	    && (!state.config.path->isEmpty() || !state.config.manifest->isEmpty()
+	        || !state.config.name->isEmpty() || state.config.newest))
+	{
+		return 65535;
+	}
+
+	// Selection errors are reported when the command is rerun through runCommand.
+	InstanceLockInfo instance;
+	qInstallMessageHandler(&discardMessage);
+	auto r = selectInstance(state, &instance);
+	qInstallMessageHandler(nullptr);
+	if (r != 0) return 65535;
+
+	auto client = RawIpcClient(QsPaths::ipcPath(instance.instance.instanceId));
+	if (!client.isConnected()) return 65535;
+
+	auto result = qs::io::ipc::comm::RawCallResult::Rejected;
+
+	if (isGetProp) {
+		result = qs::io::ipc::comm::tryGetProperty(&client, positionals[0], positionals[1]);
+	} else {
+		result = qs::io::ipc::comm::tryCallFunction(
+		    &client,
+		    positionals[0],
+		    positionals[1],
+		    positionals.mid(2)
+		);
+	}
+
+	switch (result) {
+	case qs::io::ipc::comm::RawCallResult::Completed: return 0;
+	case qs::io::ipc::comm::RawCallResult::ConnectionLost: return -1;
+	default: return 65535;
+	}
+}
+
 int runCommand(int argc, char** argv, QCoreApplication* coreApplication) {
 	auto state = CommandState();
 	if (auto ret = parseCommand(argc, argv, state); ret != 65535) return ret;
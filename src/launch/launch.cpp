@@ -21,6 +21,7 @@
 #include "../core/logging.hpp"
 #include "../core/paths.hpp"
 #include "../core/plugin.hpp"
+#include "../core/relaunchstate.hpp"
 #include "../core/rootwrapper.hpp"
 #include "../ipc/ipc.hpp"
 #include "build.hpp"
@@ -229,6 +230,11 @@ int launch(const LaunchArgs& args, char** argv, QCoreApplication* coreApplicatio
 	qs::ipc::IpcServer::start();
 	QsPaths::instance()->createLock();
 
+#if CRASH_REPORTER
+	// needs the final application object for its timer
+	RelaunchState::instance()->enable();
+#endif
+
 	auto root = RootWrapper(args.configPath, shellId);
 	QGuiApplication::setQuitOnLastWindowClosed(false);
 
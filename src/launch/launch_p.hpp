@@ -7,6 +7,8 @@
 #include <qcoreapplication.h>
 #include <qstring.h>
 
+#include "../core/paths.hpp"
+
 namespace qs::launch {
 
 extern int DAEMON_PIPE; // NOLINT
@@ -72,7 +74,9 @@ struct CommandState {
 		CLI::App* show = nullptr;
 		CLI::App* call = nullptr;
 		CLI::App* getprop = nullptr;
+		CLI::App* subscribe = nullptr;
 		bool showOld = false;
+		bool batch = false;
 		QStringOption target;
 		QStringOption name;
 		std::vector<QStringOption> arguments;
@@ -104,6 +108,12 @@ void exitDaemon(int code);
 
 int parseCommand(int argc, char** argv, CommandState& state);
 int runCommand(int argc, char** argv, QCoreApplication* coreApplication);
+int selectInstance(CommandState& cmd, InstanceLockInfo* instance);
+
+// Runs `ipc call`, `ipc prop get` and `msg` invocations without a QCoreApplication, CLI
+// parser or logger, over a RawIpcClient. Returns 65535 if the command was not handled, in
+// which case it must be run through runCommand, which also reports any errors.
+int fastIpcCommand(int argc, char** argv);
 
 int launch(const LaunchArgs& args, char** argv, QCoreApplication* coreApplication);
 
@@ -13,6 +13,7 @@
 #include "../core/instanceinfo.hpp"
 #include "../core/logging.hpp"
 #include "../core/paths.hpp"
+#include "../core/relaunchstate.hpp"
 #include "build.hpp"
 #include "launch_p.hpp"
 
@@ -61,6 +62,9 @@ void checkCrashRelaunch(char** argv, QCoreApplication* coreApplication) {
 		} else {
 			qCritical() << "Quickshell has been restarted.";
 
+			auto stateFd = qEnvironmentVariable("__QUICKSHELL_CRASH_STATE_FD").toInt();
+			if (stateFd > 0) RelaunchState::loadSnapshot(stateFd);
+
 			launch({.configPath = info.instance.configPath}, argv, coreApplication);
 		}
 	}
@@ -105,6 +109,9 @@ int main(int argc, char** argv) {
 	qsCheckCrash(argc, argv);
 #endif
 
+	// One-shot ipc calls are frequently bound to keys, skip everything they don't need.
+	if (auto code = fastIpcCommand(argc, argv); code != 65535) return code;
+
 	auto qArgC = 1;
 	auto* coreApplication = new QCoreApplication(qArgC, argv);
 
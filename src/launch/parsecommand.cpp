@@ -169,13 +169,28 @@ int parseCommand(int argc, char** argv, CommandState& state) {
 
 	{
 		auto* sub = cli->add_subcommand("ipc", "Communicate with other Quickshell instances.")
-		                ->require_subcommand();
+		                ->require_subcommand(0, 1);
 		state.ipc.ipc = sub;
 
 		auto* instance = addInstanceSelection(sub);
 		addConfigSelection(sub, true)->excludes(instance);
 		addLoggingOptions(sub, false, true);
 
+		sub->add_flag("--batch", state.ipc.batch)
+		    ->description("Run `call` and `prop get` commands read from stdin, one per line,\n"
+		                  "over a single connection.");
+
+		sub->callback([sub, &state]() {
+			if (!state.ipc.batch && sub->get_subcommands().empty()) {
+				throw CLI::RequiredError("A subcommand or --batch");
+			}
+
+			// commands are read from stdin in batch mode, so a subcommand would be ignored
+			if (state.ipc.batch && !sub->get_subcommands().empty()) {
+				throw CLI::ValidationError("--batch", "cannot be combined with a subcommand");
+			}
+		});
+
 		{
 			auto* show = sub->add_subcommand("show", "Print information about available IPC targets.");
 			state.ipc.show = show;
@@ -206,6 +221,22 @@ int parseCommand(int argc, char** argv, CommandState& state) {
 				get->add_option("property", state.ipc.name)->description("The property to read.");
 			}
 		}
+
+		{
+			auto* subscribe = sub->add_subcommand(
+			    "subscribe",
+			    "Print changes to IpcHandler properties and emissions of its signals."
+			);
+
+			state.ipc.subscribe = subscribe;
+
+			subscribe->add_option("target", state.ipc.target, "The target to subscribe to.");
+
+			subscribe->add_option("name", state.ipc.name)
+			    ->description("The property or signal to subscribe to.\n"
+			                  "If unspecified, all properties and signals are subscribed to\n"
+			                  "and each line is prefixed by the name of the member.");
+		}
 	}
 
 	{
@@ -0,0 +1,176 @@
+#include "art.hpp"
+#include <limits>
+
+#include <qbytearray.h>
+#include <qdatetime.h>
+#include <qelapsedtimer.h>
+#include <qfileinfo.h>
+#include <qimage.h>
+#include <qimagereader.h>
+#include <qloggingcategory.h>
+#include <qminmax.h>
+#include <qmutex.h>
+#include <qnamespace.h>
+#include <qqmlengine.h>
+#include <qsize.h>
+#include <qstring.h>
+#include <qurl.h>
+
+namespace qs::service::mpris {
+
+namespace {
+Q_LOGGING_CATEGORY(logMprisArt, "quickshell.service.mp.art", QtWarningMsg);
+
+// full size decodes are only kept for the most recent tracks
+constexpr qsizetype MAX_SOURCES = 2;
+// in KiB
+constexpr qsizetype MAX_VARIANT_COST = 16 * 1024;
+constexpr qsizetype MAX_STATS = 8;
+constexpr qsizetype MAX_FAILURES = 16;
+
+// metadata changes arrive in bursts, which share one check of the art file
+constexpr qint64 STAT_REUSE_MS = 2000;
+// failed art is not decoded again for this long unless the file changes
+constexpr qint64 FAILURE_RETRY_MS = 5000;
+
+constexpr auto ID_ENCODING = QByteArray::Base64UrlEncoding | QByteArray::OmitTrailingEquals;
+
+QSize scaledArtSize(const QSize& size, const QSize& requestedSize) {
+	if (requestedSize.width() <= 0 && requestedSize.height() <= 0) return size;
+
+	auto bounds = QSize(
+	    requestedSize.width() > 0 ? requestedSize.width() : std::numeric_limits<int>::max(),
+	    requestedSize.height() > 0 ? requestedSize.height() : std::numeric_limits<int>::max()
+	);
+
+	auto scaled = size.scaled(bounds, Qt::KeepAspectRatio);
+	if (scaled.width() >= size.width() || scaled.height() >= size.height()) return size;
+	return scaled;
+}
+
+} // namespace
+
+MprisArtProvider::MprisArtProvider(): QsImageHandle(QQmlImageProviderBase::Image, true) {
+	this->sources.setMaxCost(MAX_SOURCES);
+	this->variants.setMaxCost(MAX_VARIANT_COST);
+	this->stats.setMaxCost(MAX_STATS);
+	this->failures.setMaxCost(MAX_FAILURES);
+}
+
+MprisArtProvider* MprisArtProvider::instance() {
+	static auto* instance = new MprisArtProvider(); // NOLINT
+	return instance;
+}
+
+QString MprisArtProvider::imageUrl(const QString& artUrl, quint32 trackRevision) {
+	if (artUrl.isEmpty()) return artUrl;
+
+	// Remote art is left to QtQuick's network loader.
+	auto url = QUrl(artUrl);
+	if (!url.isLocalFile()) return artUrl;
+
+	// Players commonly reuse the same path for different art. The modification time is part
+	// of the url so QtQuick's pixmap cache does not serve the previous art.
+	auto path = url.toLocalFile();
+	auto* stat = this->stats.object(path);
+
+	if (stat == nullptr || stat->trackRevision != trackRevision
+	    || stat->checked.hasExpired(STAT_REUSE_MS))
+	{
+		stat = new ArtStat();
+		stat->modified = QFileInfo(path).lastModified().toMSecsSinceEpoch();
+		stat->trackRevision = trackRevision;
+		stat->checked.start();
+		this->stats.insert(path, stat);
+	}
+
+	return this->url() % '/' % QString::fromLatin1(artUrl.toUtf8().toBase64(ID_ENCODING)) % '/'
+	     % QString::number(stat->modified);
+}
+
+QsImageHandle::AsyncImageRequest MprisArtProvider::asyncImageRequest() const {
+	// the provider is never destroyed, so it can be used directly
+	return [](const QString& id, QSize* size, const QSize& requestedSize) {
+		return MprisArtProvider::instance()->requestImage(id, size, requestedSize);
+	};
+}
+
+QImage MprisArtProvider::loadSource(const QString& path) {
+	auto reader = QImageReader(path);
+	reader.setAutoTransform(true);
+
+	auto image = reader.read();
+
+	if (image.isNull()) {
+		qCWarning(logMprisArt) << "Failed to load track art" << path << reader.errorString();
+		return image;
+	}
+
+	qCDebug(logMprisArt) << "Decoded track art" << path << "at" << image.size();
+	return image;
+}
+
+QImage
+MprisArtProvider::requestImage(const QString& id, QSize* size, const QSize& requestedSize) {
+	auto separator = id.indexOf('/');
+	auto encodedUrl = separator == -1 ? id : id.first(separator);
+	auto modified = separator == -1 ? QString() : id.sliced(separator + 1);
+
+	auto artUrl =
+	    QUrl(QString::fromUtf8(QByteArray::fromBase64(encodedUrl.toLatin1(), ID_ENCODING)));
+	auto path = artUrl.toLocalFile();
+	const QString key = path % '@' % modified;
+
+	auto scaled = requestedSize.width() > 0 || requestedSize.height() > 0;
+	const QString variantKey = key % '@' % QString::number(requestedSize.width()) % 'x'
+	                         % QString::number(requestedSize.height());
+
+	auto image = QImage();
+	auto recentlyFailed = false;
+
+	// The lock only covers cache access. Decoding and scaling happen outside of it so
+	// requests for cached art are not held up by a slow decode.
+	{
+		auto locker = QMutexLocker(&this->mutex);
+
+		if (auto* variant = scaled ? this->variants.object(variantKey) : nullptr) {
+			image = *variant;
+		} else if (auto* source = this->sources.object(key)) {
+			image = *source;
+		} else if (auto* failedAt = this->failures.object(key)) {
+			recentlyFailed = !failedAt->hasExpired(FAILURE_RETRY_MS);
+		}
+	}
+
+	if (image.isNull() && !recentlyFailed) {
+		image = MprisArtProvider::loadSource(path);
+		auto locker = QMutexLocker(&this->mutex);
+
+		if (image.isNull()) {
+			auto* failedAt = new QElapsedTimer();
+			failedAt->start();
+			this->failures.insert(key, failedAt);
+		} else {
+			this->failures.remove(key);
+			this->sources.insert(key, new QImage(image), 1);
+		}
+	}
+
+	// cached variants already fit the requested size and are returned as is
+	if (scaled && !image.isNull()) {
+		auto scaledSize = scaledArtSize(image.size(), requestedSize);
+
+		if (scaledSize != image.size()) {
+			image = image.scaled(scaledSize, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+
+			auto cost = qMax(static_cast<qsizetype>(1), image.sizeInBytes() / 1024);
+			auto locker = QMutexLocker(&this->mutex);
+			this->variants.insert(variantKey, new QImage(image), cost);
+		}
+	}
+
+	if (size != nullptr) *size = image.size();
+	return image;
+}
+
+} // namespace qs::service::mpris
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <qcache.h>
+#include <qelapsedtimer.h>
+#include <qimage.h>
+#include <qmutex.h>
+#include <qsize.h>
+#include <qstring.h>
+#include <qtypes.h>
+
+#include "../../core/imageprovider.hpp"
+
+namespace qs::service::mpris {
+
+// Resolves track art for all players. Local art is decoded once on the image provider's
+// worker thread and downscaled variants for each requested size are kept in an LRU cache,
+// so every widget showing the same art shares the same pixels.
+class MprisArtProvider: public QsImageHandle {
+public:
+	static MprisArtProvider* instance();
+
+	// Returns an image url for the given art url, or the art url itself if it
+	// cannot be served by the provider. The art file is only checked for changes again
+	// once the track revision changes or the last check is a few seconds old.
+	// Must be called from the gui thread.
+	[[nodiscard]] QString imageUrl(const QString& artUrl, quint32 trackRevision);
+
+	QImage requestImage(const QString& id, QSize* size, const QSize& requestedSize) override;
+	[[nodiscard]] AsyncImageRequest asyncImageRequest() const override;
+
+private:
+	explicit MprisArtProvider();
+
+	struct ArtStat {
+		qint64 modified = 0;
+		quint32 trackRevision = 0;
+		QElapsedTimer checked;
+	};
+
+	static QImage loadSource(const QString& path);
+
+	// only accessed from the gui thread
+	QCache<QString, ArtStat> stats;
+
+	QMutex mutex;
+	QCache<QString, QImage> sources;
+	QCache<QString, QImage> variants;
+	// art that failed to load, by the time of the failure
+	QCache<QString, QElapsedTimer> failures;
+};
+
+} // namespace qs::service::mpris
@@ -2,12 +2,12 @@
 
 #include <qtimer.h>
 #include <qcontainerfwd.h>
-#include <qdatetime.h>
 #include <qdbusconnection.h>
 #include <qdbusextratypes.h>
 #include <qlist.h>
 #include <qlogging.h>
 #include <qloggingcategory.h>
+#include <qmetaobject.h>
 #include <qobject.h>
 #include <qproperty.h>
 #include <qstring.h>
@@ -15,8 +15,10 @@
 #include <qtypes.h>
 
 #include "../../dbus/properties.hpp"
+#include "art.hpp"
 #include "dbus_player.h"
 #include "dbus_player_app.h"
+#include "positionticker.hpp"
 
 using namespace qs::dbus;
 
@@ -91,6 +93,16 @@ MprisPlayer::MprisPlayer(const QString& address, QObject* parent): QObject(paren
 		return this->bMetadata.value().value("mpris:artUrl").toString();
 	});
 
+	this->bTrackArtImage.setBinding([this]() {
+		// re-resolved on every metadata change as the art file may change without its url
+		this->bMetadata.value();
+
+		return MprisArtProvider::instance()->imageUrl(
+		    this->bTrackArtUrl.value(),
+		    this->bUniqueId.value()
+		);
+	});
+
 	this->bInternalLength.setBinding([this]() {
 		auto variant = this->bMetadata.value().value("mpris:length");
 		if (variant.isValid() && variant.canConvert<qlonglong>()) {
@@ -104,7 +116,7 @@ MprisPlayer::MprisPlayer(const QString& address, QObject* parent): QObject(paren
 		if (status == "Playing") {
 			return MprisPlaybackState::Playing;
 		} else if (status == "Paused") {
-			this->pausedTime = QDateTime::currentDateTimeUtc();
+			this->pausedTime = MprisPositionTicker::now();
 			return MprisPlaybackState::Paused;
 		} else if (status == "Stopped") {
 			return MprisPlaybackState::Stopped;
@@ -203,12 +215,12 @@ qlonglong MprisPlayer::positionMs() const {
 	if (this->bPlaybackState == MprisPlaybackState::Stopped) return 0;
 
 	auto paused = this->bPlaybackState == MprisPlaybackState::Paused;
-	auto time = paused ? this->pausedTime : QDateTime::currentDateTime();
+	auto time = paused ? this->pausedTime : MprisPositionTicker::now();
 	auto offset = time - this->lastPositionTimestamp;
 	auto rateMul = static_cast<qlonglong>(this->bRate.value() * 1000);
 	offset = (offset * rateMul) / 1000;
 
-	return (this->bpPosition.value() / 1000) + offset.count();
+	return (this->bpPosition.value() / 1000) + offset;
 }
 
 qreal MprisPlayer::position() const {
@@ -244,11 +256,15 @@ void MprisPlayer::setPosition(qreal position) {
 }
 
 void MprisPlayer::onPositionUpdated() {
-	const bool firstChange = !this->lastPositionTimestamp.isValid();
-	this->lastPositionTimestamp = QDateTime::currentDateTimeUtc();
+	const bool firstChange = this->lastPositionTimestamp == -1;
+	this->lastPositionTimestamp = MprisPositionTicker::now();
 	this->pausedTime = this->lastPositionTimestamp;
 	emit this->positionChanged();
-	if (firstChange) emit this->positionSupportedChanged();
+
+	if (firstChange) {
+		emit this->positionSupportedChanged();
+		this->updatePositionTicking();
+	}
 }
 
 void MprisPlayer::setPosition(qlonglong position) {
@@ -262,6 +278,34 @@ void MprisPlayer::onExportedPositionChanged() {
 
 void MprisPlayer::onSeek(qlonglong time) { this->setPosition(time); }
 
+void MprisPlayer::connectNotify(const QMetaMethod& signal) {
+	static const auto positionSignal = QMetaMethod::fromSignal(&MprisPlayer::positionChanged);
+	static const auto lengthSignal = QMetaMethod::fromSignal(&MprisPlayer::lengthChanged);
+
+	if (signal == positionSignal || signal == lengthSignal) this->updatePositionTicking();
+}
+
+void MprisPlayer::disconnectNotify(const QMetaMethod& signal) {
+	static const auto positionSignal = QMetaMethod::fromSignal(&MprisPlayer::positionChanged);
+	static const auto lengthSignal = QMetaMethod::fromSignal(&MprisPlayer::lengthChanged);
+
+	// an invalid method means all connections were removed
+	if (!signal.isValid() || signal == positionSignal || signal == lengthSignal) {
+		this->updatePositionTicking();
+	}
+}
+
+void MprisPlayer::updatePositionTicking() {
+	// Observers are counted from the current connections instead of being tracked across
+	// notifications, which do not always pair up. The connection to onExportedPositionChanged
+	// made in the constructor is not an observer.
+	auto observers = this->receivers(SIGNAL(positionChanged())) - 1
+	               + this->receivers(SIGNAL(lengthChanged()));
+
+	auto active = observers > 0 && this->bIsPlaying && this->positionSupported();
+	MprisPositionTicker::instance()->setPlayerActive(this, active);
+}
+
 qreal MprisPlayer::length() const {
 	if (this->bInternalLength == -1) {
 		return this->position(); // unsupported
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <qcontainerfwd.h>
+#include <qmetaobject.h>
 #include <qobject.h>
 #include <qproperty.h>
 #include <qqmlintegration.h>
@@ -82,34 +83,13 @@ class MprisPlayer: public QObject {
 	///
 	/// May only be written to if @@canSeek and @@positionSupported are true.
 	///
-	/// > [!WARNING] To avoid excessive property updates wasting CPU while `position` is not
-	/// > actively monitored, `position` usually will not update reactively, unless a nonlinear
-	/// > change in position occurs, however reading it will always return the current position.
-	/// >
-	/// > If you want to actively monitor the position, the simplest way it to emit the @@positionChanged(s)
-	/// > signal manually for the duration you are monitoring it, Using a @@QtQuick.FrameAnimation if you need
-	/// > the value to update smoothly, such as on a slider, or a @@QtQuick.Timer if not, as shown below.
-	/// >
-	/// > ```qml {filename="Using a FrameAnimation"}
-	/// > FrameAnimation {
-	/// >   // only emit the signal when the position is actually changing.
-	/// >   running: player.playbackState == MprisPlaybackState.Playing
-	/// >   // emit the positionChanged signal every frame.
-	/// >   onTriggered: player.positionChanged()
-	/// > }
-	/// > ```
-	/// >
-	/// > ```qml {filename="Using a Timer"}
-	/// > Timer {
-	/// >   // only emit the signal when the position is actually changing.
-	/// >   running: player.playbackState == MprisPlaybackState.Playing
-	/// >   // Make sure the position updates at least once per second.
-	/// >   interval: 1000
-	/// >   repeat: true
-	/// >   // emit the positionChanged signal every second.
-	/// >   onTriggered: player.positionChanged()
-	/// > }
-	/// > ```
+	/// While `position` (or @@length if @@lengthSupported is false) is bound to and the player is playing,
+	/// it updates on a shared clock every @@Mpris.positionUpdateInterval milliseconds.
+	/// Otherwise `position` usually will not update reactively, unless a nonlinear change
+	/// in position occurs, however reading it will always return the current position.
+	///
+	/// > [!TIP] Set @@Mpris.positionUpdateInterval to `0` to update the position every frame,
+	/// > such as when it is displayed on a slider.
 	Q_PROPERTY(qreal position READ position WRITE setPosition NOTIFY positionChanged);
 	Q_PROPERTY(bool positionSupported READ positionSupported NOTIFY positionSupportedChanged);
 	/// The length of the playing track, as seconds, with millisecond precision,
@@ -158,7 +138,15 @@ class MprisPlayer: public QObject {
 	/// > when no album artist is available.
 	Q_PROPERTY(QString trackAlbumArtist READ trackAlbumArtist NOTIFY trackAlbumArtistChanged BINDABLE bindableTrackAlbumArtist);
 	/// The current track's art url, or `""` if none was provided.
+	///
+	/// > [!TIP] Prefer @@trackArtImage when displaying the art in an @@QtQuick.Image.
 	Q_PROPERTY(QString trackArtUrl READ trackArtUrl NOTIFY trackArtUrlChanged BINDABLE bindableTrackArtUrl);
+	/// The current track's art as an image source, or `""` if none was provided.
+	///
+	/// Local art is decoded once in the background and shared between every image using it.
+	/// Set @@QtQuick.Image.sourceSize to receive a cached downscaled copy instead of the full
+	/// size art, which is often several megapixels. Remote art is passed through as is.
+	Q_PROPERTY(QString trackArtImage READ trackArtImage NOTIFY trackArtImageChanged BINDABLE bindableTrackArtImage);
 	/// The playback state of the media player.
 	///
 	/// - If @@canPlay is false, you cannot assign the `Playing` state.
@@ -281,6 +269,7 @@ public:
 	QS_BINDABLE_GETTER(QString, bTrackAlbumArtist, trackAlbumArtist, bindableTrackAlbumArtist);
 	QS_BINDABLE_GETTER(QString, bTrackArtist, trackArtist, bindableTrackArtist);
 	QS_BINDABLE_GETTER(QString, bTrackArtUrl, trackArtUrl, bindableTrackArtUrl);
+	QS_BINDABLE_GETTER(QString, bTrackArtImage, trackArtImage, bindableTrackArtImage);
 
 	QS_BINDABLE_GETTER(
 	    MprisPlaybackState::Enum,
@@ -370,6 +359,7 @@ signals:
 	void trackAlbumChanged();
 	void trackAlbumArtistChanged();
 	void trackArtUrlChanged();
+	void trackArtImageChanged();
 	void playbackStateChanged();
 	void isPlayingChanged();
 	void loopStateChanged();
@@ -388,9 +378,14 @@ private slots:
 	void onExportedPositionChanged();
 	void onSeek(qlonglong time);
 
+protected:
+	void connectNotify(const QMetaMethod& signal) override;
+	void disconnectNotify(const QMetaMethod& signal) override;
+
 private:
 	void onMetadataChanged();
 	void onPositionUpdated();
+	void updatePositionTicking();
 	void onPlaybackStatusUpdated();
 	// call instead of setting bpPosition
 	void setPosition(qlonglong position);
@@ -437,6 +432,7 @@ private:
 	Q_OBJECT_BINDABLE_PROPERTY_WITH_ARGS(MprisPlayer, qreal, bVolume, 1, &MprisPlayer::volumeChanged);
 	Q_OBJECT_BINDABLE_PROPERTY(MprisPlayer, MprisPlaybackState::Enum, bPlaybackState, &MprisPlayer::playbackStateChanged);
 	Q_OBJECT_BINDABLE_PROPERTY(MprisPlayer, bool, bIsPlaying, &MprisPlayer::isPlayingChanged);
+	QS_BINDING_SUBSCRIBE_METHOD(MprisPlayer, bIsPlaying, updatePositionTicking, onValueChanged);
 	QS_BINDING_SUBSCRIBE_METHOD(MprisPlayer, bPlaybackState, requestPositionUpdate, onValueChanged);
 	Q_OBJECT_BINDABLE_PROPERTY(MprisPlayer, MprisLoopState::Enum, bLoopState, &MprisPlayer::loopStateChanged);
 	Q_OBJECT_BINDABLE_PROPERTY_WITH_ARGS(MprisPlayer, qreal, bRate, 1, &MprisPlayer::rateChanged);
@@ -450,6 +446,7 @@ private:
 	Q_OBJECT_BINDABLE_PROPERTY(MprisPlayer, QString, bTrackAlbum, &MprisPlayer::trackAlbumChanged);
 	Q_OBJECT_BINDABLE_PROPERTY(MprisPlayer, QString, bTrackAlbumArtist, &MprisPlayer::trackAlbumArtistChanged);
 	Q_OBJECT_BINDABLE_PROPERTY(MprisPlayer, QString, bTrackArtUrl, &MprisPlayer::trackArtUrlChanged);
+	Q_OBJECT_BINDABLE_PROPERTY(MprisPlayer, QString, bTrackArtImage, &MprisPlayer::trackArtImageChanged);
 	Q_OBJECT_BINDABLE_PROPERTY(MprisPlayer, qlonglong, bInternalLength, &MprisPlayer::lengthChanged);
 	Q_OBJECT_BINDABLE_PROPERTY(MprisPlayer, bool, bShuffle, &MprisPlayer::shuffleChanged);
 
@@ -471,8 +468,9 @@ private:
 	QS_DBUS_PROPERTY_BINDING(MprisPlayer, pShuffle, bShuffle, playerProperties, "Shuffle", false);
 	// clang-format on
 
-	QDateTime lastPositionTimestamp;
-	QDateTime pausedTime;
+	// monotonic, see MprisPositionTicker::now()
+	qint64 lastPositionTimestamp = -1;
+	qint64 pausedTime = -1;
 
 	DBusMprisPlayerApp* app = nullptr;
 	DBusMprisPlayer* player = nullptr;
@@ -0,0 +1,170 @@
+#include "positionticker.hpp"
+
+#include <qelapsedtimer.h>
+#include <qguiapplication.h>
+#include <qlogging.h>
+#include <qloggingcategory.h>
+#include <qmetaobject.h>
+#include <qnamespace.h>
+#include <qobject.h>
+#include <qquickwindow.h>
+#include <qtypes.h>
+#include <qwindow.h>
+
+#include "player.hpp"
+
+namespace qs::service::mpris {
+
+namespace {
+Q_LOGGING_CATEGORY(logMprisTicker, "quickshell.service.mp.ticker", QtWarningMsg);
+
+// tick interval used when updating every frame
+constexpr qint32 FRAME_INTERVAL = 16;
+// a window that produced a frame within this time is considered to be rendering,
+// and is the longest a due tick will wait for its next frame
+constexpr qint32 FRAME_WAIT = FRAME_INTERVAL * 2;
+} // namespace
+
+MprisPositionTicker::MprisPositionTicker() {
+	this->frameTimer.setSingleShot(true);
+	this->frameTimer.setInterval(FRAME_WAIT);
+
+	// clang-format off
+	QObject::connect(&this->timer, &QTimer::timeout, this, &MprisPositionTicker::onTimeout);
+	QObject::connect(&this->frameTimer, &QTimer::timeout, this, &MprisPositionTicker::onFrameTimeout);
+	// clang-format on
+}
+
+MprisPositionTicker* MprisPositionTicker::instance() {
+	static auto* instance = new MprisPositionTicker(); // NOLINT
+	return instance;
+}
+
+qint64 MprisPositionTicker::now() {
+	static auto clock = [] {
+		auto timer = QElapsedTimer();
+		timer.start();
+		return timer;
+	}();
+
+	return clock.elapsed();
+}
+
+void MprisPositionTicker::setPlayerActive(MprisPlayer* player, bool active) {
+	if (active == this->players.contains(player)) return;
+
+	if (active) {
+		this->players.insert(player);
+		QObject::connect(player, &QObject::destroyed, this, &MprisPositionTicker::onPlayerDestroyed);
+	} else {
+		this->players.remove(player);
+		QObject::disconnect(player, nullptr, this, nullptr);
+	}
+
+	qCDebug(logMprisTicker) << "Player" << player << "ticking:" << active << "active players:"
+	                        << this->players.size();
+
+	// Bindings may drop and re-add their observers while being reevaluated,
+	// which should not restart the timer.
+	this->scheduleUpdate();
+}
+
+void MprisPositionTicker::scheduleUpdate() {
+	if (this->updateQueued) return;
+	this->updateQueued = true;
+	QMetaObject::invokeMethod(this, &MprisPositionTicker::updateState, Qt::QueuedConnection);
+}
+
+void MprisPositionTicker::setInterval(qint32 interval) {
+	if (interval < 0) interval = 0;
+	if (interval == this->mInterval) return;
+
+	this->mInterval = interval;
+	this->updateState();
+	emit this->intervalChanged();
+}
+
+void MprisPositionTicker::onPlayerDestroyed(QObject* object) {
+	this->players.remove(static_cast<MprisPlayer*>(object)); // NOLINT
+	this->scheduleUpdate();
+}
+
+void MprisPositionTicker::updateState() {
+	this->updateQueued = false;
+
+	auto active = !this->players.isEmpty();
+	this->setWindowsConnected(active);
+
+	if (!active) {
+		this->timer.stop();
+		this->frameTimer.stop();
+		this->tickPending = false;
+		return;
+	}
+
+	auto interval = this->mInterval == 0 ? FRAME_INTERVAL : this->mInterval;
+
+	// Slow updates do not need to be exact, and may be coalesced with other timers.
+	this->timer.setTimerType(this->mInterval == 0 ? Qt::PreciseTimer : Qt::CoarseTimer);
+
+	if (!this->timer.isActive() || this->timer.interval() != interval) {
+		this->timer.start(interval);
+	}
+}
+
+void MprisPositionTicker::setWindowsConnected(bool connected) {
+	// Windows are only observed passively. Nothing here requests a frame, so unexposed
+	// windows cannot stall ticks and idle windows are not repainted.
+	for (auto* window: QGuiApplication::topLevelWindows()) {
+		if (auto* quickWindow = qobject_cast<QQuickWindow*>(window)) {
+			if (connected) {
+				QObject::connect(
+				    quickWindow,
+				    &QQuickWindow::afterAnimating,
+				    this,
+				    &MprisPositionTicker::onFrame,
+				    Qt::UniqueConnection
+				);
+			} else {
+				QObject::disconnect(quickWindow, nullptr, this, nullptr);
+			}
+		}
+	}
+}
+
+void MprisPositionTicker::onTimeout() {
+	// pick up windows created since the last tick
+	this->setWindowsConnected(true);
+
+	// Align the tick to the next frame if a window is currently rendering,
+	// so every bound property changes before the same render.
+	if (this->lastFrame != -1 && MprisPositionTicker::now() - this->lastFrame < FRAME_WAIT) {
+		this->tickPending = true;
+		this->frameTimer.start();
+	} else {
+		this->tick();
+	}
+}
+
+void MprisPositionTicker::onFrame() {
+	this->lastFrame = MprisPositionTicker::now();
+	if (this->tickPending) this->tick();
+}
+
+void MprisPositionTicker::onFrameTimeout() {
+	// the window stopped rendering before the tick was delivered
+	if (this->tickPending) this->tick();
+}
+
+void MprisPositionTicker::tick() {
+	this->tickPending = false;
+	this->frameTimer.stop();
+
+	// observers may change while the signal is being delivered
+	const auto players = this->players;
+	for (auto* player: players) {
+		emit player->positionChanged();
+	}
+}
+
+} // namespace qs::service::mpris
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <qobject.h>
+#include <qset.h>
+#include <qtimer.h>
+#include <qtmetamacros.h>
+#include <qtypes.h>
+
+namespace qs::service::mpris {
+
+class MprisPlayer;
+
+// Drives positionChanged for every playing player with an observed position from a single
+// timer. When a window is already producing frames, due ticks are delivered from its next
+// frame so bound properties change together before the same render.
+class MprisPositionTicker: public QObject {
+	Q_OBJECT;
+
+public:
+	static MprisPositionTicker* instance();
+
+	// Milliseconds on a monotonic clock.
+	static qint64 now();
+
+	void setPlayerActive(MprisPlayer* player, bool active);
+
+	[[nodiscard]] qint32 interval() const { return this->mInterval; }
+	void setInterval(qint32 interval);
+
+signals:
+	void intervalChanged();
+
+private slots:
+	void onTimeout();
+	void onFrame();
+	void onFrameTimeout();
+	void onPlayerDestroyed(QObject* object);
+	void updateState();
+
+private:
+	explicit MprisPositionTicker();
+
+	void scheduleUpdate();
+	void tick();
+	void setWindowsConnected(bool connected);
+
+	QTimer timer;
+	QTimer frameTimer;
+	QSet<MprisPlayer*> players;
+	qint32 mInterval = 1000;
+	qint64 lastFrame = -1;
+	bool tickPending = false;
+	bool updateQueued = false;
+};
+
+} // namespace qs::service::mpris
@@ -11,6 +11,7 @@
 
 #include "../../core/model.hpp"
 #include "player.hpp"
+#include "positionticker.hpp"
 
 namespace qs::service::mpris {
 
@@ -109,8 +110,25 @@ MprisWatcher* MprisWatcher::instance() {
 	return instance;
 }
 
+MprisQml::MprisQml(QObject* parent): QObject(parent) {
+	QObject::connect(
+	    MprisPositionTicker::instance(),
+	    &MprisPositionTicker::intervalChanged,
+	    this,
+	    &MprisQml::positionUpdateIntervalChanged
+	);
+}
+
 ObjectModel<MprisPlayer>* MprisQml::players() { // NOLINT
 	return MprisWatcher::instance()->players();
 }
 
+qint32 MprisQml::positionUpdateInterval() const { // NOLINT
+	return MprisPositionTicker::instance()->interval();
+}
+
+void MprisQml::setPositionUpdateInterval(qint32 interval) { // NOLINT
+	MprisPositionTicker::instance()->setInterval(interval);
+}
+
 } // namespace qs::service::mpris
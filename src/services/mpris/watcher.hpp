@@ -9,6 +9,7 @@
 #include <qqmlintegration.h>
 #include <qqmllist.h>
 #include <qtmetamacros.h>
+#include <qtypes.h>
 
 #include "../../core/doc.hpp"
 #include "../../core/model.hpp"
@@ -49,11 +50,25 @@ class MprisQml: public QObject {
 	/// All connected MPRIS players.
 	QSDOC_TYPE_OVERRIDE(ObjectModel<qs::service::mpris::MprisPlayer>*);
 	Q_PROPERTY(UntypedObjectModel* players READ players CONSTANT);
+	/// The interval in milliseconds at which @@MprisPlayer.position updates while it is
+	/// bound to and the player is playing. Defaults to `1000`.
+	///
+	/// If set to `0`, the position updates about every 16ms. Updates are aligned to the frames
+	/// of windows that are already rendering, but never cause a window to render on their own.
+	///
+	/// This setting is shared by all players.
+	Q_PROPERTY(qint32 positionUpdateInterval READ positionUpdateInterval WRITE setPositionUpdateInterval NOTIFY positionUpdateIntervalChanged);
 
 public:
-	explicit MprisQml(QObject* parent = nullptr): QObject(parent) {};
+	explicit MprisQml(QObject* parent = nullptr);
 
 	[[nodiscard]] ObjectModel<MprisPlayer>* players();
+
+	[[nodiscard]] qint32 positionUpdateInterval() const;
+	void setPositionUpdateInterval(qint32 interval);
+
+signals:
+	void positionUpdateIntervalChanged();
 };
 
 } // namespace qs::service::mpris
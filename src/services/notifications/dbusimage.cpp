@@ -1,8 +1,16 @@
 #include "dbusimage.hpp"
+#include <limits>
+#include <utility>
 
+#include <qbytearray.h>
+#include <qbuffer.h>
 #include <qdbusargument.h>
+#include <qhash.h>
 #include <qimage.h>
 #include <qloggingcategory.h>
+#include <qmutex.h>
+#include <qnamespace.h>
+#include <qsharedpointer.h>
 #include <qsize.h>
 #include <qsysinfo.h>
 #include <qtypes.h>
@@ -62,12 +70,178 @@ const QDBusArgument& operator<<(QDBusArgument& argument, const DBusNotificationI
 	return argument;
 }
 
-QImage
-NotificationImage::requestImage(const QString& /*unused*/, QSize* size, const QSize& /*unused*/) {
-	auto image = this->image.createImage();
+namespace {
 
-	if (size != nullptr) *size = image.size();
-	return image;
+QMutex imageCacheMutex;                                            // NOLINT
+QHash<QByteArray, QWeakPointer<NotificationImageData>> imageCache; // NOLINT
+
+// scaled variants kept per image before the cache is reset
+constexpr qsizetype MAX_VARIANTS = 4;
+
+QSize scaledImageSize(const QSize& size, const QSize& requestedSize) {
+	if (requestedSize.width() <= 0 && requestedSize.height() <= 0) return size;
+
+	// a zero dimension in the requested size means the image is only constrained by the other
+	auto bounds = QSize(
+	    requestedSize.width() > 0 ? requestedSize.width() : std::numeric_limits<int>::max(),
+	    requestedSize.height() > 0 ? requestedSize.height() : std::numeric_limits<int>::max()
+	);
+
+	auto scaled = size.scaled(bounds, Qt::KeepAspectRatio);
+	if (scaled.width() >= size.width() || scaled.height() >= size.height()) return size;
+	return scaled;
+}
+
+} // namespace
+
+QByteArray NotificationImageData::contentKey(const DBusNotificationImage& image) {
+	auto hash = static_cast<quint64>(qHash(image.data));
+
+	return QByteArray::number(image.width) + 'x' + QByteArray::number(image.height)
+	     + (image.hasAlpha ? 'a' : 'o') + QByteArray::number(hash, 16);
+}
+
+QSharedPointer<NotificationImageData>
+NotificationImageData::acquire(const QByteArray& key, const DBusNotificationImage& image) {
+	{
+		auto locker = QMutexLocker(&imageCacheMutex);
+
+		if (auto existing = imageCache.value(key).toStrongRef()) {
+			qCDebug(logNotifications) << "Reusing decoded notification image" << key;
+			return existing;
+		}
+	}
+
+	// createImage only wraps the raw data, which is freed once every request has resolved
+	auto decoded = image.createImage().copy();
+	qCDebug(logNotifications) << "Decoded notification image" << key << "at" << decoded.size();
+
+	auto locker = QMutexLocker(&imageCacheMutex);
+
+	// another request may have decoded the same image in the meantime
+	if (auto existing = imageCache.value(key).toStrongRef()) return existing;
+
+	auto data = QSharedPointer<NotificationImageData>(
+	    new NotificationImageData(key, std::move(decoded)),
+	    &NotificationImageData::release
+	);
+
+	imageCache.insert(key, data);
+	return data;
+}
+
+void NotificationImageData::release(NotificationImageData* data) {
+	{
+		auto locker = QMutexLocker(&imageCacheMutex);
+
+		// the entry may have been replaced between the last strong ref dropping and this call
+		auto it = imageCache.find(data->key);
+		if (it != imageCache.end() && it->isNull()) imageCache.erase(it);
+	}
+
+	delete data;
+}
+
+QImage NotificationImageData::request(const QSize& requestedSize) {
+	auto size = scaledImageSize(this->size, requestedSize);
+
+	auto variantKey =
+	    (static_cast<quint64>(size.width()) << 32) | static_cast<quint32>(size.height());
+
+	auto locker = QMutexLocker(&this->mutex);
+
+	if (auto it = this->variants.constFind(variantKey); it != this->variants.constEnd()) {
+		return *it;
+	}
+
+	auto full = this->image;
+
+	if (full.isNull() && !full.loadFromData(this->encoded, "PNG")) {
+		qCWarning(logNotifications) << "Failed to decode notification image" << this->key;
+		return QImage();
+	}
+
+	auto result = full;
+
+	if (size != this->size) {
+		result = full.scaled(size, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+	}
+
+	if (this->variants.size() >= MAX_VARIANTS) this->variants.clear();
+	this->variants.insert(variantKey, result);
+
+	// Only the scaled copy is needed once it exists. The PNG copy is a fraction of the size of
+	// the decoded pixels and lets other sizes be produced later.
+	if (!this->image.isNull() && size != this->size) {
+		auto buffer = QBuffer(&this->encoded);
+		buffer.open(QBuffer::WriteOnly);
+
+		if (this->image.save(&buffer, "PNG")) {
+			qCDebug(logNotifications).nospace()
+			    << "Released full size notification image " << this->key << " ("
+			    << this->image.sizeInBytes() << " bytes, " << this->encoded.size() << " encoded)";
+
+			this->image = QImage();
+		} else {
+			this->encoded.clear();
+		}
+	}
+
+	return result;
+}
+
+QImage NotificationImageSource::request(const QSize& requestedSize) {
+	auto locker = QMutexLocker(&this->mutex);
+
+	if (!this->data) {
+		this->data = NotificationImageData::acquire(this->mKey, this->raw);
+		this->raw.data = QByteArray();
+	}
+
+	return this->data->request(requestedSize);
+}
+
+bool NotificationImage::hasData() const {
+	auto locker = QMutexLocker(&this->mutex);
+	return this->source != nullptr;
+}
+
+void NotificationImage::setImage(DBusNotificationImage image) {
+	auto key = image.data.isEmpty() ? QByteArray() : NotificationImageData::contentKey(image);
+
+	{
+		auto locker = QMutexLocker(&this->mutex);
+
+		// identical images keep their url, so the image is not reloaded
+		if (this->source ? this->source->key() == key : key.isEmpty()) return;
+
+		// decoding is deferred to the first request
+		if (key.isEmpty()) this->source.reset();
+		else this->source = QSharedPointer<NotificationImageSource>::create(key, std::move(image));
+	}
+
+	this->imageChanged();
+}
+
+void NotificationImage::clear() {
+	auto locker = QMutexLocker(&this->mutex);
+	this->source.reset();
+}
+
+QsImageHandle::AsyncImageRequest NotificationImage::asyncImageRequest() const {
+	auto source = QSharedPointer<NotificationImageSource>();
+
+	{
+		auto locker = QMutexLocker(&this->mutex);
+		source = this->source;
+	}
+
+	return [source](const QString& /*unused*/, QSize* size, const QSize& requestedSize) {
+		auto image = source ? source->request(requestedSize) : QImage();
+
+		if (size != nullptr) *size = image.size();
+		return image;
+	};
 }
 
 } // namespace qs::service::notifications
@@ -1,8 +1,16 @@
 #pragma once
 
+#include <utility>
+
+#include <qbytearray.h>
 #include <qdbusargument.h>
+#include <qhash.h>
 #include <qimage.h>
+#include <qmutex.h>
 #include <qobject.h>
+#include <qsharedpointer.h>
+#include <qsize.h>
+#include <qtypes.h>
 
 #include "../../core/imageprovider.hpp"
 
@@ -21,22 +29,73 @@ struct DBusNotificationImage {
 const QDBusArgument& operator>>(const QDBusArgument& argument, DBusNotificationImage& pixmap);
 const QDBusArgument& operator<<(QDBusArgument& argument, const DBusNotificationImage& pixmap);
 
-class NotificationImage: public QsIndexedImageHandle {
+// Decoded hint image shared between all notifications that sent identical pixel data.
+// Scaled variants are cached per requested size. The full size decode is only kept until
+// the first scaled variant exists, after which it is replaced by a compact PNG copy that
+// is decoded again if a missing size is requested.
+// Safe to use from the image provider's worker thread.
+class NotificationImageData {
+public:
+	explicit NotificationImageData(QByteArray key, QImage image)
+	    : key(std::move(key))
+	    , size(image.size())
+	    , image(std::move(image)) {}
+
+	// Identifies the pixel data of an image. Cheap enough to compare images on the gui thread.
+	static QByteArray contentKey(const DBusNotificationImage& image);
+
+	// Returns the decoded data for the given image, reusing the data of a live
+	// notification carrying the same content key. Copies the pixel data,
+	// so it should not be called from the gui thread.
+	static QSharedPointer<NotificationImageData>
+	acquire(const QByteArray& key, const DBusNotificationImage& image);
+
+	QImage request(const QSize& requestedSize);
+
+private:
+	static void release(NotificationImageData* data);
+
+	QByteArray key;
+	QSize size;
+	QMutex mutex;
+	QImage image;
+	QByteArray encoded;
+	QHash<quint64, QImage> variants;
+};
+
+// Hint image of a single notification. The raw pixel data is kept until the first
+// request, which resolves it to shared decoded data on the image provider's worker thread.
+class NotificationImageSource {
 public:
-	explicit NotificationImage(): QsIndexedImageHandle(QQuickAsyncImageProvider::Image) {}
+	explicit NotificationImageSource(QByteArray key, DBusNotificationImage image)
+	    : mKey(std::move(key))
+	    , raw(std::move(image)) {}
+
+	QImage request(const QSize& requestedSize);
 
-	[[nodiscard]] bool hasData() const { return !this->image.data.isEmpty(); }
-	void clear() { this->image.data.clear(); }
+	// Content key of the image. Never modified after construction.
+	[[nodiscard]] const QByteArray& key() const { return this->mKey; }
+
+private:
+	QByteArray mKey;
+	QMutex mutex;
+	DBusNotificationImage raw;
+	QSharedPointer<NotificationImageData> data;
+};
+
+class NotificationImage: public QsIndexedImageHandle {
+public:
+	explicit NotificationImage(): QsIndexedImageHandle(QQuickAsyncImageProvider::Image, true) {}
 
-	[[nodiscard]] DBusNotificationImage& writeImage() {
-		this->imageChanged();
-		return this->image;
-	}
+	[[nodiscard]] bool hasData() const;
+	void setImage(DBusNotificationImage image);
+	void clear();
 
-	QImage requestImage(const QString& id, QSize* size, const QSize& requestedSize) override;
+	[[nodiscard]] AsyncImageRequest asyncImageRequest() const override;
 
 private:
-	DBusNotificationImage image;
+	mutable QMutex mutex;
+	QSharedPointer<NotificationImageSource> source;
 };
 
 } // namespace qs::service::notifications
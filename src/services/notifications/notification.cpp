@@ -1,4 +1,5 @@
 #include "notification.hpp"
+#include <utility>
 
 #include <qcontainerfwd.h>
 #include <qdbusargument.h>
@@ -120,8 +121,10 @@ void Notification::updateProperties(
 		this->mImagePixmap.clear();
 	} else {
 		auto value = hints.value(imageDataName).value<QDBusArgument>();
-		value >> this->mImagePixmap.writeImage();
-		imagePath = this->mImagePixmap.url();
+		auto image = DBusNotificationImage();
+		value >> image;
+		this->mImagePixmap.setImage(std::move(image));
+		if (this->mImagePixmap.hasData()) imagePath = this->mImagePixmap.url();
 	}
 
 	// don't store giant byte arrays longer than necessary
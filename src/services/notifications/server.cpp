@@ -63,7 +63,7 @@ NotificationServer* NotificationServer::instance() {
 
 void NotificationServer::switchGeneration(bool reEmit, const std::function<void()>& clearHook) {
 	auto notifications = this->mNotifications.valueList();
-	this->mNotifications.valueList().clear();
+	this->mNotifications.mutableValueList().clear();
 	this->idMap.clear();
 
 	clearHook();
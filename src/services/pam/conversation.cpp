@@ -1,14 +1,28 @@
 #include "conversation.hpp"
+#include <array>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <string>
 
+#include <fcntl.h>
+#include <qcoreapplication.h>
+#include <qdir.h>
+#include <qfileinfo.h>
 #include <qlogging.h>
 #include <qloggingcategory.h>
 #include <qobject.h>
 #include <qsocketnotifier.h>
 #include <qstring.h>
 #include <qtmetamacros.h>
+#include <spawn.h>
 #include <sys/wait.h>
+#include <unistd.h>
 
 #include "ipc.hpp"
+#include "subprocess.hpp"
+
+extern char** environ; // NOLINT
 
 Q_LOGGING_CATEGORY(logPam, "quickshell.service.pam", QtWarningMsg);
 
@@ -33,14 +47,135 @@ QString PamResult::toString(PamResult::Enum value) {
 
 PamConversation::~PamConversation() { this->abort(); }
 
+const QString& PamConversation::helperPath() {
+	static const auto path = [] {
+		// prefer a helper next to the executable so uninstalled builds use their own helper
+		auto local = QDir(QCoreApplication::applicationDirPath()).filePath("quickshell-pam-helper");
+		if (QFileInfo(local).isExecutable()) return local;
+
+		auto installed = QStringLiteral(QS_PAM_HELPER_PATH);
+		if (QFileInfo(installed).isExecutable()) return installed;
+
+		qCWarning(logPam) << "quickshell-pam-helper was not found, falling back to forking.";
+		return QString();
+	}();
+
+	return path;
+}
+
+pid_t PamConversation::spawnHelper(PamIpcPipes* pipes) {
+	const auto& path = PamConversation::helperPath();
+	if (path.isEmpty()) return 0;
+
+	auto toHelper = std::array<int, 2>();
+	auto fromHelper = std::array<int, 2>();
+
+	if (pipe2(toHelper.data(), O_CLOEXEC) == -1) {
+		qCWarning(logPam) << "Failed to create pipes for pam helper.";
+		return 0;
+	}
+
+	if (pipe2(fromHelper.data(), O_CLOEXEC) == -1) {
+		qCWarning(logPam) << "Failed to create pipes for pam helper.";
+		close(toHelper[0]);
+		close(toHelper[1]);
+		return 0;
+	}
+
+	// The child ends are moved above the helper's fds so dup2 does not clobber either.
+	auto childIn = fcntl(toHelper[0], F_DUPFD_CLOEXEC, PamSubprocess::HELPER_FD_OUT + 1);
+	auto childOut = fcntl(fromHelper[1], F_DUPFD_CLOEXEC, PamSubprocess::HELPER_FD_OUT + 1);
+	close(toHelper[0]);
+	close(fromHelper[1]);
+
+	if (childIn == -1 || childOut == -1) {
+		qCWarning(logPam) << "Failed to duplicate pipes for pam helper.";
+		if (childIn != -1) close(childIn);
+		if (childOut != -1) close(childOut);
+		close(toHelper[1]);
+		close(fromHelper[0]);
+		return 0;
+	}
+
+	posix_spawn_file_actions_t actions;
+	posix_spawn_file_actions_init(&actions);
+	posix_spawn_file_actions_adddup2(&actions, childIn, PamSubprocess::HELPER_FD_IN);
+	posix_spawn_file_actions_adddup2(&actions, childOut, PamSubprocess::HELPER_FD_OUT);
+
+	auto pathStr = path.toStdString();
+	auto logArg = std::string("--log");
+	auto argv = std::array<char*, 3> {pathStr.data(), nullptr, nullptr};
+	if (logPam().isDebugEnabled()) argv[1] = logArg.data();
+
+	pid_t pid = 0;
+	auto r = posix_spawn(&pid, pathStr.c_str(), &actions, nullptr, argv.data(), environ);
+	posix_spawn_file_actions_destroy(&actions);
+
+	close(childIn);
+	close(childOut);
+
+	if (r != 0) {
+		qCWarning(logPam) << "Failed to start pam helper:" << qt_error_string(r);
+		close(toHelper[1]);
+		close(fromHelper[0]);
+		return 0;
+	}
+
+	pipes->fdIn = fromHelper[0];
+	pipes->fdOut = toHelper[1];
+
+	qCDebug(logPam) << "Started pam helper with pid" << pid;
+	return pid;
+}
+
+bool PamConversation::prepare() {
+	if (this->helperRunning) {
+		// the helper may have been killed while waiting
+		if (waitpid(this->childPid, nullptr, WNOHANG) == 0) return true;
+
+		qCDebug(logPam) << "Prepared pam helper" << this->childPid << "exited, restarting it.";
+		this->childPid = 0;
+		this->helperRunning = false;
+		close(this->pipes.fdIn);
+		close(this->pipes.fdOut);
+		this->pipes.fdIn = 0;
+		this->pipes.fdOut = 0;
+	}
+
+	if (this->childPid != 0) return false;
+
+	this->childPid = PamConversation::spawnHelper(&this->pipes);
+	this->helperRunning = this->childPid != 0;
+	return this->helperRunning;
+}
+
 void PamConversation::start(const QString& configDir, const QString& config, const QString& user) {
-	this->childPid = PamConversation::createSubprocess(&this->pipes, configDir, config, user);
-	if (this->childPid == 0) {
-		qCCritical(logPam) << "Failed to create pam subprocess.";
-		emit this->error(PamError::InternalError);
-		return;
+	this->startTimer.start();
+	auto prepared = this->helperRunning;
+
+	if (this->prepare()) {
+		auto ok = this->pipes.writeString(configDir.toStdString())
+		       && this->pipes.writeString(config.toStdString())
+		       && this->pipes.writeString(user.toStdString());
+
+		if (!ok) {
+			qCCritical(logPam) << "Failed to send pam configuration to helper.";
+			this->internalError();
+			return;
+		}
+
+		qCDebug(logPam) << "Started authentication in" << (prepared ? "prepared" : "new")
+		                << "pam helper after" << this->startTimer.elapsed() << "ms";
+	} else {
+		this->childPid = PamConversation::createSubprocess(&this->pipes, configDir, config, user);
+		if (this->childPid == 0) {
+			qCCritical(logPam) << "Failed to create pam subprocess.";
+			emit this->error(PamError::InternalError);
+			return;
+		}
 	}
 
+	this->responseTimer.start();
 	QObject::connect(&this->notifier, &QSocketNotifier::activated, this, &PamConversation::onMessage);
 	this->notifier.setSocket(this->pipes.fdIn);
 	this->notifier.setEnabled(true);
@@ -52,6 +187,7 @@ void PamConversation::abort() {
 		kill(this->childPid, SIGKILL); // NOLINT (include)
 		waitpid(this->childPid, nullptr, 0);
 		this->childPid = 0;
+		this->helperRunning = false;
 	}
 }
 
@@ -61,12 +197,70 @@ void PamConversation::internalError() {
 		kill(this->childPid, SIGKILL); // NOLINT (include)
 		waitpid(this->childPid, nullptr, 0);
 		this->childPid = 0;
+		this->helperRunning = false;
 		emit this->error(PamError::InternalError);
 	}
 }
 
+pid_t PamConversation::createSubprocess(
+    PamIpcPipes* pipes,
+    const QString& configDir,
+    const QString& config,
+    const QString& user
+) {
+	auto toSubprocess = std::array<int, 2>();
+	auto fromSubprocess = std::array<int, 2>();
+
+	if (pipe(toSubprocess.data()) == -1 || pipe(fromSubprocess.data()) == -1) {
+		qCDebug(logPam) << "Failed to create pipes for subprocess.";
+		return 0;
+	}
+
+	auto* configDirF = strdup(configDir.toStdString().c_str()); // NOLINT (include)
+	auto* configF = strdup(config.toStdString().c_str());       // NOLINT (include)
+	auto* userF = strdup(user.toStdString().c_str());           // NOLINT (include)
+	auto log = logPam().isDebugEnabled();
+
+	auto pid = fork();
+
+	if (pid < 0) {
+		qCDebug(logPam) << "Failed to fork for subprocess.";
+	} else if (pid == 0) {
+		close(toSubprocess[1]);   // close w
+		close(fromSubprocess[0]); // close r
+
+		{
+			auto subprocess = PamSubprocess(log, toSubprocess[0], fromSubprocess[1]);
+			auto code = subprocess.exec(configDirF, configF, userF);
+			subprocess.sendCode(code);
+		}
+
+		free(configDirF); // NOLINT
+		free(configF);    // NOLINT
+		free(userF);      // NOLINT
+
+		// do not do cleanup that may affect the parent
+		_exit(0);
+	} else {
+		close(toSubprocess[0]);   // close r
+		close(fromSubprocess[1]); // close w
+
+		pipes->fdIn = fromSubprocess[0];
+		pipes->fdOut = toSubprocess[1];
+
+		free(configDirF); // NOLINT
+		free(configF);    // NOLINT
+		free(userF);      // NOLINT
+
+		return pid;
+	}
+
+	return -1; // should never happen but lint
+}
+
 void PamConversation::respond(const QString& response) {
 	qCDebug(logPam) << "Sending response for" << this;
+	this->responseTimer.start();
 	if (!this->pipes.writeString(response.toStdString())) {
 		qCCritical(logPam) << "Failed to write response to subprocess.";
 		this->internalError();
@@ -90,7 +284,9 @@ void PamConversation::onMessage() {
 
 			if (!ok) goto fail;
 
-			qCDebug(logPam) << "Subprocess exited with code" << static_cast<int>(code);
+			qCDebug(logPam) << "Subprocess exited with code" << static_cast<int>(code) << "after"
+			                << this->responseTimer.elapsed() << "ms since the last response,"
+			                << this->startTimer.elapsed() << "ms since start";
 
 			switch (code) {
 			case PamIpcExitCode::Success: emit this->completed(PamResult::Success); break;
@@ -103,6 +299,7 @@ void PamConversation::onMessage() {
 
 			waitpid(this->childPid, nullptr, 0);
 			this->childPid = 0;
+			this->helperRunning = false;
 		} else if (type == PamIpcEvent::Request) {
 			PamIpcRequestFlags flags {};
 
@@ -114,6 +311,7 @@ void PamConversation::onMessage() {
 
 			if (!ok) goto fail;
 
+			qCDebug(logPam) << "Got pam message after" << this->startTimer.elapsed() << "ms";
 			this->message(QString::fromUtf8(message), flags.error, flags.responseRequired, flags.echo);
 		} else {
 			qCCritical(logPam) << "Unexpected message from subprocess.";
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <qelapsedtimer.h>
 #include <qloggingcategory.h>
 #include <qobject.h>
 #include <qqmlintegration.h>
@@ -61,6 +62,10 @@ public:
 // meaning aborts for things like fingerprint scanners
 // and hardware keys don't actually work without aborting the process...
 // so we have a subprocess.
+//
+// The subprocess is the quickshell-pam-helper executable, which can be started ahead of time
+// with prepare() so an authentication does not wait for it. If the helper is not installed,
+// quickshell is forked instead.
 class PamConversation: public QObject {
 	Q_OBJECT;
 
@@ -70,6 +75,8 @@ public:
 	Q_DISABLE_COPY_MOVE(PamConversation);
 
 public:
+	// Starts the helper process if it is not already running. Returns false if it is not available.
+	bool prepare();
 	void start(const QString& configDir, const QString& config, const QString& user);
 
 	void abort();
@@ -91,9 +98,15 @@ private:
 	    const QString& user
 	);
 
+	static pid_t spawnHelper(PamIpcPipes* pipes);
+	static const QString& helperPath();
+
 	void internalError();
 
 	pid_t childPid = 0;
+	bool helperRunning = false;
 	PamIpcPipes pipes;
 	QSocketNotifier notifier {QSocketNotifier::Read};
+	QElapsedTimer startTimer;
+	QElapsedTimer responseTimer;
 };
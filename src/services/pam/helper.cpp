@@ -0,0 +1,17 @@
+#include <cstring>
+
+#include "subprocess.hpp"
+
+// Started ahead of time by PamConversation so an authentication does not have to fork
+// quickshell, which copies its whole address space. Performs a single authentication
+// over the pipes it was started with, then exits.
+int main(int argc, char** argv) {
+	auto log = argc > 1 && strcmp(argv[1], "--log") == 0; // NOLINT
+
+	auto subprocess =
+	    PamSubprocess(log, PamSubprocess::HELPER_FD_IN, PamSubprocess::HELPER_FD_OUT);
+
+	auto code = subprocess.execFromParent();
+	subprocess.sendCode(code);
+	return 0;
+}
@@ -4,8 +4,6 @@
 #include <cstdint>
 #include <string>
 
-#include <qtclasshelpermacros.h>
-
 enum class PamIpcEvent : uint8_t {
 	Request,
 	Exit,
@@ -31,7 +29,12 @@ public:
 	explicit PamIpcPipes() = default;
 	explicit PamIpcPipes(int fdIn, int fdOut): fdIn(fdIn), fdOut(fdOut) {}
 	~PamIpcPipes();
-	Q_DISABLE_COPY_MOVE(PamIpcPipes);
+
+	// Q_DISABLE_COPY_MOVE is not used as quickshell-pam-helper does not use Qt.
+	PamIpcPipes(const PamIpcPipes&) = delete;
+	PamIpcPipes(PamIpcPipes&&) = delete;
+	PamIpcPipes& operator=(const PamIpcPipes&) = delete;
+	PamIpcPipes& operator=(PamIpcPipes&&) = delete;
 
 	[[nodiscard]] bool readBytes(char* buffer, size_t length) const;
 	[[nodiscard]] bool writeBytes(const char* buffer, size_t length) const;
@@ -18,6 +18,20 @@ void PamContext::componentComplete() {
 
 	if (this->mTargetActive) {
 		this->startConversation();
+	} else {
+		this->prepareConversation();
+	}
+}
+
+void PamContext::prepareConversation() {
+	if (this->preparedConversation != nullptr) return;
+
+	auto* conversation = new PamConversation(this);
+
+	if (conversation->prepare()) {
+		this->preparedConversation = conversation;
+	} else {
+		delete conversation;
 	}
 }
 
@@ -85,7 +99,13 @@ void PamContext::startConversation() {
 		}
 	}
 
-	this->conversation = new PamConversation(this);
+	if (this->preparedConversation != nullptr) {
+		this->conversation = this->preparedConversation;
+		this->preparedConversation = nullptr;
+	} else {
+		this->conversation = new PamConversation(this);
+	}
+
 	QObject::connect(this->conversation, &PamConversation::completed, this, &PamContext::onCompleted);
 	QObject::connect(this->conversation, &PamConversation::error, this, &PamContext::onError);
 	QObject::connect(this->conversation, &PamConversation::message, this, &PamContext::onMessage);
@@ -102,6 +122,9 @@ void PamContext::abortConversation() {
 	this->conversation = nullptr;
 	emit this->activeChanged();
 
+	// the helper exits after a single authentication
+	this->prepareConversation();
+
 	if (!this->mMessage.isEmpty()) {
 		this->mMessage.clear();
 		emit this->messageChanged();
@@ -13,6 +13,9 @@
 
 ///! Connection to pam.
 /// Connection to pam. See [the module documentation](../) for pam configuration advice.
+///
+/// Authentication runs in a small helper process, which is started when the context is
+/// created and again after each authentication, so starting one does not have to wait for it.
 class PamContext
     : public QObject
     , public QQmlParserStatus {
@@ -115,7 +118,11 @@ private slots:
 	void onMessage(QString message, bool isError, bool responseRequired, bool responseVisible);
 
 private:
+	void prepareConversation();
+
 	PamConversation* conversation = nullptr;
+	// conversation with a running helper, waiting to be started
+	PamConversation* preparedConversation = nullptr;
 
 	bool postInit = false;
 	bool mTargetActive = false;
@@ -1,73 +1,27 @@
 #include "subprocess.hpp"
-#include <array>
+#include <cstdlib>
+#include <cstring>
 #include <ostream>
 #include <string>
 
-#include <qlogging.h>
-#include <qloggingcategory.h>
-#include <qstring.h>
-#include <sched.h>
 #include <security/_pam_types.h>
 #include <security/pam_appl.h>
 #include <unistd.h>
 
-#include "conversation.hpp"
 #include "ipc.hpp"
 
-pid_t PamConversation::createSubprocess(
-    PamIpcPipes* pipes,
-    const QString& configDir,
-    const QString& config,
-    const QString& user
-) {
-	auto toSubprocess = std::array<int, 2>();
-	auto fromSubprocess = std::array<int, 2>();
-
-	if (pipe(toSubprocess.data()) == -1 || pipe(fromSubprocess.data()) == -1) {
-		qCDebug(logPam) << "Failed to create pipes for subprocess.";
-		return 0;
-	}
-
-	auto* configDirF = strdup(configDir.toStdString().c_str()); // NOLINT (include)
-	auto* configF = strdup(config.toStdString().c_str());       // NOLINT (include)
-	auto* userF = strdup(user.toStdString().c_str());           // NOLINT (include)
-	auto log = logPam().isDebugEnabled();
+PamIpcExitCode PamSubprocess::execFromParent() {
+	logIf(this->log) << "Waiting for pam configuration from parent..." << std::endl;
 
-	auto pid = fork();
-
-	if (pid < 0) {
-		qCDebug(logPam) << "Failed to fork for subprocess.";
-	} else if (pid == 0) {
-		close(toSubprocess[1]);   // close w
-		close(fromSubprocess[0]); // close r
-
-		{
-			auto subprocess = PamSubprocess(log, toSubprocess[0], fromSubprocess[1]);
-			auto code = subprocess.exec(configDirF, configF, userF);
-			subprocess.sendCode(code);
-		}
-
-		free(configDirF); // NOLINT
-		free(configF);    // NOLINT
-		free(userF);      // NOLINT
-
-		// do not do cleanup that may affect the parent
-		_exit(0);
-	} else {
-		close(toSubprocess[0]);   // close r
-		close(fromSubprocess[1]); // close w
-
-		pipes->fdIn = fromSubprocess[0];
-		pipes->fdOut = toSubprocess[1];
-
-		free(configDirF); // NOLINT
-		free(configF);    // NOLINT
-		free(userF);      // NOLINT
-
-		return pid;
-	}
+	auto ok = false;
+	auto configDir = this->pipes.readString(&ok);
+	if (!ok) return PamIpcExitCode::OtherError;
+	auto config = this->pipes.readString(&ok);
+	if (!ok) return PamIpcExitCode::OtherError;
+	auto user = this->pipes.readString(&ok);
+	if (!ok) return PamIpcExitCode::OtherError;
 
-	return -1; // should never happen but lint
+	return this->exec(configDir.c_str(), config.c_str(), user.c_str());
 }
 
 PamIpcExitCode PamSubprocess::exec(const char* configDir, const char* config, const char* user) {
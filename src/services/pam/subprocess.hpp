@@ -12,10 +12,18 @@
 	if (log) std::cout << "quickshell.service.pam.subprocess: "
 // NOLINTEND
 
+// The authentication side of a PamConversation, either in a fork of quickshell or
+// in quickshell-pam-helper. Must not use Qt, as the helper does not link it.
 class PamSubprocess {
 public:
+	// Pipe fds the helper is started with.
+	static constexpr int HELPER_FD_IN = 3;
+	static constexpr int HELPER_FD_OUT = 4;
+
 	explicit PamSubprocess(bool log, int fdIn, int fdOut): log(log), pipes(fdIn, fdOut) {}
 	PamIpcExitCode exec(const char* configDir, const char* config, const char* user);
+	// Reads the config dir, config and user from the parent, then runs exec.
+	PamIpcExitCode execFromParent();
 	void sendCode(PamIpcExitCode code);
 
 private:
@@ -16,6 +16,7 @@
 #include <libdrm/drm_fourcc.h>
 #include <qcontainerfwd.h>
 #include <qdebug.h>
+#include <qimage.h>
 #include <qlist.h>
 #include <qlogging.h>
 #include <qloggingcategory.h>
@@ -529,6 +530,56 @@ bool WlDmaBuffer::isCompatible(const WlBufferRequest& request) const {
 	return matchingFormat != request.dmabuf.formats.end();
 }
 
+QImage WlDmaBuffer::toImage() const {
+	auto imageFormat = QImage::Format_Invalid;
+
+	// Qt's 32 bit formats are native endian, drm formats are little endian.
+	switch (this->format) {
+	case DRM_FORMAT_XRGB8888: imageFormat = QImage::Format_RGB32; break;
+	case DRM_FORMAT_ARGB8888: imageFormat = QImage::Format_ARGB32_Premultiplied; break;
+	case DRM_FORMAT_XBGR8888: imageFormat = QImage::Format_RGBX8888; break;
+	case DRM_FORMAT_ABGR8888: imageFormat = QImage::Format_RGBA8888_Premultiplied; break;
+	case DRM_FORMAT_XRGB2101010: imageFormat = QImage::Format_RGB30; break;
+	case DRM_FORMAT_ARGB2101010: imageFormat = QImage::Format_A2RGB30_Premultiplied; break;
+	case DRM_FORMAT_XBGR2101010: imageFormat = QImage::Format_BGR30; break;
+	case DRM_FORMAT_ABGR2101010: imageFormat = QImage::Format_A2BGR30_Premultiplied; break;
+	default:
+		qCWarning(logDmabuf) << "Cannot read" << this << "as its format has no matching image format.";
+		return QImage();
+	}
+
+	uint32_t stride = 0;
+	void* mapData = nullptr;
+
+	auto* data = gbm_bo_map(
+	    this->bo,
+	    0,
+	    0,
+	    this->width,
+	    this->height,
+	    GBM_BO_TRANSFER_READ,
+	    &stride,
+	    &mapData
+	);
+
+	if (!data) {
+		qCWarning(logDmabuf) << "Failed to map" << this << "for reading.";
+		return QImage();
+	}
+
+	auto mapped = QImage(
+	    static_cast<const uchar*>(data),
+	    static_cast<int>(this->width),
+	    static_cast<int>(this->height),
+	    static_cast<qsizetype>(stride),
+	    imageFormat
+	);
+
+	auto image = mapped.copy();
+	gbm_bo_unmap(this->bo, mapData);
+	return image;
+}
+
 WlBufferQSGTexture* WlDmaBuffer::createQsgTexture(QQuickWindow* window) const {
 	static auto* glEGLImageTargetTexture2DOES = []() {
 		auto* fn = reinterpret_cast<PFNGLEGLIMAGETARGETTEXTURE2DOESPROC>(
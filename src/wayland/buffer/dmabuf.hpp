@@ -6,6 +6,7 @@
 #include <gbm.h>
 #include <qcontainerfwd.h>
 #include <qhash.h>
+#include <qimage.h>
 #include <qlist.h>
 #include <qquickwindow.h>
 #include <qsgtexture.h>
@@ -128,6 +129,8 @@ public:
 	}
 
 	[[nodiscard]] bool isCompatible(const WlBufferRequest& request) const override;
+	// Maps the bo through gbm, which may need a detiling copy by the driver.
+	[[nodiscard]] QImage toImage() const override;
 	[[nodiscard]] WlBufferQSGTexture* createQsgTexture(QQuickWindow* window) const override;
 
 private:
@@ -6,6 +6,7 @@
 #include <qmatrix4x4.h>
 #include <qnamespace.h>
 #include <qquickwindow.h>
+#include <qsgnode.h>
 #include <qtenvironmentvariables.h>
 #include <qtmetamacros.h>
 #include <qvectornd.h>
@@ -24,7 +25,8 @@ Q_LOGGING_CATEGORY(logBuffer, "quickshell.wayland.buffer", QtWarningMsg);
 WlBuffer* WlBufferSwapchain::createBackbuffer(const WlBufferRequest& request, bool* newBuffer) {
 	auto& buffer = this->presentSecondBuffer ? this->buffer1 : this->buffer2;
 
-	if (!buffer || !buffer->isCompatible(request)) {
+	// A locked buffer is still being read elsewhere, and is freed once its last reference is dropped.
+	if (!buffer || buffer.use_count() > 1 || !buffer->isCompatible(request)) {
 		buffer.reset(WlBufferManager::instance()->createBuffer(request));
 		if (newBuffer) *newBuffer = true;
 	}
@@ -118,6 +120,8 @@ void WlBufferQSGDisplayNode::syncSwapchain(const WlBufferSwapchain& swapchain) {
 	auto* buffer = swapchain.frontbuffer();
 	auto& texture = swapchain.presentSecondBuffer ? this->buffer2 : this->buffer1;
 
+	if (!buffer->isPresentable()) return;
+
 	if (swapchain.presentSecondBuffer == this->presentSecondBuffer && texture.first == buffer) {
 		return;
 	}
@@ -132,6 +136,8 @@ void WlBufferQSGDisplayNode::syncSwapchain(const WlBufferSwapchain& swapchain) {
 	}
 
 	this->imageNode->setTexture(texture.second->texture());
+	// Textures may be updated in place, which setTexture does not pick up.
+	this->imageNode->markDirty(QSGNode::DirtyMaterial);
 }
 
 } // namespace qs::wayland::buffer
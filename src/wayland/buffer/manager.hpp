@@ -4,6 +4,7 @@
 #include <memory>
 
 #include <qhash.h>
+#include <qimage.h>
 #include <qlist.h>
 #include <qmatrix4x4.h>
 #include <qobject.h>
@@ -79,9 +80,17 @@ public:
 	[[nodiscard]] virtual bool isCompatible(const WlBufferRequest& request) const = 0;
 	[[nodiscard]] operator bool() const { return this->buffer(); }
 
+	// Copies the buffer contents into an image, ignoring the transform.
+	// Returns a null image if the buffer cannot be read.
+	[[nodiscard]] virtual QImage toImage() const = 0;
+
 	// Must be called from render thread.
 	[[nodiscard]] virtual WlBufferQSGTexture* createQsgTexture(QQuickWindow* window) const = 0;
 
+	// If false, the buffer's contents are not ready to be displayed yet, and display nodes
+	// keep showing the previously presented buffer.
+	[[nodiscard]] virtual bool isPresentable() const { return true; }
+
 	WlBufferTransform transform;
 
 protected:
@@ -103,9 +112,16 @@ public:
 		return this->presentSecondBuffer ? this->buffer2.get() : this->buffer1.get();
 	}
 
+	// Takes the frontbuffer out of rotation until the returned reference is released, so it can
+	// be read from another thread. Captures will allocate a new backbuffer instead of writing
+	// into it. The reference must be released on the thread the swapchain lives on.
+	[[nodiscard]] std::shared_ptr<WlBuffer> lockFrontbuffer() const {
+		return this->presentSecondBuffer ? this->buffer2 : this->buffer1;
+	}
+
 private:
-	std::unique_ptr<WlBuffer> buffer1;
-	std::unique_ptr<WlBuffer> buffer2;
+	std::shared_ptr<WlBuffer> buffer1;
+	std::shared_ptr<WlBuffer> buffer2;
 	bool presentSecondBuffer = false;
 
 	friend class WlBufferQSGDisplayNode;
@@ -1,6 +1,9 @@
 #include "shm.hpp"
 #include <algorithm>
 #include <memory>
+#include <utility>
+
+#include <GLES3/gl32.h>
 
 #include <private/qwaylanddisplay_p.h>
 #include <private/qwaylandintegration_p.h>
@@ -9,8 +12,16 @@
 #include <qdebug.h>
 #include <qlogging.h>
 #include <qloggingcategory.h>
+#include <qimage.h>
+#include <qnamespace.h>
+#include <qobject.h>
+#include <qopenglcontext.h>
 #include <qquickwindow.h>
+#include <qrect.h>
+#include <qregion.h>
+#include <qsgtexture_platform.h>
 #include <qsize.h>
+#include <qthreadpool.h>
 #include <wayland-client-protocol.h>
 
 #include "manager.hpp"
@@ -57,16 +68,170 @@ WlBufferQSGTexture* WlShmBuffer::createQsgTexture(QQuickWindow* window) const {
 	// in the render thread.
 	texture->shmBuffer = this->shmBuffer;
 
-	texture->qsgTexture.reset(window->createTextureFromImage(*this->shmBuffer->image()));
 	texture->sync(this, window);
 	return texture;
 }
 
-void WlShmBufferQSGTexture::sync(const WlBuffer* /*unused*/, QQuickWindow* window) {
-	// This is both dumb and expensive. We should use an RHI texture and render images into
-	// it more intelligently, but shm buffers are already a horribly slow fallback path,
-	// to the point where it barely matters.
-	this->qsgTexture.reset(window->createTextureFromImage(*this->shmBuffer->image()));
+WlShmBufferQSGTexture::~WlShmBufferQSGTexture() {
+	this->qsgTexture.reset();
+	if (this->glTexture) glDeleteTextures(1, &this->glTexture);
+}
+
+void WlShmBufferQSGTexture::sync(const WlBuffer* buffer, QQuickWindow* window) {
+	const auto* shmBuffer = static_cast<const WlShmBuffer*>(buffer); // NOLINT
+	auto damage = std::exchange(shmBuffer->textureDamage, QRegion());
+
+	// Damage is in buffer coordinates, so scaled images are always replaced whole.
+	if (!shmBuffer->scaledImage.isNull()) {
+		this->setTexture(window->createTextureFromImage(shmBuffer->scaledImage));
+	} else if (QOpenGLContext::currentContext()) {
+		this->uploadGl(*this->shmBuffer->image(), damage, window);
+	} else {
+		// Other graphics APIs get a new texture for every frame. This is both dumb and expensive,
+		// but shm buffers are already a horribly slow fallback path, to the point where it
+		// barely matters.
+		this->setTexture(window->createTextureFromImage(*this->shmBuffer->image()));
+	}
+}
+
+void WlShmBufferQSGTexture::setTexture(QSGTexture* texture) {
+	this->qsgTexture.reset(texture);
+
+	if (this->glTexture) {
+		glDeleteTextures(1, &this->glTexture);
+		this->glTexture = 0;
+	}
+}
+
+void WlShmBufferQSGTexture::uploadGl(
+    const QImage& image,
+    const QRegion& damage,
+    QQuickWindow* window
+) {
+	// Texture data must be in a format GLES can upload without extensions.
+	auto upload = [](const QImage& image, QRect rect, bool full) {
+		auto data = (full ? image : image.copy(rect))
+		                .convertToFormat(QImage::Format_RGBA8888_Premultiplied);
+
+		if (full) {
+			glTexImage2D(
+			    GL_TEXTURE_2D,
+			    0,
+			    GL_RGBA8,
+			    rect.width(),
+			    rect.height(),
+			    0,
+			    GL_RGBA,
+			    GL_UNSIGNED_BYTE,
+			    data.constBits()
+			);
+		} else {
+			glTexSubImage2D(
+			    GL_TEXTURE_2D,
+			    0,
+			    rect.x(),
+			    rect.y(),
+			    rect.width(),
+			    rect.height(),
+			    GL_RGBA,
+			    GL_UNSIGNED_BYTE,
+			    data.constBits()
+			);
+		}
+	};
+
+	auto recreate = !this->glTexture || this->glTextureSize != image.size();
+	if (!recreate && damage.isEmpty()) return;
+
+	window->beginExternalCommands();
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+	if (recreate) {
+		this->setTexture(nullptr);
+
+		glGenTextures(1, &this->glTexture);
+		glBindTexture(GL_TEXTURE_2D, this->glTexture);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+		upload(image, image.rect(), true);
+
+		this->glTextureSize = image.size();
+		this->qsgTexture.reset(QNativeInterface::QSGOpenGLTexture::fromNative(
+		    this->glTexture,
+		    window,
+		    image.size(),
+		    image.hasAlphaChannel() ? QQuickWindow::TextureHasAlphaChannel
+		                            : QQuickWindow::CreateTextureOptions()
+		));
+
+		qCDebug(logShm) << "Uploaded full shm texture of size" << image.size();
+	} else {
+		glBindTexture(GL_TEXTURE_2D, this->glTexture);
+
+		for (const auto& rect: damage.intersected(image.rect())) {
+			upload(image, rect, false);
+		}
+
+		qCDebug(logShm) << "Uploaded damaged regions of shm texture:" << damage;
+	}
+
+	glBindTexture(GL_TEXTURE_2D, 0);
+	window->endExternalCommands();
+}
+
+WlShmBufferScaler::WlShmBufferScaler(WlShmBuffer* buffer, QSize size)
+    : buffer(buffer)
+    , shmBuffer(buffer->shmBuffer)
+    , size(size) {
+	this->setAutoDelete(false);
+}
+
+WlShmBufferScaler* WlShmBufferScaler::start(WlShmBuffer* buffer, QSize size) {
+	// A single thread shared by every scaler keeps scaling from competing with the
+	// rest of the shell for cores.
+	static auto* pool = [] {
+		auto* pool = new QThreadPool();
+		pool->setObjectName("quickshell-shm-scaler");
+		pool->setMaxThreadCount(1);
+		return pool;
+	}();
+
+	auto* scaler = new WlShmBufferScaler(buffer, size);
+	buffer->scalePending = true;
+	pool->start(scaler);
+	return scaler;
+}
+
+void WlShmBufferScaler::run() {
+	if (!this->shouldCancel.loadAcquire()) {
+		this->result = this->shmBuffer->image()->scaled(
+		    this->size,
+		    Qt::KeepAspectRatio,
+		    Qt::SmoothTransformation
+		);
+	}
+
+	QMetaObject::invokeMethod(this, &WlShmBufferScaler::finished, Qt::QueuedConnection);
+}
+
+void WlShmBufferScaler::tryCancel() {
+	if (this->shouldCancel.loadAcquire()) return;
+
+	this->shouldCancel.storeRelease(true);
+	this->buffer->scalePending = false;
+}
+
+void WlShmBufferScaler::finished() {
+	if (!this->shouldCancel.loadAcquire()) {
+		qCDebug(logShm) << "Scaled" << this->buffer << "to" << this->result.size();
+		this->buffer->scaledImage = this->result;
+		this->buffer->scalePending = false;
+		emit this->done();
+	}
+
+	this->deleteLater();
 }
 
 WlBuffer* ShmbufManager::createShmbuf(const WlBufferRequest& request) {
@@ -3,10 +3,16 @@
 #include <memory>
 
 #include <private/qwaylandshmbackingstore_p.h>
+#include <qatomic.h>
+#include <qimage.h>
+#include <qobject.h>
 #include <qquickwindow.h>
+#include <qregion.h>
+#include <qrunnable.h>
 #include <qsgtexture.h>
 #include <qsize.h>
 #include <qtclasshelpermacros.h>
+#include <qtmetamacros.h>
 #include <wayland-client-protocol.h>
 
 #include "manager.hpp"
@@ -22,7 +28,17 @@ public:
 	[[nodiscard]] wl_buffer* buffer() const override { return this->shmBuffer->buffer(); }
 	[[nodiscard]] QSize size() const override { return this->shmBuffer->size(); }
 	[[nodiscard]] bool isCompatible(const WlBufferRequest& request) const override;
+	[[nodiscard]] QImage toImage() const override { return this->shmBuffer->image()->copy(); }
 	[[nodiscard]] WlBufferQSGTexture* createQsgTexture(QQuickWindow* window) const override;
+	// Not presentable while being scaled, so the full size buffer is never uploaded.
+	[[nodiscard]] bool isPresentable() const override { return !this->scalePending; }
+
+	// Drops the image set by WlShmBufferScaler. Must be called whenever the buffer is written to.
+	void clearScaledImage() { this->scaledImage = QImage(); }
+
+	// Marks a region of the buffer as changed, limiting the next texture sync to the
+	// changed regions.
+	void addDamage(const QRegion& damage) { this->textureDamage += damage; }
 
 private:
 	WlShmBuffer(QtWaylandClient::QWaylandShmBuffer* shmBuffer, uint32_t format)
@@ -31,8 +47,14 @@ private:
 
 	std::shared_ptr<QtWaylandClient::QWaylandShmBuffer> shmBuffer;
 	uint32_t format;
+	// Uploaded in place of the buffer contents if set.
+	QImage scaledImage;
+	bool scalePending = false;
+	// Changed regions not yet uploaded. Consumed from the render thread during sync.
+	mutable QRegion textureDamage;
 
 	friend class WlShmBufferQSGTexture;
+	friend class WlShmBufferScaler;
 	friend class ShmbufManager;
 	friend QDebug& operator<<(QDebug& debug, const WlShmBuffer* buffer);
 };
@@ -41,18 +63,60 @@ QDebug& operator<<(QDebug& debug, const WlShmBuffer* buffer);
 
 class WlShmBufferQSGTexture: public WlBufferQSGTexture {
 public:
+	~WlShmBufferQSGTexture() override;
+	Q_DISABLE_COPY_MOVE(WlShmBufferQSGTexture);
+
 	[[nodiscard]] QSGTexture* texture() const override { return this->qsgTexture.get(); }
 	void sync(const WlBuffer* buffer, QQuickWindow* window) override;
 
 private:
 	WlShmBufferQSGTexture() = default;
 
+	void setTexture(QSGTexture* texture);
+	void uploadGl(const QImage& image, const QRegion& damage, QQuickWindow* window);
+
 	std::shared_ptr<QtWaylandClient::QWaylandShmBuffer> shmBuffer;
 	std::unique_ptr<QSGTexture> qsgTexture;
+	// Only used when rendering with OpenGL, which allows partial uploads.
+	GLuint glTexture = 0;
+	QSize glTextureSize;
 
 	friend class WlShmBuffer;
 };
 
+// Scales the contents of a shm buffer down on a shared worker thread, so textures created
+// from it afterwards upload the smaller image instead of the full buffer.
+class WlShmBufferScaler
+    : public QObject
+    , public QRunnable {
+	Q_OBJECT;
+
+public:
+	// Starts scaling buffer to fit within size. The buffer must not be written to or destroyed
+	// until `done` is emitted or the scaler is cancelled.
+	static WlShmBufferScaler* start(WlShmBuffer* buffer, QSize size);
+
+	void run() override;
+	// Prevents the scaled image from being applied, leaving the buffer presentable at full size.
+	// The scaler deletes itself once the worker is finished with it.
+	void tryCancel();
+
+signals:
+	void done();
+
+private slots:
+	void finished();
+
+private:
+	WlShmBufferScaler(WlShmBuffer* buffer, QSize size);
+
+	QAtomicInteger<bool> shouldCancel = false;
+	WlShmBuffer* buffer;
+	std::shared_ptr<QtWaylandClient::QWaylandShmBuffer> shmBuffer;
+	QSize size;
+	QImage result;
+};
+
 class ShmbufManager {
 public:
 	[[nodiscard]] static WlBuffer* createShmbuf(const WlBufferRequest& request);
@@ -422,6 +422,7 @@ void HyprlandIpc::refreshWorkspaces(bool canCreate) {
 		auto json = QJsonDocument::fromJson(resp).array();
 
 		const auto& mList = this->mWorkspaces.valueList();
+		auto batch = UntypedObjectModel::UpdateBatch(&this->mWorkspaces);
 		auto ids = QVector<quint32>();
 
 		for (auto entry: json) {
@@ -543,6 +544,7 @@ void HyprlandIpc::refreshMonitors(bool canCreate) {
 		auto json = QJsonDocument::fromJson(resp).array();
 
 		const auto& mList = this->mMonitors.valueList();
+		auto batch = UntypedObjectModel::UpdateBatch(&this->mMonitors);
 		auto names = QVector<QString>();
 
 		for (auto entry: json) {
@@ -38,6 +38,10 @@ void HyprlandSurface::setVisibleRegion(const QRegion& region) {
 		return;
 	}
 
+	if (this->visibleRegionSet && region == this->mVisibleRegion) return;
+	this->mVisibleRegion = region;
+	this->visibleRegionSet = true;
+
 	if (region.isEmpty()) {
 		this->set_visible_region(nullptr);
 	} else {
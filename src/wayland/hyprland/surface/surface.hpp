@@ -26,6 +26,8 @@ public:
 private:
 	QtWaylandClient::QWaylandWindow* backer;
 	wl_surface* backerSurface = nullptr;
+	QRegion mVisibleRegion;
+	bool visibleRegionSet = false;
 };
 
 } // namespace qs::hyprland::surface::impl
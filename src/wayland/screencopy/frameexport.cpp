@@ -0,0 +1,136 @@
+#include "frameexport.hpp"
+#include <memory>
+#include <utility>
+
+#include <qbuffer.h>
+#include <qbytearray.h>
+#include <qfileinfo.h>
+#include <qimage.h>
+#include <qimagewriter.h>
+#include <qlogging.h>
+#include <qloggingcategory.h>
+#include <qnamespace.h>
+#include <qobject.h>
+#include <qrect.h>
+#include <qsavefile.h>
+#include <qstring.h>
+#include <qtransform.h>
+
+#include "../../core/qoi.hpp"
+#include "../buffer/manager.hpp"
+
+namespace qs::wayland::screencopy {
+
+namespace {
+Q_LOGGING_CATEGORY(logFrameExport, "quickshell.wayland.screencopy.export", QtWarningMsg);
+}
+
+FrameExportOperation::FrameExportOperation(
+    std::shared_ptr<buffer::WlBuffer> buffer,
+    buffer::WlBufferTransform transform,
+    QRect region,
+    Format format,
+    QString path
+)
+    : buffer(std::move(buffer))
+    , transform(transform)
+    , region(region)
+    , format(format)
+    , path(std::move(path)) {
+	this->setAutoDelete(false);
+}
+
+bool FrameExportOperation::parseFormat(const QString& name, const QString& path, Format* format) {
+	auto formatName = name.isEmpty() ? QFileInfo(path).suffix().toLower() : name.toLower();
+
+	if (formatName.isEmpty() || formatName == "png") *format = Format::Png;
+	else if (formatName == "qoi") *format = Format::Qoi;
+	else if (formatName == "webp") *format = Format::WebP;
+	else return false;
+
+	return true;
+}
+
+void FrameExportOperation::run() {
+	if (!this->shouldCancel.loadAcquire()) this->exportFrame();
+	QMetaObject::invokeMethod(this, &FrameExportOperation::finished, Qt::QueuedConnection);
+}
+
+void FrameExportOperation::exportFrame() {
+	// Mapping a dmabuf may involve a detiling blit and a full copy, so it is done here
+	// instead of on the gui thread.
+	this->image = this->buffer->toImage();
+
+	if (this->image.isNull()) {
+		this->error = "The captured buffer could not be read.";
+		return;
+	}
+
+	if (this->shouldCancel.loadAcquire()) return;
+
+	// Matches the orientation applied by WlBufferQSGDisplayNode.
+	if (auto degrees = this->transform.degrees(); degrees != 0) {
+		this->image = this->image.transformed(QTransform().rotate(degrees));
+	}
+
+	if (this->transform.flip()) this->image = this->image.mirrored(true, false);
+
+	if (this->region.isValid()) {
+		auto region = this->region.intersected(this->image.rect());
+
+		if (region.isEmpty()) {
+			this->error = "Export region is outside of the frame.";
+			return;
+		}
+
+		this->image = this->image.copy(region);
+	}
+
+	if (this->shouldCancel.loadAcquire()) return;
+
+	if (this->format == Format::Qoi) {
+		this->data = QoiEncoder::encode(this->image);
+	} else {
+		auto buffer = QBuffer(&this->data);
+		buffer.open(QBuffer::WriteOnly);
+
+		auto writer = QImageWriter(&buffer, this->format == Format::WebP ? "webp" : "png");
+
+		if (!writer.canWrite()) {
+			this->error = this->format == Format::WebP
+			                ? "WebP is not supported. Install the Qt image formats plugin to enable it."
+			                : writer.errorString();
+			return;
+		}
+
+		if (!writer.write(this->image)) {
+			this->error = writer.errorString();
+			return;
+		}
+	}
+
+	if (this->path.isEmpty() || this->shouldCancel.loadAcquire()) return;
+
+	auto file = QSaveFile(this->path);
+
+	if (!file.open(QSaveFile::WriteOnly) || file.write(this->data) != this->data.size()
+	    || !file.commit())
+	{
+		this->error = file.errorString();
+		return;
+	}
+
+	qCDebug(logFrameExport) << "Exported frame of size" << this->image.size() << "to" << this->path;
+	this->data.clear();
+}
+
+void FrameExportOperation::tryCancel() { this->shouldCancel.storeRelease(true); }
+
+void FrameExportOperation::finished() {
+	// Released here as buffers must be destroyed on the gui thread.
+	this->buffer.reset();
+	if (!this->shouldCancel.loadAcquire()) emit this->done(this->data, this->error);
+	this->deleteLater();
+}
+
+} // namespace qs::wayland::screencopy
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <memory>
+
+#include <qatomic.h>
+#include <qbytearray.h>
+#include <qimage.h>
+#include <qobject.h>
+#include <qrect.h>
+#include <qrunnable.h>
+#include <qstring.h>
+#include <qtmetamacros.h>
+#include <qtypes.h>
+
+#include "../buffer/manager.hpp"
+
+namespace qs::wayland::screencopy {
+
+// Reads, orients, crops and encodes a captured frame on a worker thread, then writes it to a
+// file if a path is given. The buffer is held locked until the operation finishes.
+class FrameExportOperation
+    : public QObject
+    , public QRunnable {
+	Q_OBJECT;
+
+public:
+	enum class Format : quint8 {
+		Png,
+		Qoi,
+		WebP,
+	};
+
+	explicit FrameExportOperation(
+	    std::shared_ptr<buffer::WlBuffer> buffer,
+	    buffer::WlBufferTransform transform,
+	    QRect region,
+	    Format format,
+	    QString path
+	);
+
+	void run() override;
+	void tryCancel();
+
+	// Finds the format matching name, or the suffix of path if name is empty.
+	// Defaults to png if neither is given. Returns false if the format is unknown.
+	static bool parseFormat(const QString& name, const QString& path, Format* format);
+
+signals:
+	// data is empty if the frame was written to a file. error is empty on success.
+	void done(const QByteArray& data, const QString& error);
+
+private slots:
+	void finished();
+
+private:
+	void exportFrame();
+
+	QAtomicInteger<bool> shouldCancel = false;
+	std::shared_ptr<buffer::WlBuffer> buffer;
+	QImage image;
+	buffer::WlBufferTransform transform;
+	QRect region;
+	Format format;
+	QString path;
+	QByteArray data;
+	QString error;
+};
+
+} // namespace qs::wayland::screencopy
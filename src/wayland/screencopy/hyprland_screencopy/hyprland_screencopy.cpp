@@ -4,6 +4,7 @@
 #include <qlogging.h>
 #include <qloggingcategory.h>
 #include <qobject.h>
+#include <qrect.h>
 #include <qtmetamacros.h>
 #include <qwaylandclientextension.h>
 #include <wayland-hyprland-toplevel-export-v1-client-protocol.h>
@@ -98,6 +99,20 @@ void HyprlandScreencopyContext::hyprland_toplevel_export_frame_v1_flags(uint32_t
 	}
 }
 
+void HyprlandScreencopyContext::hyprland_toplevel_export_frame_v1_damage(
+    uint32_t x,
+    uint32_t y,
+    uint32_t width,
+    uint32_t height
+) {
+	this->addDamage(QRect(
+	    static_cast<int>(x),
+	    static_cast<int>(y),
+	    static_cast<int>(width),
+	    static_cast<int>(height)
+	));
+}
+
 void HyprlandScreencopyContext::hyprland_toplevel_export_frame_v1_buffer_done() {
 	auto* backbuffer = this->mSwapchain.createBackbuffer(this->request);
 	this->copy(backbuffer->buffer(), this->copiedFirstFrame ? 0 : 1);
@@ -111,7 +126,7 @@ void HyprlandScreencopyContext::hyprland_toplevel_export_frame_v1_ready(
 	this->destroy();
 	this->copiedFirstFrame = true;
 	this->mSwapchain.swapBuffers();
-	emit this->frameCaptured();
+	this->frameReady();
 }
 
 void HyprlandScreencopyContext::hyprland_toplevel_export_frame_v1_failed() {
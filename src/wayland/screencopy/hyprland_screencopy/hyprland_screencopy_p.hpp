@@ -30,6 +30,7 @@ protected:
 	void hyprland_toplevel_export_frame_v1_buffer(uint32_t format, uint32_t width, uint32_t height, uint32_t stride) override;
 	void hyprland_toplevel_export_frame_v1_linux_dmabuf(uint32_t format, uint32_t width, uint32_t height) override;
 	void hyprland_toplevel_export_frame_v1_flags(uint32_t flags) override;
+	void hyprland_toplevel_export_frame_v1_damage(uint32_t x, uint32_t y, uint32_t width, uint32_t height) override;
 	void hyprland_toplevel_export_frame_v1_buffer_done() override;
 	void hyprland_toplevel_export_frame_v1_ready(uint32_t tvSecHi, uint32_t tvSecLo, uint32_t tvNsec) override;
 	void hyprland_toplevel_export_frame_v1_failed() override;
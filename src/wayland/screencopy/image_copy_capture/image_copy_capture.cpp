@@ -158,7 +158,9 @@ void IccScreencopyContext::ext_image_copy_capture_frame_v1_damage(
     int32_t width,
     int32_t height
 ) {
-	this->damage = this->damage.united(QRect(x, y, width, height));
+	auto rect = QRect(x, y, width, height);
+	this->damage = this->damage.united(rect);
+	this->addDamage(rect);
 }
 
 void IccScreencopyContext::ext_image_copy_capture_frame_v1_ready() {
@@ -168,7 +170,7 @@ void IccScreencopyContext::ext_image_copy_capture_frame_v1_ready() {
 	this->lastDamage = this->damage;
 	this->damage = QRect();
 
-	emit this->frameCaptured();
+	this->frameReady();
 }
 
 void IccScreencopyContext::ext_image_copy_capture_frame_v1_failed(uint32_t reason) {
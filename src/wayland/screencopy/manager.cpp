@@ -1,8 +1,17 @@
 #include "manager.hpp"
 
+#include <utility>
+
 #include <qobject.h>
+#include <qpoint.h>
+#include <qrect.h>
+#include <qregion.h>
+#include <qsize.h>
+#include <qtypes.h>
 
+#include "../buffer/shm.hpp"
 #include "build.hpp"
+#include "scheduler.hpp"
 
 #if SCREENCOPY_ICC || SCREENCOPY_WLR
 #include "../../core/qmlscreen.hpp"
@@ -23,6 +32,109 @@
 
 namespace qs::wayland::screencopy {
 
+ScreencopyContext::~ScreencopyContext() {
+	if (this->scaler) this->scaler->tryCancel();
+	ScreencopyScheduler::instance()->remove(this);
+}
+
+void ScreencopyContext::requestFrame() { ScreencopyScheduler::instance()->schedule(this); }
+
+void ScreencopyContext::setTargetSize(QSize targetSize) { this->mTargetSize = targetSize; }
+
+void ScreencopyContext::setMaxFramerate(qreal maxFramerate) {
+	if (maxFramerate == this->mMaxFramerate) return;
+	this->mMaxFramerate = maxFramerate;
+
+	// A higher limit may allow an already queued frame to start sooner.
+	ScreencopyScheduler::instance()->pump();
+}
+
+qint64 ScreencopyContext::captureDelay() const {
+	if (this->mMaxFramerate <= 0 || !this->lastCapture.isValid()) return 0;
+
+	auto interval = static_cast<qint64>(1000 / this->mMaxFramerate);
+	return interval - this->lastCapture.elapsed();
+}
+
+qint64 ScreencopyContext::captureCost() const {
+	// Unknown until the first frame is captured.
+	auto* frontbuffer = this->mSwapchain.frontbuffer();
+	if (!frontbuffer) return 0;
+
+	auto size = frontbuffer->size();
+	return static_cast<qint64>(size.width()) * size.height();
+}
+
+void ScreencopyContext::addDamage(const QRect& rect) {
+	this->pendingDamage += rect;
+	this->damageReported = true;
+}
+
+void ScreencopyContext::frameReady() {
+	if (this->scaler) {
+		this->scaler->tryCancel();
+		this->scaler = nullptr;
+	}
+
+	auto* frontbuffer = this->mSwapchain.frontbuffer();
+	auto* previous = this->mSwapchain.backbuffer();
+
+	auto damage = std::exchange(this->pendingDamage, QRegion());
+	if (!std::exchange(this->damageReported, false)) damage = QRect(QPoint(), frontbuffer->size());
+
+	// Keep presenting the previous buffer, leaving textures and the scene graph untouched.
+	// The new buffer becomes the backbuffer again, so the next capture cannot overwrite a
+	// buffer that is still being displayed.
+	if (damage.isEmpty() && this->hasFrame && previous && previous->size() == frontbuffer->size()) {
+		this->mSwapchain.swapBuffers();
+		emit this->frameUnchanged();
+		return;
+	}
+
+	this->mDamage = damage;
+	this->hasFrame = true;
+
+	// Textures created from the previous buffer are also missing this frame's changes
+	// once it is written to again.
+	if (auto* shmPrevious = dynamic_cast<buffer::shm::WlShmBuffer*>(previous)) {
+		shmPrevious->addDamage(damage);
+	}
+
+	if (auto* shmBuffer = dynamic_cast<buffer::shm::WlShmBuffer*>(frontbuffer)) {
+		shmBuffer->clearScaledImage();
+		shmBuffer->addDamage(damage);
+
+		auto targetSize = this->mTargetSize;
+		if (frontbuffer->transform.degrees() % 180 != 0) targetSize.transpose();
+
+		auto size = frontbuffer->size();
+		if (!targetSize.isEmpty()
+		    && (size.width() > targetSize.width() || size.height() > targetSize.height()))
+		{
+			this->scaler = buffer::shm::WlShmBufferScaler::start(shmBuffer, targetSize);
+
+			QObject::connect(
+			    this->scaler,
+			    &buffer::shm::WlShmBufferScaler::done,
+			    this,
+			    &ScreencopyContext::onFrameScaled
+			);
+
+			return;
+		}
+	}
+
+	emit this->frameCaptured();
+}
+
+void ScreencopyContext::onFrameScaled() {
+	this->scaler = nullptr;
+	emit this->frameCaptured();
+
+	// Frames requested while scaling were held back by the scheduler.
+	ScreencopyScheduler::instance()->pump();
+}
+
 ScreencopyContext* ScreencopyManager::createContext(QObject* object, bool paintCursors) {
 	if (auto* screen = qobject_cast<QuickshellScreenInfo*>(object)) {
 #if SCREENCOPY_ICC
@@ -1,28 +1,84 @@
 #pragma once
 
+#include <qelapsedtimer.h>
 #include <qobject.h>
+#include <qrect.h>
+#include <qregion.h>
+#include <qsize.h>
 #include <qtclasshelpermacros.h>
 #include <qtmetamacros.h>
+#include <qtypes.h>
 
 #include "../buffer/manager.hpp"
 
+namespace qs::wayland::buffer::shm {
+class WlShmBufferScaler;
+}
+
 namespace qs::wayland::screencopy {
 
 class ScreencopyContext: public QObject {
 	Q_OBJECT;
 
 public:
+	~ScreencopyContext() override;
+	Q_DISABLE_COPY_MOVE(ScreencopyContext);
+
 	[[nodiscard]] buffer::WlBufferSwapchain& swapchain() { return this->mSwapchain; }
+	// Starts capturing a frame immediately, bypassing the scheduler.
 	virtual void captureFrame() = 0;
 
+	// Queues a frame capture, which starts once allowed by maxFramerate and the capture
+	// budget shared by all contexts.
+	void requestFrame();
+
+	[[nodiscard]] QSize targetSize() const { return this->mTargetSize; }
+	// If not empty, shm frames are scaled down to fit within the given size before being uploaded.
+	void setTargetSize(QSize targetSize);
+
+	[[nodiscard]] qreal maxFramerate() const { return this->mMaxFramerate; }
+	// Limits how often requested frames are captured. Unlimited if 0.
+	void setMaxFramerate(qreal maxFramerate);
+
+	// Region of the front buffer that changed in the last captured frame.
+	[[nodiscard]] QRegion damage() const { return this->mDamage; }
+
 signals:
 	void frameCaptured();
+	// A frame was captured but was identical to the previous one, which stays presented.
+	void frameUnchanged();
 	void stopped();
 
 protected:
 	ScreencopyContext() = default;
 
+	// Must be called by implementations once a frame is copied and the swapchain is swapped.
+	void frameReady();
+	// Records damage reported by the compositor for the frame being captured. Frames with no
+	// damage recorded are treated as fully damaged.
+	void addDamage(const QRect& rect);
+
 	buffer::WlBufferSwapchain mSwapchain;
+
+private slots:
+	void onFrameScaled();
+
+private:
+	// Milliseconds until maxFramerate allows another capture.
+	[[nodiscard]] qint64 captureDelay() const;
+	// Approximate number of pixels copied by the next capture.
+	[[nodiscard]] qint64 captureCost() const;
+
+	QRegion mDamage;
+	QRegion pendingDamage;
+	bool damageReported = false;
+	bool hasFrame = false;
+	QSize mTargetSize;
+	qreal mMaxFramerate = 0;
+	QElapsedTimer lastCapture;
+	buffer::shm::WlShmBufferScaler* scaler = nullptr;
+
+	friend class ScreencopyScheduler;
 };
 
 class ScreencopyManager {
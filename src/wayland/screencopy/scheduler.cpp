@@ -0,0 +1,153 @@
+#include "scheduler.hpp"
+#include <algorithm>
+#include <cmath>
+
+#include <qguiapplication.h>
+#include <qlogging.h>
+#include <qloggingcategory.h>
+#include <qnamespace.h>
+#include <qobject.h>
+#include <qscreen.h>
+#include <qstring.h>
+#include <qtimer.h>
+#include <qtypes.h>
+
+#include "../../core/qmlglobal.hpp"
+#include "manager.hpp"
+
+namespace qs::wayland::screencopy {
+
+namespace {
+Q_LOGGING_CATEGORY(logScheduler, "quickshell.wayland.screencopy.scheduler", QtWarningMsg);
+
+// Captures that can be started in a burst, in milliseconds of budget.
+constexpr qreal BURST_MS = 100;
+} // namespace
+
+ScreencopyScheduler::ScreencopyScheduler() {
+	this->refillTimer.start();
+
+	this->timer.setSingleShot(true);
+	QObject::connect(&this->timer, &QTimer::timeout, this, &ScreencopyScheduler::pump);
+
+	// clang-format off
+	QObject::connect(QuickshellSettings::instance(), &QuickshellSettings::screencopyBandwidthChanged, this, &ScreencopyScheduler::updateBudget);
+	QObject::connect(qGuiApp, &QGuiApplication::screenAdded, this, &ScreencopyScheduler::updateBudget);
+	QObject::connect(qGuiApp, &QGuiApplication::screenRemoved, this, &ScreencopyScheduler::updateBudget);
+	// clang-format on
+
+	this->updateBudget();
+}
+
+void ScreencopyScheduler::updateBudget() {
+	auto bandwidth = QuickshellSettings::instance()->screencopyBandwidth();
+
+	if (bandwidth < 0) {
+		// enough to copy every output once per refresh at full resolution
+		auto pixelsPerSecond = 0.0;
+
+		for (auto* screen: QGuiApplication::screens()) {
+			// clang-format off
+			QObject::connect(screen, &QScreen::geometryChanged, this, &ScreencopyScheduler::updateBudget, Qt::UniqueConnection);
+			QObject::connect(screen, &QScreen::refreshRateChanged, this, &ScreencopyScheduler::updateBudget, Qt::UniqueConnection);
+			// clang-format on
+
+			auto size = screen->size() * screen->devicePixelRatio();
+			auto refreshRate = screen->refreshRate() > 0 ? screen->refreshRate() : 60;
+			pixelsPerSecond += static_cast<qreal>(size.width()) * size.height() * refreshRate;
+		}
+
+		// unlimited if no outputs are known yet
+		bandwidth = pixelsPerSecond / 1'000'000;
+	}
+
+	// pixels per millisecond
+	auto rate = bandwidth * 1000;
+	if (rate == this->rate) return;
+
+	qCDebug(logScheduler) << "Screencopy bandwidth set to"
+	                      << (bandwidth == 0 ? QString("unlimited") : QString::number(bandwidth))
+	                      << "MP/s";
+
+	// a newly limited budget starts full
+	this->refill();
+	auto wasLimited = this->rate != 0;
+
+	this->rate = rate;
+	this->capacity = rate * BURST_MS;
+	this->available = wasLimited ? std::min(this->available, this->capacity) : this->capacity;
+
+	this->pump();
+}
+
+ScreencopyScheduler* ScreencopyScheduler::instance() {
+	static auto* instance = new ScreencopyScheduler();
+	return instance;
+}
+
+void ScreencopyScheduler::schedule(ScreencopyContext* context) {
+	if (!this->queue.contains(context)) this->queue.push_back(context);
+	this->pump();
+}
+
+void ScreencopyScheduler::remove(ScreencopyContext* context) { this->queue.removeOne(context); }
+
+void ScreencopyScheduler::refill() {
+	if (this->rate == 0) return;
+	auto elapsed = static_cast<qreal>(this->refillTimer.restart());
+	this->available = std::min(this->capacity, this->available + elapsed * this->rate);
+}
+
+void ScreencopyScheduler::pump() {
+	this->refill();
+
+	auto starting = QList<ScreencopyContext*>();
+	qint64 wait = -1;
+
+	auto delayPump = [&](qint64 delay) { wait = wait == -1 ? delay : std::min(wait, delay); };
+
+	for (auto iter = this->queue.begin(); iter != this->queue.end();) {
+		auto* context = *iter;
+
+		// The previous frame is still being scaled. Pumped again once it finishes.
+		if (context->scaler) {
+			++iter;
+			continue;
+		}
+
+		if (auto delay = context->captureDelay(); delay > 0) {
+			delayPump(delay);
+			++iter;
+			continue;
+		}
+
+		if (this->rate != 0) {
+			// Frames larger than the burst capacity are started whenever the budget is full,
+			// and borrow from future budget.
+			auto cost = static_cast<qreal>(context->captureCost());
+			auto required = std::min(cost, this->capacity);
+
+			if (this->available < required) {
+				delayPump(static_cast<qint64>(std::ceil((required - this->available) / this->rate)));
+				break;
+			}
+
+			this->available -= cost;
+		}
+
+		context->lastCapture.start();
+		starting.push_back(context);
+		iter = this->queue.erase(iter);
+	}
+
+	if (wait != -1 && (!this->timer.isActive() || this->timer.remainingTime() > wait)) {
+		this->timer.start(static_cast<int>(wait));
+	}
+
+	// Started after iterating as a capture may synchronously change the queue.
+	for (auto* context: starting) {
+		context->captureFrame();
+	}
+}
+
+} // namespace qs::wayland::screencopy
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <qelapsedtimer.h>
+#include <qlist.h>
+#include <qobject.h>
+#include <qtimer.h>
+#include <qtmetamacros.h>
+#include <qtypes.h>
+
+namespace qs::wayland::screencopy {
+
+class ScreencopyContext;
+
+// Starts requested captures round-robin across contexts, keeping the total number of
+// pixels copied per second within a budget so many live captures cannot saturate
+// memory bandwidth. Contexts that cannot afford their next frame wait their turn
+// instead of being overtaken by contexts with smaller frames.
+//
+// The budget is set in megapixels per second by Quickshell.screencopyBandwidth. By default
+// it allows copying every output once per refresh, and follows output changes.
+class ScreencopyScheduler: public QObject {
+	Q_OBJECT;
+
+public:
+	static ScreencopyScheduler* instance();
+
+	void schedule(ScreencopyContext* context);
+	void remove(ScreencopyContext* context);
+
+public slots:
+	// Starts any captures that have become possible.
+	void pump();
+
+private slots:
+	void updateBudget();
+
+private:
+	explicit ScreencopyScheduler();
+
+	void refill();
+
+	QList<ScreencopyContext*> queue;
+	QTimer timer;
+	QElapsedTimer refillTimer;
+	// pixels per millisecond, 0 if unlimited
+	qreal rate = 0;
+	qreal capacity = 0;
+	qreal available = 0;
+};
+
+} // namespace qs::wayland::screencopy
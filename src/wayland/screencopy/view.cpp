@@ -1,17 +1,32 @@
 #include "view.hpp"
 
+#include <utility>
+
+#include <qbytearray.h>
 #include <qobject.h>
 #include <qqmlinfo.h>
 #include <qquickitem.h>
+#include <qrect.h>
+#include <qthreadpool.h>
+#include <qnamespace.h>
 #include <qsize.h>
 #include <qtmetamacros.h>
+#include <qtypes.h>
 
 #include "../buffer/manager.hpp"
 #include "../buffer/qsg.hpp"
+#include "frameexport.hpp"
 #include "manager.hpp"
 
 namespace qs::wayland::screencopy {
 
+ScreencopyView::~ScreencopyView() {
+	// operations delete themselves once their workers finish
+	for (auto* operation: this->exports) {
+		operation->tryCancel();
+	}
+}
+
 void ScreencopyView::setCaptureSource(QObject* captureSource) {
 	if (captureSource == this->mCaptureSource) return;
 	auto hadContext = this->context != nullptr;
@@ -50,13 +65,32 @@ void ScreencopyView::setLive(bool live) {
 	if (live == this->mLive) return;
 
 	if (live && !this->mLive && this->context) {
-		this->context->captureFrame();
+		this->context->requestFrame();
 	}
 
 	this->mLive = live;
 	emit this->liveChanged();
 }
 
+void ScreencopyView::setTargetSize(QSize targetSize) {
+	if (targetSize == this->mTargetSize) return;
+	this->mTargetSize = targetSize;
+	if (this->context) this->context->setTargetSize(targetSize);
+	emit this->targetSizeChanged();
+}
+
+void ScreencopyView::setMaxFramerate(qreal maxFramerate) {
+	if (maxFramerate < 0) {
+		qmlWarning(this) << "maxFramerate cannot be negative.";
+		return;
+	}
+
+	if (maxFramerate == this->mMaxFramerate) return;
+	this->mMaxFramerate = maxFramerate;
+	if (this->context) this->context->setMaxFramerate(maxFramerate);
+	emit this->maxFramerateChanged();
+}
+
 void ScreencopyView::createContext() {
 	this->destroyContext(false);
 	this->context = ScreencopyManager::createContext(this->mCaptureSource, this->mPaintCursors);
@@ -67,6 +101,8 @@ void ScreencopyView::createContext() {
 	}
 
 	this->context->setParent(this);
+	this->context->setTargetSize(this->mTargetSize);
+	this->context->setMaxFramerate(this->mMaxFramerate);
 
 	QObject::connect(
 	    this->context,
@@ -82,7 +118,14 @@ void ScreencopyView::createContext() {
 	    &ScreencopyView::onFrameCaptured
 	);
 
-	this->context->captureFrame();
+	QObject::connect(
+	    this->context,
+	    &ScreencopyContext::frameUnchanged,
+	    this,
+	    &ScreencopyView::onFrameUnchanged
+	);
+
+	this->context->requestFrame();
 }
 
 void ScreencopyView::destroyContext(bool update) {
@@ -95,10 +138,54 @@ void ScreencopyView::destroyContext(bool update) {
 }
 
 void ScreencopyView::captureFrame() {
-	if (this->context) this->context->captureFrame();
+	if (this->context) this->context->requestFrame();
 	else qmlWarning(this) << "Cannot capture frame, as no recording context is ready.";
 }
 
+qint32 ScreencopyView::exportFrame(const QString& path, const QString& format, QRect region) {
+	if (!this->context || !this->bHasContent) {
+		qmlWarning(this) << "Cannot export frame, as no frame has been captured.";
+		return -1;
+	}
+
+	auto exportFormat = FrameExportOperation::Format::Png;
+	if (!FrameExportOperation::parseFormat(format, path, &exportFormat)) {
+		qmlWarning(this) << "Cannot export frame to unknown format "
+		                 << (format.isEmpty() ? path : format);
+		return -1;
+	}
+
+	// The buffer is kept out of the swapchain until the export is done with it,
+	// so later captures cannot overwrite it.
+	auto frontbuffer = this->context->swapchain().lockFrontbuffer();
+	auto transform = frontbuffer->transform;
+	auto id = this->nextExportId++;
+
+	auto* operation = new FrameExportOperation(
+	    std::move(frontbuffer),
+	    transform,
+	    region,
+	    exportFormat,
+	    path
+	);
+
+	QObject::connect(
+	    operation,
+	    &FrameExportOperation::done,
+	    this,
+	    [this, operation, id, path](const QByteArray& data, const QString& error) {
+		    this->exports.removeOne(operation);
+
+		    if (error.isEmpty()) emit this->frameExported(id, path, data);
+		    else emit this->frameExportFailed(id, error);
+	    }
+	);
+
+	this->exports.push_back(operation);
+	QThreadPool::globalInstance()->start(operation);
+	return id;
+}
+
 void ScreencopyView::onFrameCaptured() {
 	this->setFlag(QQuickItem::ItemHasContents);
 	this->update();
@@ -106,6 +193,11 @@ void ScreencopyView::onFrameCaptured() {
 	this->bSourceSize = this->context->swapchain().frontbuffer()->size();
 }
 
+void ScreencopyView::onFrameUnchanged() {
+	// Nothing new to render, so the next frame would not be requested by updatePaintNode.
+	if (this->mLive) this->context->requestFrame();
+}
+
 void ScreencopyView::componentComplete() {
 	this->QQuickItem::componentComplete();
 
@@ -144,7 +236,15 @@ QSGNode* ScreencopyView::updatePaintNode(QSGNode* oldNode, UpdatePaintNodeData*
 	node->syncSwapchain(swapchain);
 	node->setRect(this->boundingRect());
 
-	if (this->mLive) this->context->captureFrame();
+	// The scheduler may only be used from the gui thread.
+	if (this->mLive) {
+		QMetaObject::invokeMethod(
+		    this->context,
+		    &ScreencopyContext::requestFrame,
+		    Qt::QueuedConnection
+		);
+	}
+
 	return node;
 }
 
@@ -1,12 +1,19 @@
 #pragma once
 
+#include <qbytearray.h>
+#include <qlist.h>
 #include <qobject.h>
 #include <qproperty.h>
 #include <qqmlintegration.h>
 #include <qquickitem.h>
+#include <qrect.h>
 #include <qsgnode.h>
+#include <qsize.h>
+#include <qtclasshelpermacros.h>
 #include <qtmetamacros.h>
+#include <qtypes.h>
 
+#include "frameexport.hpp"
 #include "manager.hpp"
 
 namespace qs::wayland::screencopy {
@@ -31,6 +38,21 @@ class ScreencopyView: public QQuickItem {
 	/// If true, a live video feed from the capture source will be displayed instead of a still image.
 	/// Defaults to false.
 	Q_PROPERTY(bool live READ live WRITE setLive NOTIFY liveChanged);
+	/// The largest size frames need to be displayed at, such as the size of a thumbnail.
+	/// Frames larger than this are scaled down before being uploaded to the GPU when the
+	/// compositor cannot share GPU buffers. Defaults to an empty size, which keeps frames
+	/// at their full size.
+	///
+	/// > [!NOTE] Frames are always copied from the compositor at full size, as none of the
+	/// > supported capture protocols allow requesting smaller frames.
+	Q_PROPERTY(QSize targetSize READ targetSize WRITE setTargetSize NOTIFY targetSizeChanged);
+	/// The maximum rate at which @@live frames are captured. Defaults to 0, which captures
+	/// a frame whenever the previous one has been displayed.
+	///
+	/// Captures from all views are also limited by a shared bandwidth budget, set by
+	/// @@Quickshell.screencopyBandwidth. By default it allows copying every output
+	/// once per refresh. When it is exceeded, views take turns capturing frames.
+	Q_PROPERTY(qreal maxFramerate READ maxFramerate WRITE setMaxFramerate NOTIFY maxFramerateChanged);
 	/// If true, the view has content ready to display. Content is not always immediately available,
 	/// and this property can be used to avoid displaying it until ready.
 	Q_PROPERTY(bool hasContent READ default NOTIFY hasContentChanged BINDABLE bindableHasContent);
@@ -40,12 +62,30 @@ class ScreencopyView: public QQuickItem {
 
 public:
 	explicit ScreencopyView(QQuickItem* parent = nullptr): QQuickItem(parent) {}
+	~ScreencopyView() override;
+	Q_DISABLE_COPY_MOVE(ScreencopyView);
 
 	void componentComplete() override;
 
 	/// Capture a single frame. Has no effect if @@live is true.
 	Q_INVOKABLE void captureFrame();
 
+	/// Encode the current frame as an image without capturing it again. Encoding happens on
+	/// a background thread, and @@frameExported(s) or @@frameExportFailed(s) is emitted
+	/// once finished.
+	///
+	/// - `path` - The file to write the image to. If empty, the encoded image is passed
+	///   to @@frameExported(s) instead, for example to place it on the clipboard.
+	/// - `format` - One of `png`, `qoi` or `webp`. If empty, the format is picked from the
+	///   extension of `path`, defaulting to `png`. QOI encodes much faster than PNG
+	///   at the cost of larger files. WebP requires the Qt image formats plugin.
+	/// - `region` - The region of the frame to export, in @@sourceSize coordinates.
+	///   Defaults to the whole frame.
+	///
+	/// Returns an id passed to the result signals, or -1 if no frame is available.
+	Q_INVOKABLE qint32
+	exportFrame(const QString& path, const QString& format = QString(), QRect region = QRect());
+
 	[[nodiscard]] QObject* captureSource() const { return this->mCaptureSource; }
 	void setCaptureSource(QObject* captureSource);
 
@@ -55,16 +95,29 @@ public:
 	[[nodiscard]] bool live() const { return this->mLive; }
 	void setLive(bool live);
 
+	[[nodiscard]] QSize targetSize() const { return this->mTargetSize; }
+	void setTargetSize(QSize targetSize);
+
+	[[nodiscard]] qreal maxFramerate() const { return this->mMaxFramerate; }
+	void setMaxFramerate(qreal maxFramerate);
+
 	[[nodiscard]] QBindable<bool> bindableHasContent() { return &this->bHasContent; }
 	[[nodiscard]] QBindable<QSize> bindableSourceSize() { return &this->bSourceSize; }
 
 signals:
 	/// The compositor has ended the video stream. Attempting to restart it may or may not work.
 	void stopped();
+	/// An export started by @@exportFrame() has finished. `data` contains the encoded
+	/// image if no path was given, and is empty otherwise.
+	void frameExported(qint32 id, const QString& path, const QByteArray& data);
+	/// An export started by @@exportFrame() has failed.
+	void frameExportFailed(qint32 id, const QString& error);
 
 	void captureSourceChanged();
 	void paintCursorsChanged();
 	void liveChanged();
+	void targetSizeChanged();
+	void maxFramerateChanged();
 	void hasContentChanged();
 	void sourceSizeChanged();
 
@@ -74,6 +127,7 @@ protected:
 private slots:
 	void onCaptureSourceDestroyed();
 	void onFrameCaptured();
+	void onFrameUnchanged();
 	void destroyContextWithUpdate() { this->destroyContext(); }
 	void onBuffersReady();
 
@@ -89,8 +143,12 @@ private:
 	QObject* mCaptureSource = nullptr;
 	bool mPaintCursors = false;
 	bool mLive = false;
+	QSize mTargetSize;
+	qreal mMaxFramerate = 0;
 	ScreencopyContext* context = nullptr;
 	bool completed = false;
+	QList<FrameExportOperation*> exports;
+	qint32 nextExportId = 0;
 };
 
 } // namespace qs::wayland::screencopy
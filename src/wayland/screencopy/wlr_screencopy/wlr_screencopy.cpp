@@ -5,6 +5,7 @@
 #include <qlogging.h>
 #include <qloggingcategory.h>
 #include <qobject.h>
+#include <qrect.h>
 #include <qscreen.h>
 #include <qtmetamacros.h>
 #include <qwaylandclientextension.h>
@@ -104,6 +105,20 @@ void WlrScreencopyContext::zwlr_screencopy_frame_v1_flags(uint32_t flags) {
 	}
 }
 
+void WlrScreencopyContext::zwlr_screencopy_frame_v1_damage(
+    uint32_t x,
+    uint32_t y,
+    uint32_t width,
+    uint32_t height
+) {
+	this->addDamage(QRect(
+	    static_cast<int>(x),
+	    static_cast<int>(y),
+	    static_cast<int>(width),
+	    static_cast<int>(height)
+	));
+}
+
 void WlrScreencopyContext::zwlr_screencopy_frame_v1_buffer_done() {
 	auto* backbuffer = this->mSwapchain.createBackbuffer(this->request);
 
@@ -122,7 +137,7 @@ void WlrScreencopyContext::zwlr_screencopy_frame_v1_ready(
 	this->destroy();
 	this->copiedFirstFrame = true;
 	this->mSwapchain.swapBuffers();
-	emit this->frameCaptured();
+	this->frameReady();
 }
 
 void WlrScreencopyContext::zwlr_screencopy_frame_v1_failed() {
@@ -30,6 +30,7 @@ protected:
 	void zwlr_screencopy_frame_v1_buffer(uint32_t format, uint32_t width, uint32_t height, uint32_t stride) override;
 	void zwlr_screencopy_frame_v1_linux_dmabuf(uint32_t format, uint32_t width, uint32_t height) override;
 	void zwlr_screencopy_frame_v1_flags(uint32_t flags) override;
+	void zwlr_screencopy_frame_v1_damage(uint32_t x, uint32_t y, uint32_t width, uint32_t height) override;
 	void zwlr_screencopy_frame_v1_buffer_done() override;
 	void zwlr_screencopy_frame_v1_ready(uint32_t tvSecHi, uint32_t tvSecLo, uint32_t tvNsec) override;
 	void zwlr_screencopy_frame_v1_failed() override;
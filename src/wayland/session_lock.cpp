@@ -4,9 +4,11 @@
 #include <qcoreapplication.h>
 #include <qguiapplication.h>
 #include <qlogging.h>
+#include <qloggingcategory.h>
 #include <qobject.h>
 #include <qqmlcomponent.h>
 #include <qqmlengine.h>
+#include <qqmlincubator.h>
 #include <qqmllist.h>
 #include <qquickitem.h>
 #include <qquickwindow.h>
@@ -14,11 +16,16 @@
 #include <qtmetamacros.h>
 #include <qtypes.h>
 
+#include "../core/incubator.hpp"
 #include "../core/qmlglobal.hpp"
 #include "../core/qmlscreen.hpp"
 #include "../core/reload.hpp"
 #include "session_lock/session_lock.hpp"
 
+namespace {
+Q_LOGGING_CATEGORY(logSessionLock, "quickshell.wayland.sessionlock", QtWarningMsg);
+}
+
 void WlSessionLock::onReload(QObject* oldInstance) {
 	auto* old = qobject_cast<WlSessionLock*>(oldInstance);
 
@@ -35,6 +42,7 @@ void WlSessionLock::onReload(QObject* oldInstance) {
 	QObject::connect(this->manager, &SessionLockManager::unlocked, this, &WlSessionLock::secureStateChanged);
 
 	QObject::connect(this->manager, &SessionLockManager::unlocked, this, &WlSessionLock::unlock);
+	QObject::connect(this->manager, &SessionLockManager::locked, this, &WlSessionLock::onSecure);
 
 	auto* app = QCoreApplication::instance();
 	auto* guiApp = qobject_cast<QGuiApplication*>(app);
@@ -47,6 +55,7 @@ void WlSessionLock::onReload(QObject* oldInstance) {
 	// clang-format on
 
 	this->realizeLockTarget(old);
+	this->preloadSurfaces();
 }
 
 void WlSessionLock::updateSurfaces(bool show, WlSessionLock* old) {
@@ -103,10 +112,19 @@ void WlSessionLock::realizeLockTarget(WlSessionLock* old) {
 			return;
 		}
 
+		this->lockTimer.start();
+
+		// Surfaces still being preloaded are finished synchronously.
+		for (auto* incubator: this->incubators.values()) {
+			incubator->forceCompletion();
+		}
+
 		// preload initial surfaces to make the chance of the compositor displaying a blank
 		// frame before the lock surfaces are shown as low as possible.
 		this->updateSurfaces(false);
 
+		qCDebug(logSessionLock) << "Lock surfaces ready after" << this->lockTimer.elapsed() << "ms";
+
 		if (!this->manager->lock()) this->lockTarget = false;
 
 		this->updateSurfaces(true, old);
@@ -127,15 +145,139 @@ void WlSessionLock::unlock() {
 		this->surfaces.clear();
 
 		emit this->lockStateChanged();
+
+		// surfaces cannot be reused for another lock
+		this->preloadSurfaces();
 	}
 }
 
 void WlSessionLock::onScreensChanged() {
 	if (this->manager != nullptr && this->manager->isLocked()) {
 		this->updateSurfaces(true);
+	} else {
+		this->preloadSurfaces();
 	}
 }
 
+void WlSessionLock::onSecure() {
+	if (!this->lockTimer.isValid()) return;
+
+	this->mTimeToSecure = this->lockTimer.elapsed();
+	this->lockTimer.invalidate();
+
+	qCInfo(logSessionLock) << "Session secured" << this->mTimeToSecure << "ms after locking"
+	                       << (this->mPreload ? "with" : "without") << "preloaded surfaces";
+
+	emit this->timeToSecureChanged();
+}
+
+void WlSessionLock::preloadSurfaces() {
+	if (!this->mPreload || this->manager == nullptr || this->mSurfaceComponent == nullptr
+	    || this->isLocked())
+	{
+		return;
+	}
+
+	auto screens = QGuiApplication::screens();
+
+	for (auto iter = this->surfaces.begin(); iter != this->surfaces.end();) {
+		if (screens.contains(iter.key())) {
+			iter++;
+		} else {
+			iter.value()->deleteLater();
+			iter = this->surfaces.erase(iter);
+		}
+	}
+
+	for (auto iter = this->incubators.begin(); iter != this->incubators.end();) {
+		if (screens.contains(iter.key())) {
+			iter++;
+		} else {
+			delete iter.value();
+			iter = this->incubators.erase(iter);
+		}
+	}
+
+	for (auto* screen: screens) {
+		if (this->surfaces.contains(screen) || this->incubators.contains(screen)) continue;
+
+		auto* incubator = new QsQmlIncubator(QQmlIncubator::Asynchronous, this);
+		this->incubators.insert(screen, incubator);
+
+		QObject::connect(incubator, &QsQmlIncubator::completed, this, [=, this]() {
+			this->onPreloadCompleted(screen, incubator);
+		});
+
+		QObject::connect(incubator, &QsQmlIncubator::failed, this, [=, this]() {
+			this->onPreloadFailed(screen, incubator);
+		});
+
+		qCDebug(logSessionLock) << "Preloading lock surface for" << screen;
+		this->mSurfaceComponent->create(
+		    *incubator,
+		    QQmlEngine::contextForObject(this->mSurfaceComponent)
+		);
+	}
+}
+
+void WlSessionLock::clearPreloadedSurfaces() {
+	for (auto* incubator: this->incubators) {
+		delete incubator;
+	}
+
+	this->incubators.clear();
+
+	for (auto* surface: this->surfaces) {
+		surface->deleteLater();
+	}
+
+	this->surfaces.clear();
+}
+
+void WlSessionLock::onPreloadCompleted(QScreen* screen, QsQmlIncubator* incubator) {
+	this->incubators.remove(screen);
+	// The incubator is not necessarily inert at the time of this callback,
+	// so deleteLater is required.
+	incubator->deleteLater();
+
+	auto* instanceObj = incubator->object();
+	auto* instance = qobject_cast<WlSessionLockSurface*>(instanceObj);
+
+	if (instance == nullptr) {
+		qWarning() << "WlSessionLock.surface does not create a WlSessionLockSurface.";
+		if (instanceObj != nullptr) instanceObj->deleteLater();
+		return;
+	}
+
+	instance->setParent(this);
+	instance->setScreen(screen);
+	instance->reload(nullptr);
+
+	this->surfaces[screen] = instance;
+	qCDebug(logSessionLock) << "Preloaded lock surface for" << screen;
+}
+
+void WlSessionLock::onPreloadFailed(QScreen* screen, QsQmlIncubator* incubator) {
+	qWarning() << "Failed to preload WlSessionLock.surface:";
+
+	for (auto& error: incubator->errors()) {
+		qWarning() << error;
+	}
+
+	this->incubators.remove(screen);
+	incubator->deleteLater();
+}
+
+void WlSessionLock::setPreload(bool preload) {
+	if (preload == this->mPreload) return;
+	this->mPreload = preload;
+
+	if (preload) this->preloadSurfaces();
+	else if (!this->isLocked()) this->clearPreloadedSurfaces();
+
+	emit this->preloadChanged();
+}
+
 bool WlSessionLock::isLocked() const {
 	return this->manager == nullptr ? this->lockTarget : this->manager->isLocked();
 }
@@ -167,8 +309,11 @@ void WlSessionLock::setSurfaceComponent(QQmlComponent* surfaceComponent) {
 	if (this->mSurfaceComponent != nullptr) this->mSurfaceComponent->deleteLater();
 	if (surfaceComponent != nullptr) surfaceComponent->setParent(this);
 
+	this->clearPreloadedSurfaces();
 	this->mSurfaceComponent = surfaceComponent;
 	emit this->surfaceComponentChanged();
+
+	this->preloadSurfaces();
 }
 
 WlSessionLockSurface::WlSessionLockSurface(QObject* parent)
@@ -2,6 +2,7 @@
 
 #include <qcolor.h>
 #include <qcontainerfwd.h>
+#include <qelapsedtimer.h>
 #include <qguiapplication.h>
 #include <qmap.h>
 #include <qnamespace.h>
@@ -15,6 +16,7 @@
 #include <qtmetamacros.h>
 #include <qtypes.h>
 
+#include "../core/incubator.hpp"
 #include "../core/qmlscreen.hpp"
 #include "../core/reload.hpp"
 #include "session_lock/session_lock.hpp"
@@ -26,7 +28,7 @@ class WlSessionLockSurface;
 ///
 /// WlSessionLock will create an instance of its `surface` component for every screen when
 /// `locked` is set to true. The `surface` component must create a @@WlSessionLockSurface
-/// which will be displayed on each screen.
+/// which will be displayed on each screen. Set @@preload to create them ahead of time instead.
 ///
 /// The below example will create a session lock that disappears when the button is clicked.
 /// ```qml
@@ -67,6 +69,19 @@ class WlSessionLock: public Reloadable {
 	Q_PROPERTY(bool secure READ isSecure NOTIFY secureStateChanged);
 	/// The surface that will be created for each screen. Must create a @@WlSessionLockSurface$.
 	Q_PROPERTY(QQmlComponent* surface READ surfaceComponent WRITE setSurfaceComponent NOTIFY surfaceComponentChanged);
+	/// If true, surfaces are created for every screen in the background while the session is
+	/// unlocked, and kept hidden until it is locked. Defaults to false.
+	///
+	/// Locking then only has to show the existing surfaces, which lets the compositor
+	/// confirm the lock sooner. This matters when locking right before suspend, where a slow
+	/// lock can briefly expose the session on resume.
+	///
+	/// Preloaded surfaces are not visible, but their contents are live, and they are destroyed
+	/// and recreated after each unlock. Surfaces are recreated when screens are added or removed.
+	Q_PROPERTY(bool preload READ preload WRITE setPreload NOTIFY preloadChanged);
+	/// The time in milliseconds between the last lock request and the compositor confirming
+	/// the session is @@secure, or -1 if the session has not been locked yet.
+	Q_PROPERTY(qint64 timeToSecure READ timeToSecure NOTIFY timeToSecureChanged);
 	// clang-format on
 	QML_ELEMENT;
 	Q_CLASSINFO("DefaultProperty", "surface");
@@ -84,23 +99,39 @@ public:
 	[[nodiscard]] QQmlComponent* surfaceComponent() const;
 	void setSurfaceComponent(QQmlComponent* surfaceComponent);
 
+	[[nodiscard]] bool preload() const { return this->mPreload; }
+	void setPreload(bool preload);
+
+	[[nodiscard]] qint64 timeToSecure() const { return this->mTimeToSecure; }
+
 signals:
 	void lockStateChanged();
 	void secureStateChanged();
 	void surfaceComponentChanged();
+	void preloadChanged();
+	void timeToSecureChanged();
 
 private slots:
 	void unlock();
 	void onScreensChanged();
+	void onSecure();
 
 private:
 	void updateSurfaces(bool show, WlSessionLock* old = nullptr);
 	void realizeLockTarget(WlSessionLock* old = nullptr);
+	void preloadSurfaces();
+	void clearPreloadedSurfaces();
+	void onPreloadCompleted(QScreen* screen, QsQmlIncubator* incubator);
+	void onPreloadFailed(QScreen* screen, QsQmlIncubator* incubator);
 
 	SessionLockManager* manager = nullptr;
 	QQmlComponent* mSurfaceComponent = nullptr;
 	QMap<QScreen*, WlSessionLockSurface*> surfaces;
+	QMap<QScreen*, QsQmlIncubator*> incubators;
 	bool lockTarget = false;
+	bool mPreload = false;
+	QElapsedTimer lockTimer;
+	qint64 mTimeToSecure = -1;
 
 	friend class WlSessionLockSurface;
 };
@@ -7,6 +7,10 @@ import QtQuick
 /// inside of its border, including rounded rectangles. It costs more than
 /// @@QtQuick.Rectangle, so it should not be used unless you need to clip
 /// items inside of it to the border.
+///
+/// If no corner is rounded, content is clipped with @@QtQuick.Item.clip, which
+/// is nearly free but does not antialias the edges of rotated content.
+/// Otherwise content is rendered into an offscreen layer and clipped by a shader.
 Item {
 	id: root
 
@@ -27,6 +31,12 @@ Item {
 	property /*color*/alias color: shader.backgroundColor
 	/// See @@QtQuick.Rectangle.border.
 	property clippingRectangleBorder border
+	/// If the rounded shape should be rendered by a hidden @@QtQuick.Rectangle and
+	/// sampled as a texture, instead of being computed in the shader.
+	///
+	/// This matches @@QtQuick.Rectangle's rendering exactly, but needs a second
+	/// offscreen layer. Defaults to false.
+	property bool rasterizedMask: false
 	/// Radius of all corners. Defaults to 0.
 	property /*real*/alias radius: rectangle.radius
 	/// Radius of the top left corner. Defaults to @@radius.
@@ -53,32 +63,74 @@ Item {
 		border.color: "#ff00ff00"
 		border.pixelAligned: root.border.pixelAligned
 		border.width: root.border.width
-		layer.enabled: true
+		layer.enabled: root.rasterizedMask && !rectangle.square
 		visible: false
+
+		readonly property bool square: rectangle.topLeftRadius == 0 && rectangle.topRightRadius == 0
+			&& rectangle.bottomLeftRadius == 0 && rectangle.bottomRightRadius == 0
+	}
+
+	// Square corners can be clipped with a scissor, or a stencil if rotated,
+	// avoiding offscreen layers entirely.
+	Rectangle {
+		anchors.fill: root
+		anchors.margins: root.contentUnderBorder ? 0 : root.border.width
+		color: shader.backgroundColor
+		visible: rectangle.square
 	}
 
 	Item {
-		id: contentItemContainer
+		id: contentClip
 		anchors.fill: root
+		anchors.margins: rectangle.square && !root.contentUnderBorder ? root.border.width : 0
+		clip: rectangle.square
 
 		Item {
-			id: contentItem
-			anchors.fill: parent
-			anchors.margins: root.contentInsideBorder ? root.border.width : 0
+			id: contentItemContainer
+			x: -contentClip.x
+			y: -contentClip.y
+			width: root.width
+			height: root.height
+
+			Item {
+				id: contentItem
+				anchors.fill: parent
+				anchors.margins: root.contentInsideBorder ? root.border.width : 0
+			}
 		}
 	}
 
+	Rectangle {
+		anchors.fill: root
+		color: "transparent"
+		border.color: root.border.color
+		border.pixelAligned: root.border.pixelAligned
+		border.width: root.border.width
+		visible: rectangle.square && root.border.width > 0
+	}
+
 	ShaderEffect {
 		id: shader
 		anchors.fill: root
-		fragmentShader: `qrc:/Quickshell/Widgets/shaders/cliprect${root.contentUnderBorder ? "-ub" : ""}.frag.qsb`
+		visible: !rectangle.square
+		fragmentShader: `qrc:/Quickshell/Widgets/shaders/cliprect${root.rasterizedMask ? "" : "-analytic"}${root.contentUnderBorder ? "-ub" : ""}.frag.qsb`
 		property Rectangle rect: rectangle
 		property color backgroundColor
 		property color borderColor: root.border.color
 
+		property vector2d rectSize: Qt.vector2d(shader.width, shader.height)
+		property vector4d radii: Qt.vector4d(
+			rectangle.topLeftRadius,
+			rectangle.topRightRadius,
+			rectangle.bottomRightRadius,
+			rectangle.bottomLeftRadius
+		)
+		property real borderWidth: root.border.width
+		property real antialiased: rectangle.antialiasing ? 1 : 0
+
 		property ShaderEffectSource content: ShaderEffectSource {
 			hideSource: true
-			sourceItem: contentItemContainer
+			sourceItem: rectangle.square ? null : contentItemContainer
 		}
 	}
 }
@@ -7,10 +7,21 @@ layout(std140, binding = 0) uniform buf {
 	float qt_Opacity;
 	vec4 backgroundColor;
 	vec4 borderColor;
+#ifdef ANALYTIC_MASK
+	vec2 rectSize;
+	// top left, top right, bottom right, bottom left
+	vec4 radii;
+	float borderWidth;
+	float antialiased;
+#endif
 };
 
+#ifdef ANALYTIC_MASK
+layout(binding = 1) uniform sampler2D content;
+#else
 layout(binding = 1) uniform sampler2D rect;
 layout(binding = 2) uniform sampler2D content;
+#endif
 
 vec4 overlay(vec4 base, vec4 overlay) {
 	if (overlay.a == 0.0) return base;
@@ -21,8 +32,47 @@ vec4 overlay(vec4 base, vec4 overlay) {
 	return vec4(rgb, newAlpha);
 }
 
+#ifdef ANALYTIC_MASK
+// Signed distance from p to the edge of a rounded box centered on the origin.
+float roundedBoxDistance(vec2 p, vec2 halfSize, vec4 radii) {
+	vec2 sideRadii = p.x > 0.0 ? radii.yz : radii.xw;
+	float radius = p.y > 0.0 ? sideRadii.y : sideRadii.x;
+
+	vec2 q = abs(p) - halfSize + radius;
+	return min(max(q.x, q.y), 0.0) + length(max(q, 0.0)) - radius;
+}
+
+float coverage(float dist) {
+	// one pixel wide edge, independent of scale
+	float edgeWidth = max(fwidth(dist), 0.0001);
+	if (antialiased == 0.0) return dist <= 0.0 ? 1.0 : 0.0;
+	return clamp(0.5 - dist / edgeWidth, 0.0, 1.0);
+}
+#endif
+
 void main() {
 	vec4 contentColor = texture(content, qt_TexCoord0.xy);
+
+#ifdef ANALYTIC_MASK
+	vec2 halfSize = rectSize * 0.5;
+	vec2 p = qt_TexCoord0.xy * rectSize - halfSize;
+
+	// Matches Rectangle, which limits radii to half the shortest side and shrinks
+	// them by the border width inside the border.
+	vec4 outerRadii = min(radii, min(halfSize.x, halfSize.y));
+	vec4 innerRadii = max(outerRadii - borderWidth, 0.0);
+
+	float outerAlpha = coverage(roundedBoxDistance(p, halfSize, outerRadii));
+	float innerAlpha = coverage(roundedBoxDistance(p, halfSize - borderWidth, innerRadii));
+
+#ifdef CONTENT_UNDER_BORDER
+	float contentAlpha = outerAlpha;
+#else
+	float contentAlpha = innerAlpha;
+#endif
+
+	float borderAlpha = max(outerAlpha - innerAlpha, 0.0);
+#else
 	vec4 rectColor = texture(rect, qt_TexCoord0.xy);
 
 #ifdef CONTENT_UNDER_BORDER
@@ -32,6 +82,7 @@ void main() {
 #endif
 
 	float borderAlpha = rectColor.g;
+#endif
 
 	vec4 innerColor = overlay(backgroundColor, contentColor) * contentAlpha;
 	vec4 borderColor = borderColor * borderAlpha;
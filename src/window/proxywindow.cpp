@@ -149,7 +149,7 @@ void ProxyWindowBase::deleteWindow(bool keepItemOwnership) {
 	if (this->window != nullptr) emit this->windowDestroyed();
 	if (auto* window = this->disownWindow(keepItemOwnership)) {
 		if (auto* generation = EngineGeneration::findObjectGeneration(this)) {
-			generation->deregisterIncubationController(window->incubationController());
+			generation->deregisterIncubationWindow(window);
 		}
 
 		window->deleteLater();
@@ -177,9 +177,8 @@ ProxiedWindow* ProxyWindowBase::retrieveWindow(QObject* oldInstance) {
 
 void ProxyWindowBase::connectWindow() {
 	if (auto* generation = EngineGeneration::findObjectGeneration(this)) {
-		// All windows have effectively the same incubation controller so it dosen't matter
-		// which window it belongs to. We do want to replace the delay one though.
-		generation->registerIncubationController(this->window->incubationController());
+		// Incubation is spread across the frames of all windows.
+		generation->registerIncubationWindow(this->window);
 	}
 
 	this->window->setProxy(this);
@@ -479,14 +478,22 @@ void ProxiedWindow::exposeEvent(QExposeEvent* event) {
 void ProxyWindowContentItem::updatePolish() { emit this->polished(); }
 
 void ProxyWindowBase::onPolished() {
+	// Mask changes only mark the mask dirty, so it is built at most once per frame.
+	// The compositor is only sent a new region if it differs from the committed one.
 	if (this->pendingPolish.inputMask) {
 		QRegion mask;
 		if (this->mMask != nullptr) {
 			mask = this->mMask->applyTo(QRect(0, 0, this->width(), this->height()));
 		}
 
-		this->window->setFlag(Qt::WindowTransparentForInput, this->mMask != nullptr && mask.isEmpty());
-		this->window->setMask(mask);
+		auto transparent = this->mMask != nullptr && mask.isEmpty();
+		if (this->window->flags().testFlag(Qt::WindowTransparentForInput) != transparent) {
+			this->window->setFlag(Qt::WindowTransparentForInput, transparent);
+		}
+
+		if (mask != this->window->mask()) {
+			this->window->setMask(mask);
+		}
 
 		this->pendingPolish.inputMask = false;
 	}
@@ -257,6 +257,7 @@ void I3Ipc::handleGetWorkspacesEvent(I3IpcEvent* event) {
 	auto workspaces = data.array();
 
 	const auto& mList = this->mWorkspaces.valueList();
+	auto batch = UntypedObjectModel::UpdateBatch(&this->mWorkspaces);
 	auto names = QVector<QString>();
 
 	qCDebug(logI3Ipc) << "There are" << workspaces.toVariantList().length() << "workspaces";
@@ -312,6 +313,7 @@ void I3Ipc::handleGetOutputsEvent(I3IpcEvent* event) {
 
 	auto monitors = data.array();
 	const auto& mList = this->mMonitors.valueList();
+	auto batch = UntypedObjectModel::UpdateBatch(&this->mMonitors);
 	auto names = QVector<QString>();
 
 	qCDebug(logI3Ipc) << "There are" << monitors.toVariantList().length() << "monitors";